@@ -33,7 +33,9 @@
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/datastructures/representationconversionstatistics.h>
 
+#include <chrono>
 #include <typeindex>
 #include <mutex>
 #include <unordered_map>
@@ -125,6 +127,14 @@ public:
     template <typename T>
     bool hasRepresentation() const;
 
+    /**
+     * Check if a specific representation type exists and is up to date, i.e. it has not been
+     * invalidated by an edit of another representation.
+     * @return true if existing and valid, false otherwise.
+     */
+    template <typename T>
+    bool hasValidRepresentation() const;
+
     /**
      * Check if the Data object has any representation.
      * @return true if any representation exist, false otherwise.
@@ -165,6 +175,20 @@ public:
      */
     void invalidateAllOther(const Repr* repr);
 
+    /**
+     * The number of representation conversions done for this object, and the bytes and time they
+     * took, per conversion step. Summed over all objects in
+     * RepresentationConverterFactory::getConversionStatistics.
+     */
+    ConversionStatisticsMap getConversionStatistics() const;
+
+    /**
+     * A counter that is incremented whenever the data might have changed, i.e. when an editable
+     * representation is requested, other representations are invalidated, or representations are
+     * added or cleared. Can be used to detect in-place edits, for example to invalidate caches.
+     */
+    size_t getModificationCount() const;
+
 protected:
     Data() = default;
     Data(const Data<Self, Repr>& rhs);
@@ -180,6 +204,8 @@ protected:
     mutable std::unordered_map<std::type_index, std::shared_ptr<Repr>> representations_;
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
+    mutable ConversionStatisticsMap conversionStatistics_;
+    size_t modificationCount_{0};
 };
 
 template <typename Self, typename Repr>
@@ -225,6 +251,8 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
     if (auto package = factory->getRepresentationConverter(lastValidRepresentation_->getTypeIndex(),
                                                            std::type_index(typeid(T)))) {
         for (auto converter : package->getConverters()) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto bytes = util::representationSizeInBytes(*lastValidRepresentation_);
             auto dest = converter->getConverterID().second;
             auto it = representations_.find(dest);
             if (it != representations_.end()) {  // Next repr. already exist, just update it
@@ -236,6 +264,10 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
                 if (!result) throw ConverterException("Converter failed to create", IVW_CONTEXT);
                 lastValidRepresentation_ = addRepresentationInternal(result);
             }
+            const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start);
+            factory->recordConversion(converter->getConverterID(), bytes, time);
+            conversionStatistics_[converter->getConverterID()].add(bytes, time);
         }
         return dynamic_cast<const T*>(lastValidRepresentation_.get());
     } else {
@@ -251,6 +283,18 @@ T* Data<Self, Repr>::getEditableRepresentation() {
     return const_cast<T*>(repr);
 }
 
+template <typename Self, typename Repr>
+ConversionStatisticsMap Data<Self, Repr>::getConversionStatistics() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return conversionStatistics_;
+}
+
+template <typename Self, typename Repr>
+size_t Data<Self, Repr>::getModificationCount() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return modificationCount_;
+}
+
 template <typename Self, typename Repr>
 template <typename T>
 bool Data<Self, Repr>::hasRepresentation() const {
@@ -258,10 +302,19 @@ bool Data<Self, Repr>::hasRepresentation() const {
     return util::has_key(representations_, std::type_index(typeid(T)));
 }
 
+template <typename Self, typename Repr>
+template <typename T>
+bool Data<Self, Repr>::hasValidRepresentation() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = representations_.find(std::type_index(typeid(T)));
+    return it != representations_.end() && it->second->isValid();
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
     bool found = false;
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
     for (auto& elem : representations_) {
         if (elem.second.get() != repr) {
             elem.second->setValid(false);
@@ -277,6 +330,7 @@ void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
 template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
     representations_.clear();
 }
 
@@ -302,6 +356,7 @@ std::shared_ptr<Repr> Data<Self, Repr>::addRepresentationInternal(
 template <typename Self, typename Repr>
 void Data<Self, Repr>::addRepresentation(std::shared_ptr<Repr> representation) {
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
     lastValidRepresentation_ = addRepresentationInternal(representation);
 }
 
@@ -251,6 +251,17 @@ public:
      */
     void append(const Mesh& mesh);
 
+    /**
+     * \brief Append several meshes to this mesh
+     *
+     * Same as calling append(const Mesh&) for each mesh, but the vertex buffers are only resized
+     * once and the vertex and index data is copied in parallel. Prefer this when merging many
+     * meshes, like glyphs, into one.
+     *
+     * @param meshes The meshes to copy values from, in order
+     */
+    void append(const std::vector<const Mesh*>& meshes);
+
     virtual const SpatialCameraCoordinateTransformer<3>& getCoordinateTransformer(
         const Camera& camera) const;
     using SpatialEntity<3>::getCoordinateTransformer;
@@ -35,6 +35,7 @@
 #include <inviwo/core/util/assertion.h>
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/exception.h>
 
 namespace inviwo {
 
@@ -82,6 +83,49 @@ public:
     virtual void setFromNormalizedDVec3(const size2_t& pos, dvec3 val) = 0;
     virtual void setFromNormalizedDVec4(const size2_t& pos, dvec4 val) = 0;
 
+    /**
+     * Bulk alternatives to the uniform getters and setters above. Instead of one virtual call per
+     * pixel the format is dispatched once and the whole region is converted in a tight loop.
+     * `T` can be any scalar or glm vector type, conversions follow util::glm_convert or
+     * util::glm_convert_normalized depending on `conversion`.
+     * Like dispatch, these need the definition of LayerRAMPrecision, i.e. include
+     * layerramprecision.h where they are called.
+     */
+    ///@{
+    /**
+     * Read the pixels of the rectangle [offset, offset + extent) into `dest`, x is the fastest
+     * varying index. `dest` has to hold at least extent.x * extent.y elements.
+     * @throws RangeException if the rectangle is not inside the layer.
+     */
+    template <typename T>
+    void readRegion(const size2_t& offset, const size2_t& extent, T* dest,
+                    util::ValueConversion conversion = util::ValueConversion::Plain) const;
+    /**
+     * Write `src` into the pixels of the rectangle [offset, offset + extent), x is the fastest
+     * varying index.
+     * @throws RangeException if the rectangle is not inside the layer.
+     */
+    template <typename T>
+    void writeRegion(const size2_t& offset, const size2_t& extent, const T* src,
+                     util::ValueConversion conversion = util::ValueConversion::Plain);
+    /**
+     * Read the pixels at the linear indices `indices[0..count)` into `dest[0..count)`.
+     * The indices are not bounds checked.
+     * @see posToIndex
+     */
+    template <typename T>
+    void readIndices(const size_t* indices, size_t count, T* dest,
+                     util::ValueConversion conversion = util::ValueConversion::Plain) const;
+    /**
+     * Write `src[0..count)` into the pixels at the linear indices `indices[0..count)`.
+     * The indices are not bounds checked.
+     * @see posToIndex
+     */
+    template <typename T>
+    void writeIndices(const size_t* indices, size_t count, const T* src,
+                      util::ValueConversion conversion = util::ValueConversion::Plain);
+    ///@}
+
     static size_t posToIndex(const size2_t& pos, const size2_t& dim);
 
     virtual std::type_index getTypeIndex() const override final;
@@ -167,6 +211,16 @@ struct LayerRamConstDispatcher {
                    std::forward<Args>(args)...);
     }
 };
+
+inline void checkLayerRAMRegion(const size2_t& offset, const size2_t& extent,
+                                const size2_t& dims) {
+    if (glm::any(glm::greaterThan(offset + extent, dims))) {
+        throw RangeException("Region (offset: " + toString(offset) + ", extent: " +
+                                 toString(extent) + ") is outside of the layer (dimensions: " +
+                                 toString(dims) + ")",
+                             IVW_CONTEXT_CUSTOM("LayerRAM"));
+    }
+}
 }  // namespace detail
 
 template <typename Result, template <class> class Predicate, typename Callable, typename... Args>
@@ -184,4 +238,50 @@ auto LayerRAM::dispatch(Callable&& callable, Args&&... args) const -> Result {
                                                     std::forward<Args>(args)...);
 }
 
+template <typename T>
+void LayerRAM::readRegion(const size2_t& offset, const size2_t& extent, T* dest,
+                          util::ValueConversion conversion) const {
+    const auto dims = getDimensions();
+    detail::checkLayerRAMRegion(offset, extent, dims);
+    dispatch<void>([&](auto lrprecision) {
+        const auto data = lrprecision->getDataTyped();
+        for (size_t y = 0; y < extent.y; ++y) {
+            const auto src = data + (offset.x + (offset.y + y) * dims.x);
+            util::glm_convert_n(src, extent.x, dest, conversion);
+            dest += extent.x;
+        }
+    });
+}
+
+template <typename T>
+void LayerRAM::writeRegion(const size2_t& offset, const size2_t& extent, const T* src,
+                           util::ValueConversion conversion) {
+    const auto dims = getDimensions();
+    detail::checkLayerRAMRegion(offset, extent, dims);
+    dispatch<void>([&](auto lrprecision) {
+        const auto data = lrprecision->getDataTyped();
+        for (size_t y = 0; y < extent.y; ++y) {
+            const auto dest = data + (offset.x + (offset.y + y) * dims.x);
+            util::glm_convert_n(src, extent.x, dest, conversion);
+            src += extent.x;
+        }
+    });
+}
+
+template <typename T>
+void LayerRAM::readIndices(const size_t* indices, size_t count, T* dest,
+                           util::ValueConversion conversion) const {
+    dispatch<void>([&](auto lrprecision) {
+        util::glm_convert_gather(lrprecision->getDataTyped(), indices, count, dest, conversion);
+    });
+}
+
+template <typename T>
+void LayerRAM::writeIndices(const size_t* indices, size_t count, const T* src,
+                            util::ValueConversion conversion) {
+    dispatch<void>([&](auto lrprecision) {
+        util::glm_convert_scatter(src, indices, count, lrprecision->getDataTyped(), conversion);
+    });
+}
+
 }  // namespace inviwo
@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <chrono>
+#include <iosfwd>
+#include <typeindex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace inviwo {
+
+/**
+ * Accumulated cost of a set of representation conversions.
+ * @see BaseRepresentationConverterFactory::getConversionStatistics
+ * @see Data::getConversionStatistics
+ */
+struct IVW_CORE_API ConversionStatistics {
+    /// Number of conversions
+    size_t count = 0;
+    /// Number of bytes in the source representations
+    size_t bytes = 0;
+    /// Total time spent converting
+    std::chrono::nanoseconds time{0};
+
+    void add(size_t bytes, std::chrono::nanoseconds time);
+    ConversionStatistics& operator+=(const ConversionStatistics& rhs);
+
+    /**
+     * Average time per converted byte in nanoseconds. Conversions of representations with unknown
+     * size count as one byte. Returns 0 if nothing has been recorded.
+     */
+    double nanosecondsPerByte() const;
+};
+
+/**
+ * Conversion statistics keyed on (source representation, destination representation)
+ */
+using ConversionStatisticsMap =
+    std::unordered_map<std::pair<std::type_index, std::type_index>, ConversionStatistics>;
+
+namespace util {
+
+/**
+ * Write the statistics as comma separated values with a header row:
+ * `From,To,Count,Bytes,Time (ms),ns/byte`. Rows are sorted by total time, most expensive first.
+ */
+IVW_CORE_API void writeConversionStatisticsCSV(std::ostream& os,
+                                               const ConversionStatisticsMap& statistics);
+
+/**
+ * Log a summary of the statistics to the LogCentral, sorted by total time.
+ */
+IVW_CORE_API void logConversionStatistics(const ConversionStatisticsMap& statistics,
+                                          LogLevel level = LogLevel::Info);
+
+namespace detail {
+template <typename T, typename = void>
+struct HasGetDimensions : std::false_type {};
+template <typename T>
+struct HasGetDimensions<T, std::void_t<decltype(std::declval<const T&>().getDimensions())>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct HasGetSize : std::false_type {};
+template <typename T>
+struct HasGetSize<T, std::void_t<decltype(std::declval<const T&>().getSize())>>
+    : std::true_type {};
+}  // namespace detail
+
+/**
+ * The number of bytes of data in a representation, computed from its dimensions or size and data
+ * format. Returns 0 for representations without dimensions or size.
+ */
+template <typename Repr>
+size_t representationSizeInBytes(const Repr& repr) {
+    if constexpr (detail::HasGetDimensions<Repr>::value) {
+        return static_cast<size_t>(glm::compMul(repr.getDimensions())) *
+               repr.getDataFormat()->getSize();
+    } else if constexpr (detail::HasGetSize<Repr>::value) {
+        return repr.getSize() * repr.getDataFormat()->getSize();
+    } else {
+        return 0;
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
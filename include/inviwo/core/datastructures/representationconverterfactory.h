@@ -31,10 +31,13 @@
 
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/datastructures/representationconverter.h>
+#include <inviwo/core/datastructures/representationconversionstatistics.h>
 #include <inviwo/core/util/stdextensions.h>
 
 #include <warn/push>
 #include <warn/ignore/all>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <typeindex>
@@ -51,9 +54,44 @@ namespace inviwo {
 class IVW_CORE_API BaseRepresentationConverterFactory {
 public:
     using BaseReprId = std::type_index;
+    using ConverterID = std::pair<std::type_index, std::type_index>;
     BaseRepresentationConverterFactory() = default;
     virtual ~BaseRepresentationConverterFactory() = default;
     virtual BaseReprId getBaseReprId() = 0;
+
+    /**
+     * Record a single conversion step, called by Data for every converter it runs.
+     * The measured costs are used to choose between alternative conversion paths.
+     * @param id the converter used
+     * @param bytes the size of the source representation
+     * @param time the time spent in the converter
+     */
+    void recordConversion(ConverterID id, size_t bytes, std::chrono::nanoseconds time);
+
+    /**
+     * The accumulated statistics of all conversions done with converters of this factory.
+     */
+    ConversionStatisticsMap getConversionStatistics() const;
+    void resetConversionStatistics();
+
+    /**
+     * The estimated cost of a conversion step in nanoseconds per byte. Steps that have not been
+     * measured yet get the average of the measured ones, or 1 if nothing has been measured, such
+     * that paths with fewer steps are preferred until there is data.
+     */
+    double getConversionCost(ConverterID id) const;
+
+protected:
+    /**
+     * Incremented whenever the cost estimates change in a way that might change which conversion
+     * path is the cheapest, i.e. when a converter is measured for the first time.
+     */
+    size_t getCostGeneration() const;
+
+private:
+    mutable std::mutex statisticsMutex_;
+    ConversionStatisticsMap statistics_;
+    std::atomic<size_t> costGeneration_{0};
 };
 
 /**
@@ -67,7 +105,7 @@ public:
 template <typename BaseRepr>
 class RepresentationConverterFactory : public BaseRepresentationConverterFactory {
 public:
-    using ConverterID = typename RepresentationConverter<BaseRepr>::ConverterID;
+    using ConverterID = BaseRepresentationConverterFactory::ConverterID;
     using RepMap = std::unordered_map<ConverterID, RepresentationConverter<BaseRepr>*>;
     using PackageMap =
         std::unordered_multimap<ConverterID,
@@ -81,20 +119,27 @@ public:
     bool registerObject(RepresentationConverter<BaseRepr>* representationConverter);
     bool unRegisterObject(RepresentationConverter<BaseRepr>* representationConverter);
 
-    // Get best converter
+    /**
+     * Get the cheapest converter package according to the measured conversion costs.
+     * @see getConversionCost
+     */
     const RepresentationConverterPackage<BaseRepr>* getRepresentationConverter(ConverterID);
     const RepresentationConverterPackage<BaseRepr>* getRepresentationConverter(std::type_index from,
                                                                                std::type_index to);
 
 private:
     const RepresentationConverterPackage<BaseRepr>* createConverterPackage(ConverterID id);
+    double getPackageCost(const RepresentationConverterPackage<BaseRepr>& package) const;
 
     // converters are owned by the Module
     RepMap converters_;
 
-    // All the converter packages created locally;
+    // All the converter packages created locally, packages are never removed while their
+    // converters are registered since Data might be using them.
     std::mutex mutex_;
     PackageMap packages_;
+    // The cost generation for which the cheapest package for an id was last searched for
+    std::unordered_map<ConverterID, size_t> planned_;
 };
 
 template <typename BaseRepr>
@@ -118,12 +163,14 @@ bool RepresentationConverterFactory<BaseRepr>::unRegisterObject(
         converters_,
         [converter](typename RepMap::value_type& elem) { return elem.second == converter; });
 
+    std::unique_lock<std::mutex> lock(mutex_);
     util::map_erase_remove_if(packages_, [converter](typename PackageMap::value_type& elem) {
         for (auto& conv : elem.second->getConverters()) {
             if (conv == converter) return true;
         }
         return false;
     });
+    planned_.clear();
 
     return removed > 0;
 }
@@ -131,22 +178,35 @@ bool RepresentationConverterFactory<BaseRepr>::unRegisterObject(
 template <typename BaseRepr>
 const RepresentationConverterPackage<BaseRepr>*
 RepresentationConverterFactory<BaseRepr>::getRepresentationConverter(ConverterID id) {
-    RepresentationConverterPackage<BaseRepr>* res = nullptr;
-    const size_t steps = std::numeric_limits<size_t>::max();
+    const auto generation = getCostGeneration();
     {
         std::unique_lock<std::mutex> lock(mutex_);
-        auto range = packages_.equal_range(id);
-        for (auto it = range.first; it != range.second; ++it) {
-            if (it->second->steps() < steps) {
-                res = it->second.get();
+        auto planned = planned_.find(id);
+        if (planned != planned_.end() && planned->second == generation) {
+            RepresentationConverterPackage<BaseRepr>* res = nullptr;
+            double cost = std::numeric_limits<double>::max();
+            auto range = packages_.equal_range(id);
+            for (auto it = range.first; it != range.second; ++it) {
+                const auto packageCost = getPackageCost(*it->second);
+                if (packageCost < cost) {
+                    cost = packageCost;
+                    res = it->second.get();
+                }
             }
+            if (res) return res;
         }
     }
-    if (res) {
-        return res;
-    } else {
-        return createConverterPackage(id);
+    return createConverterPackage(id);
+}
+
+template <typename BaseRepr>
+double RepresentationConverterFactory<BaseRepr>::getPackageCost(
+    const RepresentationConverterPackage<BaseRepr>& package) const {
+    double cost = 0.0;
+    for (auto converter : package.getConverters()) {
+        cost += getConversionCost(converter->getConverterID());
     }
+    return cost;
 }
 
 template <typename BaseRepr>
@@ -171,25 +231,27 @@ RepresentationConverterFactory<BaseRepr>::createConverterPackage(ConverterID id)
         verts.insert(converter.first.second);
     }
 
-    std::unordered_map<std::type_index, size_t> dist;
+    const auto generation = getCostGeneration();
+
+    std::unordered_map<std::type_index, double> dist;
     std::unordered_map<std::type_index, std::type_index> prev;
 
-    dist[source] = 0;
+    dist[source] = 0.0;
 
     std::unordered_set<std::type_index> Q;
     for (auto v : verts) {
         if (v != source) {
-            dist[v] = std::numeric_limits<size_t>::max();
+            dist[v] = std::numeric_limits<double>::infinity();
         }
         Q.insert(v);
     }
 
     while (!Q.empty()) {
-        std::size_t steps = std::numeric_limits<size_t>::max();
+        double cost = std::numeric_limits<double>::infinity();
         std::type_index u = *Q.begin();
         for (auto t : Q)
-            if (dist[t] < steps) {
-                steps = dist[t];
+            if (dist[t] < cost) {
+                cost = dist[t];
                 u = t;
             }
         Q.erase(u);
@@ -199,10 +261,10 @@ RepresentationConverterFactory<BaseRepr>::createConverterPackage(ConverterID id)
         for (auto converter : converters_) {
             if (converter.first.first == u) {
                 auto v = converter.first.second;
-                size_t alt = dist[u] + 1;
+                double alt = dist[u] + getConversionCost(converter.first);
                 if (alt < dist[v]) {
                     dist[v] = alt;
-                    prev.emplace(std::make_pair(v, u));
+                    prev.insert_or_assign(v, u);
                 }
             }
         }
@@ -222,11 +284,18 @@ RepresentationConverterFactory<BaseRepr>::createConverterPackage(ConverterID id)
         for (auto it = S.crbegin(); it != S.crend(); it++) {
             package->addConverter(*it);
         }
-        auto res = package.get();
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
-            packages_.emplace(std::make_pair(package->getConverterID(), std::move(package)));
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        planned_[id] = generation;
+        // Reuse an identical package if we have one, the old one might be in use.
+        auto range = packages_.equal_range(id);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->getConverters() == package->getConverters()) {
+                return it->second.get();
+            }
         }
+        auto res = package.get();
+        packages_.emplace(std::make_pair(package->getConverterID(), std::move(package)));
         return res;
     } else {
         return nullptr;
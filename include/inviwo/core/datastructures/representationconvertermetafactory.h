@@ -61,6 +61,14 @@ public:
     template <typename BaseRepr>
     RepresentationConverterFactory<BaseRepr>* getConverterFactory() const;
 
+    /**
+     * The conversion statistics of all registered factories.
+     * @see util::writeConversionStatisticsCSV
+     * @see util::logConversionStatistics
+     */
+    ConversionStatisticsMap getConversionStatistics() const;
+    void resetConversionStatistics();
+
 private:
     FactoryMap map_;
 };
@@ -35,6 +35,7 @@
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/exception.h>
 
 namespace inviwo {
 
@@ -86,6 +87,49 @@ public:
     virtual void setFromNormalizedDVec3(const size3_t& pos, dvec3 val) = 0;
     virtual void setFromNormalizedDVec4(const size3_t& pos, dvec4 val) = 0;
 
+    /**
+     * Bulk alternatives to the uniform getters and setters above. Instead of one virtual call per
+     * voxel the format is dispatched once and the whole region is converted in a tight loop.
+     * `T` can be any scalar or glm vector type, conversions follow util::glm_convert or
+     * util::glm_convert_normalized depending on `conversion`.
+     * Like dispatch, these need the definition of VolumeRAMPrecision, i.e. include
+     * volumeramprecision.h where they are called.
+     */
+    ///@{
+    /**
+     * Read the voxels of the box [offset, offset + extent) into `dest`, x is the fastest varying
+     * index. `dest` has to hold at least extent.x * extent.y * extent.z elements.
+     * @throws RangeException if the box is not inside the volume.
+     */
+    template <typename T>
+    void readRegion(const size3_t& offset, const size3_t& extent, T* dest,
+                    util::ValueConversion conversion = util::ValueConversion::Plain) const;
+    /**
+     * Write `src` into the voxels of the box [offset, offset + extent), x is the fastest varying
+     * index.
+     * @throws RangeException if the box is not inside the volume.
+     */
+    template <typename T>
+    void writeRegion(const size3_t& offset, const size3_t& extent, const T* src,
+                     util::ValueConversion conversion = util::ValueConversion::Plain);
+    /**
+     * Read the voxels at the linear indices `indices[0..count)` into `dest[0..count)`.
+     * The indices are not bounds checked.
+     * @see posToIndex
+     */
+    template <typename T>
+    void readIndices(const size_t* indices, size_t count, T* dest,
+                     util::ValueConversion conversion = util::ValueConversion::Plain) const;
+    /**
+     * Write `src[0..count)` into the voxels at the linear indices `indices[0..count)`.
+     * The indices are not bounds checked.
+     * @see posToIndex
+     */
+    template <typename T>
+    void writeIndices(const size_t* indices, size_t count, const T* src,
+                      util::ValueConversion conversion = util::ValueConversion::Plain);
+    ///@}
+
     virtual size_t getNumberOfBytes() const = 0;
 
     template <typename T>
@@ -192,6 +236,16 @@ struct VolumeRamConstDispatcher {
                    std::forward<Args>(args)...);
     }
 };
+
+inline void checkVolumeRAMRegion(const size3_t& offset, const size3_t& extent,
+                                 const size3_t& dims) {
+    if (glm::any(glm::greaterThan(offset + extent, dims))) {
+        throw RangeException("Region (offset: " + toString(offset) + ", extent: " +
+                                 toString(extent) + ") is outside of the volume (dimensions: " +
+                                 toString(dims) + ")",
+                             IVW_CONTEXT_CUSTOM("VolumeRAM"));
+    }
+}
 }  // namespace detail
 
 template <typename Result, template <class> class Predicate, typename Callable, typename... Args>
@@ -210,4 +264,54 @@ auto VolumeRAM::dispatch(Callable&& callable, Args&&... args) const -> Result {
                                                     std::forward<Args>(args)...);
 }
 
+template <typename T>
+void VolumeRAM::readRegion(const size3_t& offset, const size3_t& extent, T* dest,
+                           util::ValueConversion conversion) const {
+    const auto dims = getDimensions();
+    detail::checkVolumeRAMRegion(offset, extent, dims);
+    dispatch<void>([&](auto vrprecision) {
+        const auto data = vrprecision->getDataTyped();
+        for (size_t z = 0; z < extent.z; ++z) {
+            for (size_t y = 0; y < extent.y; ++y) {
+                const auto src = data + posToIndex(offset + size3_t{0, y, z}, dims);
+                util::glm_convert_n(src, extent.x, dest, conversion);
+                dest += extent.x;
+            }
+        }
+    });
+}
+
+template <typename T>
+void VolumeRAM::writeRegion(const size3_t& offset, const size3_t& extent, const T* src,
+                            util::ValueConversion conversion) {
+    const auto dims = getDimensions();
+    detail::checkVolumeRAMRegion(offset, extent, dims);
+    dispatch<void>([&](auto vrprecision) {
+        const auto data = vrprecision->getDataTyped();
+        for (size_t z = 0; z < extent.z; ++z) {
+            for (size_t y = 0; y < extent.y; ++y) {
+                const auto dest = data + posToIndex(offset + size3_t{0, y, z}, dims);
+                util::glm_convert_n(src, extent.x, dest, conversion);
+                src += extent.x;
+            }
+        }
+    });
+}
+
+template <typename T>
+void VolumeRAM::readIndices(const size_t* indices, size_t count, T* dest,
+                            util::ValueConversion conversion) const {
+    dispatch<void>([&](auto vrprecision) {
+        util::glm_convert_gather(vrprecision->getDataTyped(), indices, count, dest, conversion);
+    });
+}
+
+template <typename T>
+void VolumeRAM::writeIndices(const size_t* indices, size_t count, const T* src,
+                             util::ValueConversion conversion) {
+    dispatch<void>([&](auto vrprecision) {
+        util::glm_convert_scatter(src, indices, count, vrprecision->getDataTyped(), conversion);
+    });
+}
+
 }  // namespace inviwo
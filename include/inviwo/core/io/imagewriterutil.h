@@ -34,6 +34,7 @@
 #include <inviwo/core/datastructures/image/layer.h>
 
 #include <string>
+#include <memory>
 
 namespace inviwo {
 
@@ -44,6 +45,50 @@ IVW_CORE_API void saveLayer(const Layer& layer, const std::string& path,
 
 IVW_CORE_API void saveLayer(const Layer& layer);
 
+/**
+ * \brief Encodes layers on the thread pool and writes them to disk in the order they were added
+ *
+ * Each enqueued layer is copied to RAM on the calling thread, encoded into a memory buffer by the
+ * writer registered for the extension on a pool thread, and then written to disk. Files are
+ * always written in enqueue order. At most maxInFlight layers are kept in memory at once,
+ * enqueue blocks until an earlier layer has been written when that limit is reached.
+ * Writers that do not support encoding to a buffer write the file directly, still in order.
+ */
+class IVW_CORE_API LayerExportQueue {
+public:
+    /**
+     * @param maxInFlight maximum number of layers kept in memory, 0 uses the pool size + 1
+     */
+    explicit LayerExportQueue(size_t maxInFlight = 0);
+    LayerExportQueue(const LayerExportQueue&) = delete;
+    LayerExportQueue& operator=(const LayerExportQueue&) = delete;
+    /**
+     * Waits for all enqueued layers to be written
+     */
+    ~LayerExportQueue();
+
+    /**
+     * Enqueue layer to be written to path, see saveLayer for how the writer is selected.
+     * Has to be called from the thread owning the layer representations, usually the main thread.
+     */
+    void enqueue(const Layer& layer, const std::string& path,
+                 const FileExtension& extension = FileExtension());
+
+    /**
+     * Block until all enqueued layers have been written
+     */
+    void wait();
+
+    /**
+     * Number of layers enqueued but not yet written
+     */
+    size_t size() const;
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
 }  // namespace util
 
 }  // namespace inviwo
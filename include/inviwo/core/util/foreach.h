@@ -33,6 +33,14 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <utility>
 
 namespace inviwo {
@@ -141,6 +149,103 @@ void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs
     }
 }
 
+/**
+ * Calls callback(first, last) for consecutive ranges covering [0, size) using the thread pool. The
+ * ranges are handed out dynamically to the pool threads and to the calling thread, which also does
+ * work. This makes it safe to call from a job that is itself running on the pool. Once stop
+ * evaluates to true no more work is started. progress(done, size) is called from the calling thread
+ * only. The function returns when all started work has finished, exceptions thrown by the callback
+ * are rethrown in the calling thread.
+ *
+ * @param size the number of items
+ * @param stop a stop token, any type convertible to bool, like pool::Stop
+ * @param progress callback of type (size_t done, size_t size) -> void
+ * @param callback callback of type (size_t first, size_t last) -> void
+ */
+template <typename Stop, typename Progress, typename Callback>
+void forEachRangeParallel(size_t size, const Stop& stop, Progress&& progress,
+                          Callback&& callback) {
+    if (size == 0) return;
+
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    const size_t nRanges = std::min(size, poolSize == 0 ? size_t{32} : 8 * (poolSize + 1));
+    const auto range = [size, nRanges](size_t i) {
+        return std::make_pair(size * i / nRanges, size * (i + 1) / nRanges);
+    };
+
+    if (poolSize == 0) {
+        for (size_t i = 0; i < nRanges && !stop; ++i) {
+            const auto [first, last] = range(i);
+            callback(first, last);
+            progress(last, size);
+        }
+        return;
+    }
+
+    // Shared with the pool jobs, which might start after this function has returned. Such late
+    // jobs find no ranges left and will then not touch the callback or stop token.
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> doneItems{0};
+        size_t doneRanges{0};
+        std::mutex mutex;
+        std::condition_variable cvar;
+        std::exception_ptr exception;
+    };
+    auto state = std::make_shared<State>();
+
+    const auto work = [state, nRanges, range, stopPtr = &stop,
+                       callbackPtr = &callback](auto&& onRangeDone) {
+        for (size_t i = state->next++; i < nRanges; i = state->next++) {
+            const auto [first, last] = range(i);
+            std::exception_ptr exception;
+            if (!*stopPtr) {
+                try {
+                    (*callbackPtr)(first, last);
+                } catch (...) {
+                    exception = std::current_exception();
+                }
+            }
+            state->doneItems += last - first;
+            {
+                std::scoped_lock lock{state->mutex};
+                if (exception && !state->exception) state->exception = exception;
+                ++state->doneRanges;
+            }
+            state->cvar.notify_all();
+            onRangeDone();
+        }
+    };
+
+    for (size_t i = 0; i < std::min(poolSize, nRanges - 1); ++i) {
+        dispatchPool([work]() { work([]() {}); });
+    }
+    work([&]() { progress(state->doneItems.load(), size); });
+
+    while (true) {
+        {
+            std::unique_lock lock{state->mutex};
+            if (state->cvar.wait_for(lock, std::chrono::milliseconds(50),
+                                     [&]() { return state->doneRanges == nRanges; })) {
+                break;
+            }
+        }
+        progress(state->doneItems.load(), size);
+    }
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+
+/**
+ * Same as forEachRangeParallel(size_t, const Stop&, Progress&&, Callback&&) but without any stop
+ * token or progress reporting.
+ */
+template <typename Callback>
+void forEachRangeParallel(size_t size, Callback&& callback) {
+    forEachRangeParallel(size, std::false_type{}, [](size_t, size_t) {},
+                         std::forward<Callback>(callback));
+}
+
 }  // namespace util
 
 }  // namespace inviwo
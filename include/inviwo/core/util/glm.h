@@ -60,6 +60,7 @@
 
 #include <warn/pop>
 
+#include <algorithm>
 #include <limits>
 #include <type_traits>
 
@@ -600,6 +601,58 @@ To glm_convert_normalized(From x) {
     return res;
 }
 
+/**
+ * Selects the conversion used by the bulk conversion functions, `Plain` corresponds to
+ * glm_convert and `Normalized` to glm_convert_normalized.
+ */
+enum class ValueConversion { Plain, Normalized };
+
+/**
+ * Convert `count` consecutive values from `src` into `dst`. The conversion is selected once for
+ * the whole range and conversions between identical types are plain copies, which lets the
+ * compiler vectorize the loops.
+ */
+template <typename To, typename From>
+void glm_convert_n(const From* src, size_t count, To* dst,
+                   ValueConversion conversion = ValueConversion::Plain) {
+    if constexpr (std::is_same<To, From>::value) {
+        std::copy_n(src, count, dst);
+    } else if (conversion == ValueConversion::Normalized) {
+        std::transform(src, src + count, dst,
+                       [](const From& x) { return glm_convert_normalized<To>(x); });
+    } else {
+        std::transform(src, src + count, dst, [](const From& x) { return glm_convert<To>(x); });
+    }
+}
+
+/**
+ * Convert the values `src[indices[i]]` for `i` in [0, count) into `dst[i]`.
+ * @see glm_convert_n
+ */
+template <typename To, typename From>
+void glm_convert_gather(const From* src, const size_t* indices, size_t count, To* dst,
+                        ValueConversion conversion = ValueConversion::Plain) {
+    if (conversion == ValueConversion::Normalized) {
+        for (size_t i = 0; i < count; ++i) dst[i] = glm_convert_normalized<To>(src[indices[i]]);
+    } else {
+        for (size_t i = 0; i < count; ++i) dst[i] = glm_convert<To>(src[indices[i]]);
+    }
+}
+
+/**
+ * Convert the values `src[i]` for `i` in [0, count) into `dst[indices[i]]`.
+ * @see glm_convert_n
+ */
+template <typename To, typename From>
+void glm_convert_scatter(const From* src, const size_t* indices, size_t count, To* dst,
+                         ValueConversion conversion = ValueConversion::Plain) {
+    if (conversion == ValueConversion::Normalized) {
+        for (size_t i = 0; i < count; ++i) dst[indices[i]] = glm_convert_normalized<To>(src[i]);
+    } else {
+        for (size_t i = 0; i < count; ++i) dst[indices[i]] = glm_convert<To>(src[i]);
+    }
+}
+
 #include <warn/pop>
 
 // GLM element access wrapper functions. Useful in template functions with scalar and vec types
@@ -32,8 +32,10 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/glmvec.h>
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/foreach.h>
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <future>
 
@@ -42,10 +44,6 @@ class Image;
 
 namespace util {
 
-namespace detail {
-IVW_CORE_API size_t getPoolSize();
-}
-
 template <typename C>
 void forEachPixel(const size2_t dims, C callback) {
     size2_t pos;
@@ -61,40 +59,91 @@ void forEachPixel(const LayerRAM &layer, C callback) {
     forEachPixel(layer.getDimensions(), callback);
 }
 
+/**
+ * Default tile size used by the parallel pixel iterations.
+ */
+constexpr size2_t defaultPixelTileSize{64, 64};
+
+/**
+ * Calls callback(begin, end) for each tile [begin, end) of size tileSize (smaller at the borders)
+ * covering the image dims. The tiles are pulled dynamically by the thread pool and the calling
+ * thread, which gives good load balancing also for skewed workloads and thin, wide images. Falls
+ * back to a serial loop when there is no thread pool.
+ * @see util::forEachRangeParallel
+ */
 template <typename C>
-void forEachPixelParallel(const size2_t dims, C callback, size_t jobs = 0) {
-    if (jobs == 0) {
-        jobs = 4 * detail::getPoolSize();
-        if (jobs == 0) {  // if poolsize is zero
-            forEachPixel(dims, callback);
-            return;
+void forEachPixelTileParallel(const size2_t dims, C callback,
+                              const size2_t tileSize = defaultPixelTileSize) {
+    const auto tile = glm::max(tileSize, size2_t{1});
+    const auto tiles = (dims + tile - size2_t{1}) / tile;
+    forEachRangeParallel(tiles.x * tiles.y, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            const auto begin = size2_t{i % tiles.x, i / tiles.x} * tile;
+            callback(begin, glm::min(begin + tile, dims));
         }
-    }
-
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size2_t start = size2_t(0, job * dims.y / jobs);
-        size2_t stop = size2_t(dims.x, std::min(dims.y, (job + 1) * dims.y / jobs));
-
-        futures.push_back(dispatchPool([&callback, start, stop]() {
-            size2_t pos{0};
+    });
+}
 
-            for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
+/**
+ * Calls callback(pos) for each pixel position in dims, in parallel using tiles.
+ * @see forEachPixelTileParallel
+ */
+template <typename C>
+void forEachPixelParallel(const size2_t dims, C callback,
+                          const size2_t tileSize = defaultPixelTileSize) {
+    forEachPixelTileParallel(
+        dims,
+        [&](const size2_t &begin, const size2_t &end) {
+            size2_t pos;
+            for (pos.y = begin.y; pos.y < end.y; ++pos.y) {
+                for (pos.x = begin.x; pos.x < end.x; ++pos.x) {
                     callback(pos);
                 }
             }
-        }));
-    }
-
-    for (const auto &e : futures) {
-        e.wait();
-    }
+        },
+        tileSize);
 }
 
 template <typename C>
-void forEachPixelParallel(const LayerRAM &layer, C callback, size_t jobs = 0) {
-    forEachPixelParallel(layer.getDimensions(), callback, jobs);
+void forEachPixelParallel(const LayerRAM &layer, C callback,
+                          const size2_t tileSize = defaultPixelTileSize) {
+    forEachPixelParallel(layer.getDimensions(), callback, tileSize);
+}
+
+/**
+ * Calls callback(pos, result) for each pixel position in dims, in parallel using tiles, and
+ * returns the reduction of all the results, see util::forEachVoxelParallelReduce.
+ */
+template <typename T, typename C, typename R>
+T forEachPixelParallelReduce(const size2_t dims, T init, C callback, R reduce,
+                             const size2_t tileSize = defaultPixelTileSize) {
+    const auto tile = glm::max(tileSize, size2_t{1});
+    const auto tiles = (dims + tile - size2_t{1}) / tile;
+    std::mutex mutex;
+    T result = init;
+    forEachRangeParallel(tiles.x * tiles.y, [&](size_t first, size_t last) {
+        T local = init;
+        for (size_t i = first; i < last; ++i) {
+            const auto begin = size2_t{i % tiles.x, i / tiles.x} * tile;
+            const auto end = glm::min(begin + tile, dims);
+            size2_t pos;
+            for (pos.y = begin.y; pos.y < end.y; ++pos.y) {
+                for (pos.x = begin.x; pos.x < end.x; ++pos.x) {
+                    callback(pos, local);
+                }
+            }
+        }
+        std::scoped_lock lock{mutex};
+        result = reduce(result, local);
+    });
+    return result;
+}
+
+template <typename T, typename C, typename R>
+T forEachPixelParallelReduce(const LayerRAM &layer, T init, C callback, R reduce,
+                             const size2_t tileSize = defaultPixelTileSize) {
+    return forEachPixelParallelReduce(layer.getDimensions(), std::move(init), callback, reduce,
+                                      tileSize);
 }
 
 IVW_CORE_API std::shared_ptr<Image> readImageFromDisk(std::string filename);
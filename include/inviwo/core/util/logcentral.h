@@ -34,6 +34,9 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -110,13 +113,14 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& s
     return ss;
 }
 
-#define LogSpecial(logger, logLevel, message)                                            \
-    {                                                                                    \
-        std::ostringstream stream__;                                                     \
-        stream__ << message;                                                             \
-        logger->log(inviwo::parseTypeIdName(std::string(typeid(this).name())), logLevel, \
-                    inviwo::LogAudience::Developer, __FILE__, __FUNCTION__, __LINE__,    \
-                    stream__.str());                                                     \
+#define LogSpecial(logger, logLevel, message)                                                  \
+    {                                                                                          \
+        static const std::string source__ =                                                    \
+            inviwo::parseTypeIdName(std::string(typeid(this).name()));                         \
+        std::ostringstream stream__;                                                           \
+        stream__ << message;                                                                   \
+        logger->log(source__, logLevel, inviwo::LogAudience::Developer, __FILE__, __FUNCTION__, \
+                    __LINE__, stream__.str());                                                 \
     }
 
 #define LogCustomSpecial(logger, logLevel, source, message)                                   \
@@ -188,10 +192,20 @@ public:
     virtual void logAssertion(const char* file, const char* function, int line, std::string msg);
 };
 
+/**
+ * \brief Dispatches log messages to all registered loggers.
+ *
+ * By default messages are dispatched synchronously on the calling thread. In asynchronous mode
+ * log() and logNetwork() only put the message into a ring buffer owned by the calling thread, and
+ * a single consumer thread dispatches the messages to the loggers in the order they were logged.
+ * If the buffer of a thread is full, info and warning messages are dropped and the number of
+ * dropped messages is reported, errors wait for space. Processor messages and assertions are
+ * always dispatched synchronously, after all queued messages.
+ */
 class IVW_CORE_API LogCentral : public Singleton<LogCentral>, public Logger {
 public:
     LogCentral();
-    virtual ~LogCentral() = default;
+    virtual ~LogCentral();
 
     void setVerbosity(LogVerbosity verbosity);
     LogVerbosity getVerbosity();
@@ -223,17 +237,46 @@ public:
     void setMessageBreakLevel(MessageBreakLevel level);
     MessageBreakLevel getMessageBreakLevel() const;
 
+    /**
+     * \brief Enable or disable asynchronous dispatching of log messages. Disabling will dispatch
+     * all queued messages before returning.
+     */
+    void setAsynchronous(bool async);
+    bool isAsynchronous() const;
+
+    /**
+     * \brief Set the number of messages each thread can have queued in asynchronous mode.
+     * Only affects threads that have not logged since asynchronous mode was enabled.
+     */
+    void setQueueCapacity(size_t capacity);
+
+    /**
+     * \brief Blocks until all messages logged before the call have been dispatched.
+     * Does nothing in synchronous mode.
+     */
+    void flush();
+
 private:
     friend Singleton<LogCentral>;
     static LogCentral* instance_;
 
-    LogVerbosity logVerbosity_;
+    class AsyncDispatcher;
+    friend AsyncDispatcher;
+
+    template <typename F>
+    void forEachLogger(F&& f);
+
+    std::atomic<LogVerbosity> logVerbosity_;
 #include <warn/push>
 #include <warn/ignore/dll-interface>
+    std::mutex loggersMutex_;
     std::vector<std::weak_ptr<Logger>> loggers_;
+    std::mutex asyncMutex_;
+    std::shared_ptr<AsyncDispatcher> async_;
 #include <warn/pop>
     bool logStacktrace_ = false;
     MessageBreakLevel breakLevel_ = MessageBreakLevel::Off;
+    size_t queueCapacity_ = 4096;
 };
 
 namespace util {
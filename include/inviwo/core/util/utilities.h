@@ -43,12 +43,22 @@ class ProcessorWidget;
 
 namespace util {
 
+class LayerExportQueue;
+
 IVW_CORE_API void saveNetwork(ProcessorNetwork* network, std::string filename);
 
 IVW_CORE_API void saveAllCanvases(ProcessorNetwork* network, const std::string& dir,
                                   const std::string& name = "UPN", const std::string& ext = ".png",
                                   bool onlyActiveCanvases = false);
 
+/**
+ * Same as above but the canvas layers are handed to queue, which encodes and writes them
+ * asynchronously.
+ */
+IVW_CORE_API void saveAllCanvases(ProcessorNetwork* network, const std::string& dir,
+                                  const std::string& name, const std::string& ext,
+                                  bool onlyActiveCanvases, LayerExportQueue& queue);
+
 IVW_CORE_API bool isValidIdentifierCharacter(char c, const std::string& extra = "");
 
 IVW_CORE_API void validateIdentifier(const std::string& identifier, const std::string& type,
@@ -32,6 +32,9 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <mutex>
 
 namespace inviwo {
 
@@ -54,43 +57,107 @@ void forEachVoxel(const VolumeRAM &v, C callback) {
     forEachVoxel(v.getDimensions(), callback);
 }
 
-template <typename C>
-void forEachVoxelParallel(const size3_t dims, C callback, size_t jobs = 0) {
-    if (InviwoApplication::isInitialized() && jobs == 0) {
-        jobs = 4 * InviwoApplication::getPtr()->getPoolSize();
-    }
-
-    if (jobs == 0 || !InviwoApplication::isInitialized()) {
-        // fallback to serial version
-        forEachVoxel(dims, callback);
-        return;
-    }
-
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size3_t start = size3_t(0, 0, job * dims.z / jobs);
-        size3_t stop = size3_t(dims.x, dims.y, std::min(dims.z, (job + 1) * dims.z / jobs));
+/**
+ * Default tile size used by the parallel voxel iterations. Long along x to keep memory accesses
+ * contiguous, and small enough for a tile and its neighborhood to stay in cache.
+ */
+constexpr size3_t defaultVoxelTileSize{64, 16, 16};
 
-        futures.push_back(dispatchPool([&callback, start, stop]() {
-            size3_t pos{0};
+/**
+ * Calls callback(begin, end) for each tile [begin, end) of size tileSize (smaller at the borders)
+ * covering the volume dims. The tiles are pulled dynamically by the thread pool and the calling
+ * thread, which gives good load balancing also for skewed workloads and thin volumes. Falls back
+ * to a serial loop when there is no thread pool.
+ * @see util::forEachRangeParallel
+ */
+template <typename C>
+void forEachVoxelTileParallel(const size3_t dims, C callback,
+                              const size3_t tileSize = defaultVoxelTileSize) {
+    const auto tile = glm::max(tileSize, size3_t{1});
+    const auto tiles = (dims + tile - size3_t{1}) / tile;
+    forEachRangeParallel(tiles.x * tiles.y * tiles.z, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            const size3_t t{i % tiles.x, (i / tiles.x) % tiles.y, i / (tiles.x * tiles.y)};
+            const auto begin = t * tile;
+            callback(begin, glm::min(begin + tile, dims));
+        }
+    });
+}
 
-            for (pos.z = start.z; pos.z < stop.z; ++pos.z) {
-                for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                    for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
+/**
+ * Calls callback(pos) for each voxel position in dims, in parallel using tiles.
+ * @see forEachVoxelTileParallel
+ */
+template <typename C>
+void forEachVoxelParallel(const size3_t dims, C callback,
+                          const size3_t tileSize = defaultVoxelTileSize) {
+    forEachVoxelTileParallel(
+        dims,
+        [&](const size3_t& begin, const size3_t& end) {
+            size3_t pos;
+            for (pos.z = begin.z; pos.z < end.z; ++pos.z) {
+                for (pos.y = begin.y; pos.y < end.y; ++pos.y) {
+                    for (pos.x = begin.x; pos.x < end.x; ++pos.x) {
                         callback(pos);
                     }
                 }
             }
-        }));
-    }
-
-    for (const auto &e : futures) {
-        e.wait();
-    }
+        },
+        tileSize);
 }
 template <typename C>
-void forEachVoxelParallel(const VolumeRAM &v, C callback, size_t jobs = 0) {
-    forEachVoxelParallel(v.getDimensions(), callback, jobs);
+void forEachVoxelParallel(const VolumeRAM &v, C callback,
+                          const size3_t tileSize = defaultVoxelTileSize) {
+    forEachVoxelParallel(v.getDimensions(), callback, tileSize);
+}
+
+/**
+ * Calls callback(pos, result) for each voxel position in dims, in parallel using tiles, and
+ * returns the reduction of all the results. Each thread accumulates into its own result, starting
+ * from `init`, and the results are then combined using reduce(a, b). Hence `init` should be the
+ * identity of `reduce`, and `reduce` should be associative and commutative.
+ *
+ * Example, finding the max value of a volume:
+ * ```{.cpp}
+ * auto max = util::forEachVoxelParallelReduce(
+ *     dims, std::numeric_limits<float>::lowest(),
+ *     [&](const size3_t& pos, float& res) { res = std::max(res, data[im(pos)]); },
+ *     [](float a, float b) { return std::max(a, b); });
+ * ```
+ * @see forEachVoxelTileParallel
+ */
+template <typename T, typename C, typename R>
+T forEachVoxelParallelReduce(const size3_t dims, T init, C callback, R reduce,
+                             const size3_t tileSize = defaultVoxelTileSize) {
+    const auto tile = glm::max(tileSize, size3_t{1});
+    const auto tiles = (dims + tile - size3_t{1}) / tile;
+    std::mutex mutex;
+    T result = init;
+    forEachRangeParallel(tiles.x * tiles.y * tiles.z, [&](size_t first, size_t last) {
+        T local = init;
+        for (size_t i = first; i < last; ++i) {
+            const size3_t t{i % tiles.x, (i / tiles.x) % tiles.y, i / (tiles.x * tiles.y)};
+            const auto begin = t * tile;
+            const auto end = glm::min(begin + tile, dims);
+            size3_t pos;
+            for (pos.z = begin.z; pos.z < end.z; ++pos.z) {
+                for (pos.y = begin.y; pos.y < end.y; ++pos.y) {
+                    for (pos.x = begin.x; pos.x < end.x; ++pos.x) {
+                        callback(pos, local);
+                    }
+                }
+            }
+        }
+        std::scoped_lock lock{mutex};
+        result = reduce(result, local);
+    });
+    return result;
+}
+template <typename T, typename C, typename R>
+T forEachVoxelParallelReduce(const VolumeRAM &v, T init, C callback, R reduce,
+                             const size3_t tileSize = defaultVoxelTileSize) {
+    return forEachVoxelParallelReduce(v.getDimensions(), std::move(init), callback, reduce,
+                                      tileSize);
 }
 
 }  // namespace util
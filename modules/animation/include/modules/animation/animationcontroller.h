@@ -34,12 +34,15 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/util/timer.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/io/imagewriterutil.h>
+#include <inviwo/core/util/clock.h>
 
 #include <modules/animation/datastructures/animation.h>
 #include <modules/animation/datastructures/animationtime.h>
 #include <modules/animation/datastructures/animationstate.h>
 #include <modules/animation/animationcontrollerobserver.h>
 
+#include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/directoryproperty.h>
@@ -48,6 +51,8 @@
 #include <inviwo/core/properties/stringproperty.h>
 #include <inviwo/core/properties/minmaxproperty.h>
 
+#include <unordered_set>
+
 namespace inviwo {
 
 namespace animation {
@@ -108,6 +113,16 @@ public:
 
     InviwoApplication* getInviwoApplication() { return app_; }
 
+    /// Time spent on each rendered frame, in milliseconds
+    struct FrameTiming {
+        double evaluate{0.0};  ///< Evaluating the animation at the frame time
+        double render{0.0};    ///< From evaluation until the next tick, i.e. network evaluation
+        double save{0.0};      ///< Saving the canvases, or handing them to the export queue
+    };
+
+    /// Returns the timings of the frames of the last, or current, rendering
+    const std::vector<FrameTiming>& getRenderTimings() const;
+
     CompositeProperty playOptions;
     OptionPropertyInt playWindowMode;
     DoubleMinMaxProperty playWindow;
@@ -124,6 +139,8 @@ public:
     StringProperty renderBaseName;
     OptionPropertyString renderImageExtension;
     IntProperty renderNumFrames;
+    BoolProperty renderPipelined;
+    IntProperty renderLookahead;
     ButtonProperty renderAction;
     ButtonProperty renderActionStop;
 
@@ -137,6 +154,9 @@ protected:
     /// Called to cleanup after rendering
     void afterRender();
 
+    /// Prefetch the files referenced by keyframes up until the given frame, in pipelined rendering
+    void prefetch(int untilFrame);
+
     /// The animation to control, non-owning reference.
     Animation* animation_;
 
@@ -175,14 +195,27 @@ protected:
         Seconds lastTime{0};
         int numFrames{0};
         int currentFrame{0};
+        /// Number of frames saved so far, the frames 0 to savedFrames - 1
+        int savedFrames{0};
         int digits{0};
         std::string baseFileName;
         std::vector<RenderCanvasSize> origCanvasSettings;
         std::string canvasIndicator;
+        /// Animation time of each frame, computed up front
+        std::vector<Seconds> frameTimes;
+        /// Last frame whose keyframes have been prefetched
+        int prefetchedFrame{-1};
+        std::unordered_set<std::string> prefetchedFiles;
+        std::vector<FrameTiming> timings;
+        Clock renderClock;
+        Clock totalClock;
     };
 
     /// State needed during rendering
     RenderState renderState_;
+
+    /// Encodes and writes the rendered frames in the background while rendering
+    std::unique_ptr<util::LayerExportQueue> exportQueue_;
 };
 
 }  // namespace animation
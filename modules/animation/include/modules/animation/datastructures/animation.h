@@ -63,8 +63,25 @@ public:
     Animation(const Animation&) = delete;
     Animation& operator=(const Animation& that) = delete;
 
+    /**
+     * Evaluate the tracks, in priority order, for a step from 'from' to 'to'. Only the tracks
+     * with a KeyframeSequence overlapping the interval between 'from' and 'to' are evaluated,
+     * tracks without any can not change anything and are skipped.
+     */
     AnimationTimeState operator()(Seconds from, Seconds to, AnimationState state) const;
 
+    /**
+     * Counters of the work done by operator(), accumulated until resetCounters() is called.
+     */
+    struct Counters {
+        size_t tracksEvaluated{0};  ///< Tracks with a sequence in the evaluated interval
+        size_t tracksSkipped{0};    ///< Tracks without any sequence in the evaluated interval
+        size_t updatesApplied{0};   ///< Property updates that changed the value
+        size_t updatesSkipped{0};   ///< Property updates skipped since the value was unchanged
+    };
+    Counters getCounters() const;
+    void resetCounters();
+
     bool empty() const;
     size_t size() const;
     Track& operator[](size_t i);
@@ -140,9 +157,34 @@ private:
 
     virtual void onFirstMoved(Track* t) override;
     virtual void onLastMoved(Track* t) override;
+    virtual void onKeyframeSequenceAdded(Track* t, KeyframeSequence* s) override;
+    virtual void onKeyframeSequenceRemoved(Track* t, KeyframeSequence* s) override;
+    virtual void onKeyframeSequenceChanged(Track* t, KeyframeSequence* s) override;
+    virtual void onEnabledChanged(Track* t) override;
+
+    /**
+     * Time spans of the sequences of all enabled tracks, sorted by first time. The spans form an
+     * implicit binary tree where the node of the range [l, r) is at its midpoint, and maxLast
+     * holds the largest last time within the range of each node.
+     */
+    struct SequenceIndex {
+        std::vector<Seconds> first;
+        std::vector<Seconds> last;
+        std::vector<Seconds> maxLast;
+        std::vector<size_t> track;  ///< Index into priorityTracks_
+        bool valid{false};
+    };
+    void buildIndex() const;
+    /**
+     * Append the indices into priorityTracks_ of the tracks with a sequence overlapping the
+     * interval between from and to, in priority order.
+     */
+    void findActive(Seconds from, Seconds to, std::vector<size_t>& result) const;
 
     std::vector<std::unique_ptr<Track>> tracks_;
     std::vector<Track*> priorityTracks_;
+    mutable SequenceIndex index_;
+    mutable Counters counters_;
 };
 
 }  // namespace animation
@@ -102,6 +102,8 @@ public:
     virtual void deserialize(Deserializer& d) override;
 
 protected:
+    virtual void onKeyframeAdded(Keyframe* key, KeyframeSequence* seq) override;
+    virtual void onKeyframeRemoved(Keyframe* key, KeyframeSequence* seq) override;
     virtual void onKeyframeSequenceMoved(KeyframeSequence* seq) override;
     void addToClosestSequence(std::unique_ptr<key_type> key);
 
@@ -392,6 +394,16 @@ std::unique_ptr<KeyframeSequence> BaseTrack<Seq>::remove(KeyframeSequence* seq)
     }
 }
 
+template <typename Seq>
+void BaseTrack<Seq>::onKeyframeAdded(Keyframe*, KeyframeSequence* seq) {
+    this->notifyKeyframeSequenceChanged(this, seq);
+}
+
+template <typename Seq>
+void BaseTrack<Seq>::onKeyframeRemoved(Keyframe*, KeyframeSequence* seq) {
+    this->notifyKeyframeSequenceChanged(this, seq);
+}
+
 template <typename Seq>
 void BaseTrack<Seq>::onKeyframeSequenceMoved(KeyframeSequence* seq) {
     const bool atFront = sequences_.front().get() == seq;
@@ -409,6 +421,7 @@ void BaseTrack<Seq>::onKeyframeSequenceMoved(KeyframeSequence* seq) {
     if (atBack || sequences_.back().get() == seq) {
         this->notifyLastMoved(this);
     }
+    this->notifyKeyframeSequenceChanged(this, seq);
 }
 
 template <typename Seq>
@@ -189,6 +189,20 @@ public:
 
     virtual void setOtherProperty(Property*, Keyframe*){};            // Should this be pure virtual
     virtual void updateKeyframeFromProperty(Property*, Keyframe*){};  // Should this be pure
+
+    /**
+     * Number of property updates done when evaluating the track. Updates where the property
+     * already had the value are skipped, to not trigger links and invalidations.
+     */
+    struct UpdateCounters {
+        size_t applied{0};
+        size_t skipped{0};
+    };
+    const UpdateCounters& getUpdateCounters() const { return counters_; }
+    void resetUpdateCounters() { counters_ = UpdateCounters{}; }
+
+protected:
+    mutable UpdateCounters counters_;
 };
 
 /** \class PropertyTrack
@@ -273,6 +287,9 @@ public:
     }
 
 private:
+    /// Set the property to value unless it already has that value
+    void update(const typename Key::value_type& value) const;
+
     Prop* property_;  ///< non-owning reference
 };
 
@@ -360,20 +377,20 @@ AnimationTimeState PropertyTrack<Prop, Key>::operator()(Seconds from, Seconds to
 
     if (it == this->begin()) {
         if (from > it->getFirstTime()) {  // case 1
-            property_->set(it->getFirst().getValue());
+            update(it->getFirst().getValue());
         }
     } else {  // case 2
         auto& seq1 = *std::prev(it);
 
         if (to < seq1.getLastTime()) {  // case 2a
-            property_->set(seq1(from, to));
+            update(seq1(from, to));
         } else {  // case 2b
             if (from < seq1.getLastTime()) {
                 // We came from before the previous key
-                property_->set(seq1.getLast().getValue());
+                update(seq1.getLast().getValue());
             } else if (it != this->end() && from > it->getFirstTime()) {
                 // We came form after the next key
-                property_->set(it->getFirst().getValue());
+                update(it->getFirst().getValue());
             }
             // we moved in an unmarked region, do nothing.
         }
@@ -381,6 +398,16 @@ AnimationTimeState PropertyTrack<Prop, Key>::operator()(Seconds from, Seconds to
     return {to, state};
 }
 
+template <typename Prop, typename Key>
+void PropertyTrack<Prop, Key>::update(const typename Key::value_type& value) const {
+    if (property_->get() == value) {
+        ++this->counters_.skipped;
+    } else {
+        ++this->counters_.applied;
+        property_->set(value);
+    }
+}
+
 template <typename Prop, typename Key>
 void PropertyTrack<Prop, Key>::addKeyFrameUsingPropertyValue(
     const Property* property, Seconds time, std::unique_ptr<Interpolation> interpolation) {
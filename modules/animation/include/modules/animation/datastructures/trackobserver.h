@@ -48,6 +48,11 @@ public:
 
     virtual void onFirstMoved(Track*){};
     virtual void onLastMoved(Track*){};
+    /**
+     * Called when the time span of a sequence might have changed, i.e. when a keyframe was added,
+     * removed, or moved in the sequence.
+     */
+    virtual void onKeyframeSequenceChanged(Track*, KeyframeSequence*){};
 
     virtual void onEnabledChanged(Track*){};
     virtual void onIdentifierChanged(Track*){};
@@ -62,6 +67,7 @@ protected:
 
     void notifyFirstMoved(Track* t);
     void notifyLastMoved(Track* t);
+    void notifyKeyframeSequenceChanged(Track* t, KeyframeSequence* s);
 
     void notifyEnabledChanged(Track* t);
     void notifyIdentifierChanged(Track* t);
@@ -30,17 +30,41 @@
 #include <modules/animation/animationcontroller.h>
 #include <modules/animation/animationcontrollerobserver.h>
 #include <modules/animation/datastructures/controltrack.h>
+#include <modules/animation/datastructures/propertytrack.h>
 #include <inviwo/core/io/datawriterfactory.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/processors/canvasprocessor.h>
+#include <inviwo/core/properties/fileproperty.h>
+#include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <algorithm>
+#include <limits>
+
+#include <fmt/format.h>
+
 namespace inviwo {
 
 namespace animation {
 
+namespace {
+
+/**
+ * Read the file in the background so that it is in the OS file cache when a reader asks for it
+ */
+void prefetchFile(const std::string& path) {
+    dispatchPool([path]() {
+        auto in = filesystem::ifstream(path, std::ios::in | std::ios::binary);
+        std::vector<char> chunk(1 << 20);
+        while (in.read(chunk.data(), chunk.size())) {
+        }
+    });
+}
+
+}  // namespace
+
 AnimationController::AnimationController(Animation& animation, InviwoApplication* app)
     : playOptions("PlayOptions", "Play Settings")
     , playWindowMode("PlayFirstLastTimeOption", "Time",
@@ -93,6 +117,9 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
           }())
     , renderNumFrames("RenderNumFrames", "# Frames", 100, 2, 1000000, 1,
                       InvalidationLevel::InvalidOutput, PropertySemantics::Text)
+    , renderPipelined("RenderPipelined", "Pipelined", true)
+    , renderLookahead("RenderLookahead", "Lookahead Frames", 8, 1, 1000, 1,
+                      InvalidationLevel::InvalidOutput, PropertySemantics::Text)
     , renderAction("RenderAction", "Render")
     , renderActionStop("RenderActionStop", "Stop")
     , controlOptions("ControlOptions", "Control Track")
@@ -143,6 +170,9 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
     renderOptions.addProperty(renderAspectRatio);
     renderOptions.addProperty(renderSize);
     renderOptions.addProperty(renderNumFrames);
+    renderOptions.addProperty(renderPipelined);
+    renderOptions.addProperty(renderLookahead);
+    renderLookahead.visibilityDependsOn(renderPipelined, [](const auto& p) { return p.get(); });
     renderOptions.addProperty(renderLocation);
     renderOptions.addProperty(renderBaseName);
     renderOptions.addProperty(renderImageExtension);
@@ -224,6 +254,7 @@ void AnimationController::render() {
     renderState_.numFrames = renderNumFrames.get();
     if (renderState_.numFrames < 2) renderState_.numFrames = 2;
     renderState_.currentFrame = -1;  // first run, see below in tickRender()
+    renderState_.savedFrames = 0;
     renderState_.baseFileName = renderLocation.get() + "/" + renderBaseName.get();
     // - digits of the frame counter
     renderState_.digits = 0;
@@ -236,6 +267,19 @@ void AnimationController::render() {
     // less frames
     renderState_.digits = std::max(renderState_.digits, 4);
 
+    // Frame times, we render with equidistant steps
+    renderState_.frameTimes.resize(renderState_.numFrames);
+    for (int i = 0; i < renderState_.numFrames; ++i) {
+        const double progress = double(i) / double(renderState_.numFrames - 1);
+        renderState_.frameTimes[i] =
+            renderState_.firstTime + progress * (renderState_.lastTime - renderState_.firstTime);
+    }
+    renderState_.prefetchedFrame = -1;
+    renderState_.prefetchedFiles.clear();
+    renderState_.timings.assign(renderState_.numFrames, FrameTiming{});
+    renderState_.totalClock.reset();
+    renderState_.totalClock.start();
+
     // Get all active canvases
     auto network = app_->getProcessorNetwork();
     NetworkLock lock(network);
@@ -315,6 +359,34 @@ void AnimationController::afterRender() {
     renderActionStop.setVisible(false);
     renderAction.setVisible(true);
 
+    // Wait for the remaining frames to be written
+    exportQueue_.reset();
+
+    // Report timings of the saved frames, a frame that was evaluated but not saved when rendering
+    // is stopped is not included
+    const auto saved = static_cast<size_t>(
+        std::clamp(renderState_.savedFrames, 0, static_cast<int>(renderState_.timings.size())));
+    if (saved > 0) {
+        const auto total = renderState_.totalClock.getElapsedSeconds();
+        FrameTiming sum{};
+        FrameTiming max{};
+        for (size_t i = 0; i < saved; ++i) {
+            const auto& t = renderState_.timings[i];
+            sum.evaluate += t.evaluate;
+            sum.render += t.render;
+            sum.save += t.save;
+            max.evaluate = std::max(max.evaluate, t.evaluate);
+            max.render = std::max(max.render, t.render);
+            max.save = std::max(max.save, t.save);
+        }
+        const auto n = static_cast<double>(saved);
+        LogInfo(fmt::format(
+            "Rendered {} frames in {:.2f} s ({:.1f} fps). Per frame mean/max: evaluate "
+            "{:.1f}/{:.1f} ms, render {:.1f}/{:.1f} ms, save {:.1f}/{:.1f} ms",
+            saved, total, n / total, sum.evaluate / n, max.evaluate, sum.render / n, max.render,
+            sum.save / n, max.save));
+    }
+
     // Restore original state of Canvases
     auto network = app_->getProcessorNetwork();
     NetworkLock lock(network);
@@ -420,13 +492,26 @@ void AnimationController::tickRender() {
     // system to a proper state
     // - generate filename pattern
     if (renderState_.currentFrame >= 0) {
+        auto& timing = renderState_.timings[renderState_.currentFrame];
+        timing.render = renderState_.renderClock.getElapsedMilliseconds();
+        Clock saveClock;
+
         std::stringstream fileNamePattern;
         fileNamePattern << renderBaseName.get() << renderState_.canvasIndicator << std::setfill('0')
                         << std::setw(renderState_.digits) << renderState_.currentFrame;
         auto ext = FileExtension::createFileExtensionFromString(renderImageExtension.get());
-        // - save active canvases
-        util::saveAllCanvases(app_->getProcessorNetwork(), renderLocation.get(),
-                              fileNamePattern.str(), ext.extension_, true);
+        // - save active canvases, when pipelined encoding and writing overlaps with rendering the
+        // next frames
+        if (renderPipelined.get()) {
+            if (!exportQueue_) exportQueue_ = std::make_unique<util::LayerExportQueue>();
+            util::saveAllCanvases(app_->getProcessorNetwork(), renderLocation.get(),
+                                  fileNamePattern.str(), ext.extension_, true, *exportQueue_);
+        } else {
+            util::saveAllCanvases(app_->getProcessorNetwork(), renderLocation.get(),
+                                  fileNamePattern.str(), ext.extension_, true);
+        }
+        timing.save = saveClock.getElapsedMilliseconds();
+        renderState_.savedFrames = renderState_.currentFrame + 1;
     }
 
     // Next!
@@ -438,16 +523,53 @@ void AnimationController::tickRender() {
         return;
     }
 
-    // We render with equidistant steps
-    Seconds newTime = renderState_.firstTime;
-    if (renderState_.currentFrame >= 0) {
-        const double progress =
-            double(renderState_.currentFrame) / double(renderState_.numFrames - 1);
-        newTime += progress * (renderState_.lastTime - renderState_.firstTime);
-    }
+    // Start loading the data of the upcoming frames while this one renders
+    if (renderPipelined.get()) prefetch(renderState_.currentFrame + renderLookahead.get());
 
     // Evaluate animation
-    eval(currentTime_, newTime);
+    const auto frame = renderState_.currentFrame;
+    Clock evalClock;
+    eval(currentTime_, renderState_.frameTimes[frame]);
+    renderState_.timings[frame].evaluate = evalClock.getElapsedMilliseconds();
+
+    renderState_.renderClock.reset();
+    renderState_.renderClock.start();
+}
+
+void AnimationController::prefetch(int untilFrame) {
+    untilFrame = std::min(untilFrame, renderState_.numFrames - 1);
+    if (untilFrame <= renderState_.prefetchedFrame) return;
+
+    // Keyframes from the last prefetched frame, exclusive, until the new one, inclusive.
+    // Everything before the first frame is included since it defines the initial values.
+    const auto from = renderState_.prefetchedFrame >= 0
+                          ? renderState_.frameTimes[renderState_.prefetchedFrame]
+                          : Seconds{std::numeric_limits<double>::lowest()};
+    const auto to = renderState_.frameTimes[untilFrame];
+    renderState_.prefetchedFrame = untilFrame;
+
+    using FileTrack = PropertyTrack<FileProperty, ValueKeyframe<std::string>>;
+    for (const auto& track : *animation_) {
+        const auto fileTrack = dynamic_cast<const FileTrack*>(&track);
+        if (!fileTrack || !fileTrack->isEnabled()) continue;
+
+        for (size_t i = 0; i < fileTrack->size(); ++i) {
+            const auto& seq = (*fileTrack)[i];
+            if (seq.getLastTime() <= from || seq.getFirstTime() > to) continue;
+            for (size_t j = 0; j < seq.size(); ++j) {
+                const auto& key = seq[j];
+                if (key.getTime() <= from || key.getTime() > to) continue;
+                const auto& path = key.getValue();
+                if (path.empty() || !filesystem::fileExists(path)) continue;
+                if (renderState_.prefetchedFiles.insert(path).second) prefetchFile(path);
+            }
+        }
+    }
+}
+
+const std::vector<AnimationController::FrameTiming>& AnimationController::getRenderTimings()
+    const {
+    return renderState_.timings;
 }
 
 void AnimationController::eval(Seconds oldTime, Seconds newTime) {
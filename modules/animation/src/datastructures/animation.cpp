@@ -28,6 +28,9 @@
  *********************************************************************************/
 
 #include <modules/animation/datastructures/animation.h>
+#include <modules/animation/datastructures/propertytrack.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
@@ -35,14 +38,127 @@ namespace animation {
 
 Animation::Animation() = default;
 
+namespace {
+
+void buildMaxLast(const std::vector<Seconds>& last, std::vector<Seconds>& maxLast, size_t l,
+                  size_t r) {
+    if (l >= r) return;
+    const auto mid = l + (r - l) / 2;
+    buildMaxLast(last, maxLast, l, mid);
+    buildMaxLast(last, maxLast, mid + 1, r);
+    auto max = last[mid];
+    if (l < mid) max = std::max(max, maxLast[l + (mid - l) / 2]);
+    if (mid + 1 < r) max = std::max(max, maxLast[mid + 1 + (r - mid - 1) / 2]);
+    maxLast[mid] = max;
+}
+
+template <typename Index, typename Callback>
+void queryOverlap(const Index& index, Seconds lo, Seconds hi, size_t l, size_t r, Callback& cb) {
+    if (l >= r) return;
+    const auto mid = l + (r - l) / 2;
+    if (index.maxLast[mid] < lo) return;  // Everything in [l, r) ends before lo
+    queryOverlap(index, lo, hi, l, mid, cb);
+    if (index.first[mid] > hi) return;  // Everything in [mid, r) starts after hi
+    if (index.last[mid] >= lo) cb(index.track[mid]);
+    queryOverlap(index, lo, hi, mid + 1, r, cb);
+}
+
+}  // namespace
+
 AnimationTimeState Animation::operator()(Seconds from, Seconds to, AnimationState state) const {
+    if (!index_.valid) buildIndex();
+
+    std::vector<size_t> active;
+    findActive(from, to, active);
+
     AnimationTimeState ts{to, state};
-    for (const auto& track : priorityTracks_) {
-        ts = (*track)(from, ts.time, ts.state);
+    size_t evaluated = 0;
+    size_t i = 0;
+    while (i < active.size()) {
+        const auto current = active[i];
+        const auto time = ts.time;
+        ts = (*priorityTracks_[current])(from, ts.time, ts.state);
+        ++evaluated;
+
+        if (ts.time != time) {
+            // The time was changed, i.e. by a control track. Find the remaining tracks that are
+            // active in the new interval.
+            active.clear();
+            findActive(from, ts.time, active);
+            active.erase(active.begin(), std::upper_bound(active.begin(), active.end(), current));
+            i = 0;
+        } else {
+            ++i;
+        }
     }
+    counters_.tracksEvaluated += evaluated;
+    counters_.tracksSkipped += priorityTracks_.size() - evaluated;
+
     return ts;
 }
 
+auto Animation::getCounters() const -> Counters {
+    auto counters = counters_;
+    for (const auto& track : tracks_) {
+        if (auto propertyTrack = dynamic_cast<const BasePropertyTrack*>(track.get())) {
+            counters.updatesApplied += propertyTrack->getUpdateCounters().applied;
+            counters.updatesSkipped += propertyTrack->getUpdateCounters().skipped;
+        }
+    }
+    return counters;
+}
+
+void Animation::resetCounters() {
+    counters_ = Counters{};
+    for (auto& track : tracks_) {
+        if (auto propertyTrack = dynamic_cast<BasePropertyTrack*>(track.get())) {
+            propertyTrack->resetUpdateCounters();
+        }
+    }
+}
+
+void Animation::buildIndex() const {
+    struct Span {
+        Seconds first;
+        Seconds last;
+        size_t track;
+    };
+    std::vector<Span> spans;
+    for (size_t i = 0; i < priorityTracks_.size(); ++i) {
+        const auto& track = *priorityTracks_[i];
+        if (!track.isEnabled()) continue;
+        for (size_t j = 0; j < track.size(); ++j) {
+            const auto& seq = track[j];
+            if (seq.size() == 0) continue;
+            spans.push_back({seq.getFirstTime(), seq.getLastTime(), i});
+        }
+    }
+    std::sort(spans.begin(), spans.end(),
+              [](const Span& a, const Span& b) { return a.first < b.first; });
+
+    index_.first.resize(spans.size());
+    index_.last.resize(spans.size());
+    index_.track.resize(spans.size());
+    index_.maxLast.resize(spans.size());
+    for (size_t i = 0; i < spans.size(); ++i) {
+        index_.first[i] = spans[i].first;
+        index_.last[i] = spans[i].last;
+        index_.track[i] = spans[i].track;
+    }
+    buildMaxLast(index_.last, index_.maxLast, 0, spans.size());
+    index_.valid = true;
+}
+
+void Animation::findActive(Seconds from, Seconds to, std::vector<size_t>& result) const {
+    const auto begin = result.size();
+    auto add = [&](size_t track) { result.push_back(track); };
+    queryOverlap(index_, std::min(from, to), std::max(from, to), 0, index_.first.size(), add);
+
+    // A track might have several overlapping sequences, return each track once in priority order
+    std::sort(result.begin() + begin, result.end());
+    result.erase(std::unique(result.begin() + begin, result.end()), result.end());
+}
+
 bool Animation::empty() const { return tracks_.empty(); }
 
 size_t Animation::size() const { return tracks_.size(); }
@@ -75,6 +191,7 @@ std::unique_ptr<Track> Animation::remove(size_t i) {
     auto track = std::move(tracks_[i]);
     tracks_.erase(tracks_.begin() + i);
     util::erase_remove(priorityTracks_, track.get());
+    index_.valid = false;
     notifyTrackRemoved(track.get());
     return track;
 }
@@ -163,11 +280,26 @@ void Animation::doPrioritySort() {
     std::stable_sort(
         priorityTracks_.begin(), priorityTracks_.end(),
         [](const auto& a, const auto& b) { return a->getPriority() > b->getPriority(); });
+    index_.valid = false;
+}
+
+void Animation::onFirstMoved(Track*) {
+    index_.valid = false;
+    notifyFirstMoved();
 }
 
-void Animation::onFirstMoved(Track*) { notifyFirstMoved(); }
+void Animation::onLastMoved(Track*) {
+    index_.valid = false;
+    notifyLastMoved();
+}
+
+void Animation::onKeyframeSequenceAdded(Track*, KeyframeSequence*) { index_.valid = false; }
+
+void Animation::onKeyframeSequenceRemoved(Track*, KeyframeSequence*) { index_.valid = false; }
+
+void Animation::onKeyframeSequenceChanged(Track*, KeyframeSequence*) { index_.valid = false; }
 
-void Animation::onLastMoved(Track*) { notifyLastMoved(); }
+void Animation::onEnabledChanged(Track*) { index_.valid = false; }
 
 }  // namespace animation
 
@@ -51,6 +51,10 @@ void TrackObservable::notifyLastMoved(Track* t) {
     forEachObserver([&](TrackObserver* o) { o->onLastMoved(t); });
 }
 
+void TrackObservable::notifyKeyframeSequenceChanged(Track* t, KeyframeSequence* s) {
+    forEachObserver([&](TrackObserver* o) { o->onKeyframeSequenceChanged(t, s); });
+}
+
 void TrackObservable::notifyEnabledChanged(Track* t) {
     forEachObserver([&](TrackObserver* o) { o->onEnabledChanged(t); });
 }
@@ -195,6 +195,59 @@ TEST(AnimationTests, AnimationTest) {
     EXPECT_EQ(dvec3(0.5), doubleProperty.get());
 }
 
+TEST(AnimationTests, SkipInactiveTracks) {
+    FloatProperty first("first", "First", 0.0f, 0.0f, 100.0f);
+    FloatProperty second("second", "Second", 0.0f, 0.0f, 100.0f);
+
+    auto makeTrack = [](FloatProperty& property, std::vector<std::pair<double, float>> keys) {
+        std::vector<std::unique_ptr<ValueKeyframe<float>>> seq;
+        for (auto [time, value] : keys) {
+            seq.push_back(std::make_unique<ValueKeyframe<float>>(Seconds{time}, value));
+        }
+        auto track =
+            std::make_unique<PropertyTrack<FloatProperty, ValueKeyframe<float>>>(&property);
+        track->add(std::make_unique<KeyframeSequenceTyped<ValueKeyframe<float>>>(
+            std::move(seq), std::make_unique<LinearInterpolation<ValueKeyframe<float>>>()));
+        return track;
+    };
+
+    Animation animation;
+    animation.add(makeTrack(first, {{1.0, 0.0f}, {2.0, 1.0f}, {3.0, 0.0f}}));
+    animation.add(makeTrack(second, {{10.0, 0.0f}, {12.0, 2.0f}}));
+
+    animation(Seconds{0.0}, Seconds{1.5}, AnimationState::Playing);
+    EXPECT_EQ(0.5f, first.get());
+    EXPECT_EQ(0.0f, second.get());
+    EXPECT_EQ(1u, animation.getCounters().tracksEvaluated);
+    EXPECT_EQ(1u, animation.getCounters().tracksSkipped);
+    EXPECT_EQ(1u, animation.getCounters().updatesApplied);
+
+    // Same value, the property should not be set again
+    animation(Seconds{1.5}, Seconds{1.5}, AnimationState::Playing);
+    EXPECT_EQ(1u, animation.getCounters().updatesApplied);
+    EXPECT_EQ(1u, animation.getCounters().updatesSkipped);
+
+    // Passing the end of the first sequence and into the second
+    animation(Seconds{1.5}, Seconds{11.0}, AnimationState::Playing);
+    EXPECT_EQ(0.0f, first.get());
+    EXPECT_EQ(1.0f, second.get());
+    EXPECT_EQ(4u, animation.getCounters().tracksEvaluated);
+    EXPECT_EQ(2u, animation.getCounters().tracksSkipped);
+    EXPECT_EQ(3u, animation.getCounters().updatesApplied);
+
+    // Moving the last keyframe of the first sequence should update the index
+    animation[0][0][2].setTime(Seconds{20.0});
+    animation(Seconds{11.0}, Seconds{11.5}, AnimationState::Playing);
+    EXPECT_EQ(2u, animation.getCounters().tracksEvaluated - 4);
+
+    animation[1].setEnabled(false);
+    animation.resetCounters();
+    animation(Seconds{11.5}, Seconds{11.75}, AnimationState::Playing);
+    EXPECT_EQ(1.5f, second.get());
+    EXPECT_EQ(1u, animation.getCounters().tracksEvaluated);
+    EXPECT_EQ(1u, animation.getCounters().tracksSkipped);
+}
+
 TEST(AnimationTests, KeyframeSerializationTest) {
     ValueKeyframe<dvec3> keyframe{Seconds{4.0}, dvec3(2.0)};
 
@@ -0,0 +1,114 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace detail {
+
+/**
+ * The type used for intermediate distances when computing a distance field of type U. Formats
+ * with less precision than float, like half, are computed in float and converted at the end.
+ */
+template <typename U>
+using DistanceTransformType = std::conditional_t<std::is_same_v<U, double>, double, float>;
+
+/**
+ * Stop token for distance transforms that can not be canceled.
+ */
+struct NoStop {
+    operator bool() const noexcept { return false; }
+};
+
+/**
+ * Calculates the squared distance transform of a sampled function f in linear time using the lower
+ * envelope of parabolas: d(p) = min_q(f(q) + w * (p - q)^2).
+ *  P. Felzenszwalb and D. Huttenlocher. Distance Transforms of Sampled Functions.
+ *  Theory of Computing, 8(19), pp. 415-428, 2012.
+ *
+ * @param f input values, of size n. Has to be finite.
+ * @param d output values, of size n. Can not be the same as f.
+ * @param n number of samples
+ * @param w squared distance between two samples
+ * @param v scratch buffer, will be resized to n
+ * @param z scratch buffer, will be resized to n + 1
+ */
+template <typename U>
+void distanceTransform1D(const U* f, U* d, std::ptrdiff_t n, U w, std::vector<std::ptrdiff_t>& v,
+                         std::vector<U>& z) {
+    if (n <= 0) return;
+    v.resize(n);
+    z.resize(n + 1);
+
+    const auto intersect = [&](std::ptrdiff_t q, std::ptrdiff_t r) {
+        const auto uq = static_cast<U>(q);
+        const auto ur = static_cast<U>(r);
+        return ((f[q] + w * uq * uq) - (f[r] + w * ur * ur)) / (U(2) * w * (uq - ur));
+    };
+
+    std::ptrdiff_t k = 0;
+    v[0] = 0;
+    z[0] = std::numeric_limits<U>::lowest();
+    z[1] = std::numeric_limits<U>::max();
+    for (std::ptrdiff_t q = 1; q < n; ++q) {
+        auto s = intersect(q, v[k]);
+        while (k > 0 && s <= z[k]) {
+            --k;
+            s = intersect(q, v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = std::numeric_limits<U>::max();
+    }
+
+    k = 0;
+    for (std::ptrdiff_t p = 0; p < n; ++p) {
+        while (z[k + 1] < static_cast<U>(p)) ++k;
+        const auto dist = static_cast<U>(p - v[k]);
+        d[p] = w * dist * dist + f[v[k]];
+    }
+}
+
+}  // namespace detail
+
+}  // namespace util
+
+}  // namespace inviwo
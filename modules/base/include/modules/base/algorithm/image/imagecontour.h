@@ -36,104 +36,180 @@
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
 #include <inviwo/core/datastructures/image/layerrepresentation.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
-#include <inviwo/core/util/indexmapper.h>
-#include <inviwo/core/util/interpolation.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <vector>
 
 namespace inviwo {
 
+/**
+ * Marching squares on a layer. The cells are processed in blocks of rows on the thread pool and
+ * the resulting line segments are joined into connected polylines. Each polyline is added as a
+ * separate index buffer of type DrawType::Lines with ConnectivityType::Strip, or
+ * ConnectivityType::Loop for closed contours. The vertices are shared between adjacent segments
+ * and lie in [0,1]^2.
+ */
 class IVW_MODULE_BASE_API ImageContour {
 public:
+    /**
+     * Extract the contour of `isoValue` in channel `channel`. For integer formats the iso value
+     * is given in normalized [0,1] units.
+     */
     static std::shared_ptr<Mesh> apply(const LayerRepresentation* in, size_t channel,
                                        double isoValue, vec4 color = vec4(1.0));
+
+    /**
+     * Extract the contours of all `isoValues` in one pass over the layer. `colors` should either
+     * have one color per iso value or a single color used for all of them.
+     */
+    static std::shared_ptr<Mesh> apply(const LayerRepresentation* in, size_t channel,
+                                       const std::vector<double>& isoValues,
+                                       const std::vector<vec4>& colors);
 };
 
 namespace detail {
+
+/**
+ * A point on a cell edge. The edge is identified by 2 * (index of its first grid point), plus one
+ * if the edge goes along y. `t` is the position along the edge.
+ */
+struct ContourPoint {
+    size_t edge;
+    float t;
+};
+using ContourSegment = std::array<ContourPoint, 2>;
+
+/**
+ * Create a mesh of connected polylines from marching squares segments, one list of segments per
+ * iso value.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> assembleContours(
+    size2_t dim, const std::vector<std::vector<ContourSegment>>& segments,
+    const std::vector<vec4>& colors);
+
+/**
+ * Run marching squares for all iso values over blocks of rows in parallel. The segments of each
+ * iso value are returned in row order.
+ */
+template <typename T>
+std::vector<std::vector<ContourSegment>> marchingSquares(const LayerRAMPrecision<T>& layer,
+                                                         size_t channel,
+                                                         const std::vector<double>& isoValues) {
+    // Pairs of corners defining the edges the segments go between,
+    // corners: 0: (x,y), 1: (x+1,y), 2: (x+1,y+1), 3: (x,y+1)
+    static constexpr std::array<std::array<int, 8>, 9> caseTable = {{
+        {{}},                        // case 0
+        {{0, 1, 0, 3}},              // case 1
+        {{0, 1, 1, 2}},              // case 2
+        {{0, 3, 1, 2}},              // case 3
+        {{2, 3, 2, 1}},              // case 4
+        {{0, 3, 3, 2, 2, 1, 1, 0}},  // case 5
+        {{0, 1, 2, 3}},              // case 6
+        {{0, 3, 3, 2}},              // case 7
+        {{0, 3, 0, 1, 1, 2, 2, 3}}   // case 8, the other saddle
+    }};
+    static constexpr std::array<size_t, 9> caseSize = {0, 4, 4, 4, 4, 8, 4, 4, 8};
+
+    const auto dim = layer.getDimensions();
+    std::vector<std::vector<ContourSegment>> segments(isoValues.size());
+    if (dim.x < 2 || dim.y < 2 || isoValues.empty()) return segments;
+
+    channel = std::min(channel, util::extent<T>::value - 1);
+    const T* data = layer.getDataTyped();
+
+    std::mutex mutex;
+    std::map<size_t, std::vector<std::vector<ContourSegment>>> blocks;
+
+    util::forEachRangeParallel(dim.y - 1, [&](size_t first, size_t last) {
+        std::vector<std::vector<ContourSegment>> block(isoValues.size());
+        std::array<size_t, 4> ind;
+        std::array<double, 4> vals;
+
+        const auto point = [&](int a, int b, double isoValue) {
+            if (ind[a] > ind[b]) std::swap(a, b);
+            const bool alongY = ind[b] - ind[a] != 1;
+            const auto t = (isoValue - vals[a]) / (vals[b] - vals[a]);
+            return ContourPoint{2 * ind[a] + (alongY ? 1 : 0), static_cast<float>(t)};
+        };
+
+        for (size_t y = first; y < last; ++y) {
+            for (size_t x = 0; x < dim.x - 1; ++x) {
+                ind[0] = x + y * dim.x;
+                ind[1] = ind[0] + 1;
+                ind[2] = ind[0] + 1 + dim.x;
+                ind[3] = ind[0] + dim.x;
+                for (size_t i = 0; i < 4; ++i) {
+                    vals[i] = util::glm_convert<double>(util::glmcomp(data[ind[i]], channel));
+                }
+
+                for (size_t iso = 0; iso < isoValues.size(); ++iso) {
+                    const auto isoValue = isoValues[iso];
+                    int theCase = 0;
+                    theCase += vals[0] < isoValue ? 0 : 1;
+                    theCase += vals[1] < isoValue ? 0 : 2;
+                    theCase += vals[2] < isoValue ? 0 : 4;
+                    theCase += vals[3] < isoValue ? 0 : 8;
+
+                    if (theCase == 0 || theCase == 15) {
+                        continue;
+                    } else if (theCase == 5 || theCase == 10) {
+                        const auto m = (vals[0] + vals[1] + vals[2] + vals[3]) * 0.25;
+                        const bool inside = m >= isoValue;
+                        if (theCase == 5) {
+                            theCase = inside ? 5 : 8;
+                        } else {
+                            theCase = !inside ? 5 : 8;
+                        }
+                    } else if (theCase > 7) {
+                        theCase = 15 - theCase;
+                    }
+
+                    const auto& edges = caseTable[theCase];
+                    for (size_t i = 0; i < caseSize[theCase]; i += 4) {
+                        block[iso].push_back({point(edges[i], edges[i + 1], isoValue),
+                                              point(edges[i + 2], edges[i + 3], isoValue)});
+                    }
+                }
+            }
+        }
+
+        std::scoped_lock lock{mutex};
+        blocks.emplace(first, std::move(block));
+    });
+
+    for (auto& item : blocks) {
+        for (size_t iso = 0; iso < isoValues.size(); ++iso) {
+            segments[iso].insert(segments[iso].end(), item.second[iso].begin(),
+                                 item.second[iso].end());
+        }
+    }
+    return segments;
+}
+
 struct IVW_MODULE_BASE_API ImageContourDispatcher {
     using type = std::shared_ptr<Mesh>;
     template <typename Result, typename T>
-    std::shared_ptr<Mesh> operator()(const LayerRepresentation* in, size_t channel, double isoValue,
-                                     vec4 color);
+    std::shared_ptr<Mesh> operator()(const LayerRepresentation* in, size_t channel,
+                                     const std::vector<double>& isoValues,
+                                     const std::vector<vec4>& colors);
 };
 
 template <typename Result, class DataType>
 std::shared_ptr<Mesh> ImageContourDispatcher::operator()(const LayerRepresentation* in,
-                                                         size_t channel, double isoValue,
-                                                         vec4 color) {
-    static const std::vector<std::vector<int>> caseTable = {
-        std::vector<int>(),                          // case 0
-        std::vector<int>({0, 1, 0, 3}),              // case 1
-        std::vector<int>({0, 1, 1, 2}),              // case 2
-        std::vector<int>({0, 3, 1, 2}),              // case 3
-        std::vector<int>({2, 3, 2, 1}),              // case 4
-        std::vector<int>({0, 3, 3, 2, 2, 1, 1, 0}),  // case 5
-        std::vector<int>({0, 1, 2, 3}),              // case 6
-        std::vector<int>({0, 3, 3, 2}),              // case 7
-        std::vector<int>({0, 3, 0, 1, 1, 2, 2, 3})};
-
-    auto mesh = std::make_shared<BasicMesh>();
-    auto indices = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
-
+                                                         size_t channel,
+                                                         const std::vector<double>& isoValues,
+                                                         const std::vector<vec4>& colors) {
     using T = typename DataType::type;
-    channel = std::min(channel, util::extent<typename DataType::type>::value - 1);
-
     const LayerRAMPrecision<T>* ram = dynamic_cast<const LayerRAMPrecision<T>*>(in);
     if (!ram) return nullptr;
 
-    auto data = static_cast<const T*>(ram->getData());
-
-    auto dim = ram->getDimensions();
-
+    const auto dim = ram->getDimensions();
     if (dim.x == 0 || dim.y == 0) return nullptr;
 
-    double vals[4];
-    vec3 outPos[4];
-    vec3 outPosScale =
-        vec3(1.0f / static_cast<float>(dim.x - 1), 1.0f / static_cast<float>(dim.y - 1), 1);
-    util::IndexMapper2D index(dim);
-    for (size_t y = 0; y < dim.y - 1; y++) {
-        for (size_t x = 0; x < dim.x - 1; x++) {
-            auto idx = index(x, y);
-            vals[0] = util::glm_convert<double>(util::glmcomp(data[idx], channel));
-            vals[1] = util::glm_convert<double>(util::glmcomp(data[idx + 1], channel));
-            vals[2] = util::glm_convert<double>(util::glmcomp(data[idx + 1 + dim.x], channel));
-            vals[3] = util::glm_convert<double>(util::glmcomp(data[idx + dim.x], channel));
-
-            int theCase = 0;
-            theCase += vals[0] < isoValue ? 0 : 1;
-            theCase += vals[1] < isoValue ? 0 : 2;
-            theCase += vals[2] < isoValue ? 0 : 4;
-            theCase += vals[3] < isoValue ? 0 : 8;
-
-            if (theCase == 0 || theCase == 15) {
-                continue;
-            } else if (theCase == 5 || theCase == 10) {
-                auto m = (vals[0] + vals[1] + vals[2] + vals[3]) * 0.25;
-                bool inside = m >= isoValue;
-                if (theCase == 5) {
-                    theCase = inside ? 5 : 8;
-                } else {
-                    theCase = !inside ? 5 : 8;
-                }
-            } else if (theCase > 7) {
-                theCase = 15 - theCase;
-            }
-
-            outPos[0] = vec3(x, y, 0) * outPosScale;
-            outPos[1] = vec3(x + 1, y, 0) * outPosScale;
-            outPos[2] = vec3(x + 1, y + 1, 0) * outPosScale;
-            outPos[3] = vec3(x, y + 1, 0) * outPosScale;
-
-            auto& edges = caseTable[theCase];
-            for (size_t i = 0; i < edges.size(); i += 2) {
-                auto t = (isoValue - vals[edges[i]]) / (vals[edges[i + 1]] - vals[edges[i]]);
-                auto p = Interpolation<vec3, float>::linear(outPos[edges[i]], outPos[edges[i + 1]],
-                                                            static_cast<float>(t));
-                indices->add(mesh->addVertex(p, p, p, color));
-            }
-        }
-    }
-
-    return mesh;
+    return assembleContours(dim, marchingSquares(*ram, channel, isoValues), colors);
 }
 }  // namespace detail
 
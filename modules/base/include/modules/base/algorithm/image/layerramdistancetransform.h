@@ -31,45 +31,58 @@
 #define IVW_LAYERRAMDISTANCETRANSFORM_H
 
 #include <modules/base/basemoduledefine.h>
+#include <modules/base/algorithm/distancetransform.h>
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/indexmapper.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 
-#ifndef __clang__
-#include <omp.h>
-#endif
-
 namespace inviwo {
 
 namespace util {
 
 /**
- *	Implementation of Euclidean Distance Transform according to Saito's algorithm:
- *  T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance transformations
- *  of an n-dimensional digitized picture with applications. Pattern Recognition, 27(11).
- *  pp. 1551-1565, 1994.
- *  http://www.cs.jhu.edu/~misha/ReadingSeminar/Papers/Saito94.pdf
+ *	Implementation of Euclidean Distance Transform. The first pass scans along x, the second pass
+ *  along y is computed in linear time per line using the lower envelope of parabolas:
+ *  P. Felzenszwalb and D. Huttenlocher. Distance Transforms of Sampled Functions.
+ *  Theory of Computing, 8(19), pp. 415-428, 2012.
+ *  The lines of each pass are processed in parallel using the Inviwo thread pool.
  *
  * Calculates the distance in base mat space
  *     * Predicate is a function of type (const T &value) -> bool to deside if a value in the input
  *       is a "feature".
- *     * ValueTransform is a function of type (const U& squaredDist) -> U that is appiled to all
- *       squared distance values at the end of the calculation.
+ *     * ValueTransform is a function of type (const F& squaredDist) -> F that is appiled to all
+ *       squared distance values at the end of the calculation. F is double for double output and
+ *       float otherwise, i.e. a half output is calculated in float and converted at the end.
  *     * ProcessCallback is a function of type (double progress) -> void that is called with a value
- *       from 0 to 1 to indicate the progress of the calculation.
+ *       from 0 to 1 to indicate the progress of the calculation. It is only called from the calling
+ *       thread.
+ *     * Stop is a type convertible to bool, like pool::Stop, the calculation is canceled when it
+ *       evaluates to true, leaving the output incomplete.
  */
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback, typename Stop>
+void layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
+                               LayerRAMPrecision<U> *outDistanceField,
+                               const Matrix<2, detail::DistanceTransformType<U>> basis,
+                               const size2_t upsample, Predicate predicate,
+                               ValueTransform valueTransform, ProgressCallback callback,
+                               const Stop &stop);
+
 template <typename T, typename U, typename Predicate, typename ValueTransform,
           typename ProgressCallback>
 void layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
-                               LayerRAMPrecision<U> *outDistanceField, const Matrix<2, U> basis,
+                               LayerRAMPrecision<U> *outDistanceField,
+                               const Matrix<2, detail::DistanceTransformType<U>> basis,
                                const size2_t upsample, Predicate predicate,
                                ValueTransform valueTransform, ProgressCallback callback);
 
 template <typename T, typename U>
 void layerRAMDistanceTransform(const LayerRAMPrecision<T> *inVolume,
-                               LayerRAMPrecision<U> *outDistanceField, const Matrix<2, U> basis,
+                               LayerRAMPrecision<U> *outDistanceField,
+                               const Matrix<2, detail::DistanceTransformType<U>> basis,
                                const size2_t upsample);
 
 template <typename U, typename Predicate, typename ValueTransform, typename ProgressCallback>
@@ -77,6 +90,12 @@ void layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *outDista
                             const size2_t upsample, Predicate predicate,
                             ValueTransform valueTransform, ProgressCallback callback);
 
+template <typename U, typename ProgressCallback, typename Stop>
+void layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *outDistanceField,
+                            const size2_t upsample, double threshold, bool normalize, bool flip,
+                            bool square, double scale, ProgressCallback callback,
+                            const Stop &stop);
+
 template <typename U, typename ProgressCallback>
 void layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *outDistanceField,
                             const size2_t upsample, double threshold, bool normalize, bool flip,
@@ -90,18 +109,15 @@ void layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *outDista
 }  // namespace util
 
 template <typename T, typename U, typename Predicate, typename ValueTransform,
-          typename ProgressCallback>
+          typename ProgressCallback, typename Stop>
 void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
                                      LayerRAMPrecision<U> *outDistanceField,
-                                     const Matrix<2, U> basis, const size2_t upsample,
-                                     Predicate predicate, ValueTransform valueTransform,
-                                     ProgressCallback callback) {
-
-#ifndef __clang__
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
-
+                                     const Matrix<2, detail::DistanceTransformType<U>> basis,
+                                     const size2_t upsample, Predicate predicate,
+                                     ValueTransform valueTransform, ProgressCallback callback,
+                                     const Stop &stop) {
     using int64 = glm::int64;
+    using F = detail::DistanceTransformType<U>;
 
     auto square = [](auto a) { return a * a; };
 
@@ -115,9 +131,8 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
     const i64vec2 sm{upsample};
 
     const auto squareBasis = glm::transpose(basis) * basis;
-    const Vector<2, U> squareBasisDiag{squareBasis[0][0], squareBasis[1][1]};
-    const Vector<2, U> squareVoxelSize{squareBasisDiag / Vector<2, U>{dstDim * dstDim}};
-    const Vector<2, U> invSquareVoxelSize{Vector<2, U>{1.0f} / squareVoxelSize};
+    const Vector<2, F> squareBasisDiag{squareBasis[0][0], squareBasis[1][1]};
+    const Vector<2, F> squareVoxelSize{squareBasisDiag / Vector<2, F>{dstDim * dstDim}};
 
     {
         const auto maxdist = glm::compMax(squareBasisDiag);
@@ -154,85 +169,100 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
         return predicate(src[srcInd(x / sm.x, y / sm.y)]);
     };
 
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#pragma omp parallel for
-    for (int64 y = 0; y < dstDim.y; ++y) {
-        // forward
-        U dist = static_cast<U>(dstDim.x);
-        for (int64 x = 0; x < dstDim.x; ++x) {
-            if (!is_feature(x, y)) {
-                ++dist;
-            } else {
-                dist = U(0);
-            }
-            dst[dstInd(x, y)] = squareVoxelSize.x * square(dist);
-        }
+    const auto progress = [&callback](double begin, double end) {
+        return [&callback, begin, end](size_t i, size_t n) {
+            callback(begin + (end - begin) * static_cast<double>(i) / static_cast<double>(n));
+        };
+    };
 
-        // backward
-        dist = static_cast<U>(dstDim.x);
-        for (int64 x = dstDim.x - 1; x >= 0; --x) {
-            if (!is_feature(x, y)) {
-                ++dist;
-            } else {
-                dist = U(0);
-            }
-            dst[dstInd(x, y)] = std::min<U>(dst[dstInd(x, y)], squareVoxelSize.x * square(dist));
-        }
+    // The squared distances are calculated in place if the output has full precision, otherwise
+    // in a temporary buffer
+    const auto size = static_cast<size_t>(dstDim.x * dstDim.y);
+    std::vector<F> buffer;
+    F *dist = nullptr;
+    if constexpr (std::is_same_v<U, F>) {
+        dist = dst;
+    } else {
+        buffer.resize(size);
+        dist = buffer.data();
     }
 
-    // second pass, scan y direction
-    // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
-    // result: min distance in x and y direction
-    callback(0.45);
-#pragma omp parallel
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.y);
-#pragma omp for
-        for (int64 x = 0; x < dstDim.x; ++x) {
-
-            // cache column data into temporary buffer
-            for (int64 y = 0; y < dstDim.y; ++y) {
-                buff[y] = dst[dstInd(x, y)];
-            }
+    // Squared distance used for pixels in lines without any feature, larger than any real distance
+    // but finite to keep the following pass well defined.
+    const F noFeature = F(2) * glm::compAdd(squareBasisDiag);
+
+    // first pass, forward and backward scan along x
+    // result: min distance in x direction
+    util::forEachRangeParallel(
+        static_cast<size_t>(dstDim.y), stop, progress(0.0, 0.45), [&](size_t first, size_t last) {
+            for (auto y = static_cast<int64>(first); y < static_cast<int64>(last); ++y) {
+                F *row = dist + dstInd(0, y);
+
+                // forward
+                F d = std::numeric_limits<F>::infinity();
+                for (int64 x = 0; x < dstDim.x; ++x) {
+                    d = is_feature(x, y) ? F(0) : d + F(1);
+                    row[x] = std::min(squareVoxelSize.x * square(d), noFeature);
+                }
 
-            for (int64 y = 0; y < dstDim.y; ++y) {
-                auto d = buff[y];
-                if (d != U(0)) {
-                    const auto rMax = static_cast<int64>(std::sqrt(d * invSquareVoxelSize.y)) + 1;
-                    const auto rStart = std::min(rMax, y - 1);
-                    const auto rEnd = std::min(rMax, dstDim.y - y);
-                    for (int64 n = -rStart; n < rEnd; ++n) {
-                        const auto w = buff[y + n] + squareVoxelSize.y * square(n);
-                        if (w < d) d = w;
-                    }
+                // backward, features are already marked with a zero distance
+                d = std::numeric_limits<F>::infinity();
+                for (int64 x = dstDim.x - 1; x >= 0; --x) {
+                    d = row[x] == F(0) ? F(0) : d + F(1);
+                    row[x] = std::min(row[x], squareVoxelSize.x * square(d));
                 }
-                dst[dstInd(x, y)] = d;
             }
-        }
-    }
+        });
+    if (stop) return;
+
+    // second pass, scan y direction
+    // for each pixel v(x,y) find min_i(data(x,i) + (y - i)^2), 0 <= i < dimY
+    // result: min distance in x and y direction
+    util::forEachRangeParallel(
+        static_cast<size_t>(dstDim.x), stop, progress(0.45, 0.9), [&](size_t first, size_t last) {
+            std::vector<F> f(static_cast<size_t>(dstDim.y));
+            std::vector<F> d(static_cast<size_t>(dstDim.y));
+            std::vector<F> z;
+            std::vector<std::ptrdiff_t> v;
+            for (auto x = static_cast<int64>(first); x < static_cast<int64>(last); ++x) {
+                for (int64 y = 0; y < dstDim.y; ++y) f[y] = dist[dstInd(x, y)];
+                detail::distanceTransform1D(f.data(), d.data(), dstDim.y, squareVoxelSize.y, v, z);
+                for (int64 y = 0; y < dstDim.y; ++y) dist[dstInd(x, y)] = d[y];
+            }
+        });
+    if (stop) return;
 
     // scale data
-    callback(0.9);
-    const int64 layerSize = dstDim.x * dstDim.y;
-#pragma omp parallel for
-    for (int64 i = 0; i < layerSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
+    util::forEachRangeParallel(size, stop, progress(0.9, 1.0), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            dst[i] = static_cast<U>(valueTransform(dist[i]));
+        }
+    });
     callback(1.0);
 }
 
-template <typename T, typename U>
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
 void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
                                      LayerRAMPrecision<U> *outDistanceField,
-                                     const Matrix<2, U> basis, const size2_t upsample) {
+                                     const Matrix<2, detail::DistanceTransformType<U>> basis,
+                                     const size2_t upsample, Predicate predicate,
+                                     ValueTransform valueTransform, ProgressCallback callback) {
+    util::layerRAMDistanceTransform(inLayer, outDistanceField, basis, upsample, predicate,
+                                    valueTransform, callback, detail::NoStop{});
+}
 
+template <typename T, typename U>
+void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
+                                     LayerRAMPrecision<U> *outDistanceField,
+                                     const Matrix<2, detail::DistanceTransformType<U>> basis,
+                                     const size2_t upsample) {
+    using F = detail::DistanceTransformType<U>;
     util::layerRAMDistanceTransform(
         inLayer, outDistanceField, basis, upsample,
         [](const T &val) { return util::glm_convert_normalized<double>(val) > 0.5; },
-        [](const U &squareDist) {
-            return static_cast<U>(std::sqrt(static_cast<double>(squareDist)));
+        [](const F &squareDist) {
+            return static_cast<F>(std::sqrt(static_cast<double>(squareDist)));
         },
         [](double f) {});
 }
@@ -242,17 +272,20 @@ void util::layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *ou
                                   const size2_t upsample, Predicate predicate,
                                   ValueTransform valueTransform, ProgressCallback callback) {
 
+    const Matrix<2, detail::DistanceTransformType<U>> basis{inLayer->getBasis()};
     const auto inputLayerRep = inLayer->getRepresentation<LayerRAM>();
     inputLayerRep->dispatch<void, dispatching::filter::Scalars>([&](const auto lrprecision) {
-        layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(), upsample,
-                                  predicate, valueTransform, callback);
+        layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample, predicate,
+                                  valueTransform, callback);
     });
 }
 
-template <typename U, typename ProgressCallback>
+template <typename U, typename ProgressCallback, typename Stop>
 void util::layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *outDistanceField,
                                   const size2_t upsample, double threshold, bool normalize,
-                                  bool flip, bool square, double scale, ProgressCallback progress) {
+                                  bool flip, bool square, double scale, ProgressCallback progress,
+                                  const Stop &stop) {
+    using F = detail::DistanceTransformType<U>;
 
     const auto inputLayerRep = inLayer->getRepresentation<LayerRAM>();
     inputLayerRep->dispatch<void, dispatching::filter::Scalars>([&](const auto lrprecision) {
@@ -268,41 +301,51 @@ void util::layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *ou
             return util::glm_convert_normalized<double>(val) > threshold;
         };
 
-        const auto valTransIdent = [scale](const float &squareDist) {
-            return static_cast<float>(scale * squareDist);
+        const auto valTransIdent = [scale](const F &squareDist) {
+            return static_cast<F>(scale * squareDist);
         };
-        const auto valTransSqrt = [scale](const float &squareDist) {
-            return static_cast<float>(scale * std::sqrt(squareDist));
+        const auto valTransSqrt = [scale](const F &squareDist) {
+            return static_cast<F>(scale * std::sqrt(squareDist));
         };
 
+        const Matrix<2, F> basis{inLayer->getBasis()};
+
         if (normalize && square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateIn, valTransIdent, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            normPredicateIn, valTransIdent, progress, stop);
         } else if (normalize && square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateOut, valTransIdent, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            normPredicateOut, valTransIdent, progress, stop);
         } else if (normalize && !square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateIn, valTransSqrt, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            normPredicateIn, valTransSqrt, progress, stop);
         } else if (normalize && !square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, normPredicateOut, valTransSqrt, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            normPredicateOut, valTransSqrt, progress, stop);
         } else if (!normalize && square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateIn, valTransIdent, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            predicateIn, valTransIdent, progress, stop);
         } else if (!normalize && square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateOut, valTransIdent, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            predicateOut, valTransIdent, progress, stop);
         } else if (!normalize && !square && flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateIn, valTransSqrt, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            predicateIn, valTransSqrt, progress, stop);
         } else if (!normalize && !square && !flip) {
-            util::layerRAMDistanceTransform(lrprecision, outDistanceField, inLayer->getBasis(),
-                                            upsample, predicateOut, valTransSqrt, progress);
+            util::layerRAMDistanceTransform(lrprecision, outDistanceField, basis, upsample,
+                                            predicateOut, valTransSqrt, progress, stop);
         }
     });
 }
 
+template <typename U, typename ProgressCallback>
+void util::layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *outDistanceField,
+                                  const size2_t upsample, double threshold, bool normalize,
+                                  bool flip, bool square, double scale, ProgressCallback progress) {
+    util::layerDistanceTransform(inLayer, outDistanceField, upsample, threshold, normalize, flip,
+                                 square, scale, progress, detail::NoStop{});
+}
+
 template <typename U>
 void util::layerDistanceTransform(const Layer *inLayer, LayerRAMPrecision<U> *outDistanceField,
                                   const size2_t upsample, double threshold, bool normalize,
@@ -0,0 +1,76 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/formats.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Image;
+
+namespace util {
+
+/**
+ * A CPU render target with a linear rgba color buffer and a depth buffer with values in [0,1].
+ * Pixels are stored row by row with x as the fastest varying index and y = 0 as the bottom row,
+ * matching the layout of Layer. Used by the CPU rasterizer and raycaster.
+ * @see rasterizeMeshes
+ * @see raycastVolume
+ */
+struct IVW_MODULE_BASE_API RenderBufferRAM {
+    explicit RenderBufferRAM(size2_t dims, vec4 clearColor = vec4{0.0f}, float clearDepth = 1.0f);
+    /**
+     * Initialize the buffers from the first color layer and the depth layer of image. Color values
+     * are normalized to [0,1].
+     */
+    explicit RenderBufferRAM(const Image& image);
+
+    void clear(vec4 clearColor = vec4{0.0f}, float clearDepth = 1.0f);
+    size_t index(size2_t pos) const { return pos.x + pos.y * dims.x; }
+
+    /**
+     * Create an image of the same size with a color layer of the given format and a depth layer.
+     * Color values are clamped to [0,1] and normalized to the range of colorFormat.
+     */
+    std::shared_ptr<Image> toImage(const DataFormatBase* colorFormat = DataVec4UInt8::get()) const;
+
+    size2_t dims;
+    std::vector<vec4> color;
+    std::vector<float> depth;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -70,6 +70,10 @@ IVW_MODULE_BASE_API std::optional<glm::u32vec2> sutherlandHodgman(
 IVW_MODULE_BASE_API void removeDuplicateEdges(std::vector<glm::u32vec2>& cuts,
                                               const std::vector<vec3>& positions, float eps);
 
+/**
+ * Gather the edges into loops, end points within eps of each other are considered the same.
+ * The edges are consumed.
+ */
 IVW_MODULE_BASE_API std::vector<std::vector<std::uint32_t>> gatherLoops(
     std::vector<glm::u32vec2>& edges, const std::vector<vec3>& positions, float eps);
 
@@ -80,6 +84,8 @@ IVW_MODULE_BASE_API std::vector<std::vector<std::uint32_t>> gatherLoops(
  * If holes should be closed, the input mesh must be manifold.
  * Vertex attributes are interpolated. Floating types use linear interpolation, integer types use
  * nearest. Connectivity types loop and fan are not handled.
+ * Triangles are clipped in parallel, each edge crossing the plane is split once and the new vertex
+ * is shared by the triangles on both sides of the edge.
  * @param mesh to clip
  * @param plane in world space coordinate system
  * @param capClippedHoles: replaces removed parts with triangles aligned with the plane
@@ -0,0 +1,83 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/imageramutils.h>
+#include <modules/base/algorithm/image/renderbufferram.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Mesh;
+class Camera;
+
+namespace util {
+
+struct IVW_MODULE_BASE_API MeshRasterizationSettings {
+    /// Color used for meshes without a color buffer
+    vec4 defaultColor{0.75f, 0.75f, 0.75f, 1.0f};
+    /// Apply diffuse headlight shading to meshes with a normal buffer
+    bool shading = true;
+    /// Fraction of the color that is independent of the shading
+    float ambient = 0.3f;
+    /// Size of the screen tiles that are rasterized in parallel
+    size2_t tileSize = defaultPixelTileSize;
+};
+
+/**
+ * Rasterize the triangles of the meshes into target as seen by camera, using a depth test
+ * against the values already in target. Only triangle index buffers (and meshes with triangles as
+ * default draw type and no index buffers) are drawn, points and lines are ignored. Vertex colors
+ * are interpolated perspective correctly and written without blending. Triangles are clipped
+ * against the near plane and drawn from both sides.
+ *
+ * The triangles are first set up and binned into screen tiles of settings.tileSize, then the tiles
+ * are rasterized in parallel. Each tile draws its triangles in submission order, which makes the
+ * result independent of the number of threads.
+ */
+IVW_MODULE_BASE_API void rasterizeMeshes(const std::vector<std::shared_ptr<const Mesh>>& meshes,
+                                         const Camera& camera, RenderBufferRAM& target,
+                                         const MeshRasterizationSettings& settings = {});
+
+/**
+ * Rasterize a single mesh into target.
+ * @see rasterizeMeshes
+ */
+IVW_MODULE_BASE_API void rasterizeMesh(const Mesh& mesh, const Camera& camera,
+                                       RenderBufferRAM& target,
+                                       const MeshRasterizationSettings& settings = {});
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -86,10 +86,7 @@ std::shared_ptr<Volume> VolumeLaplacianDispatcher::operator()(
     const auto resDim = dvec3(1.0) / dvec3(volume->getDimensions() - size3_t(1));
     const auto resSpace2 = dvec3(1.0) / (spacing * spacing);
 
-    auto minval(std::numeric_limits<double>::max());
-    auto maxval(std::numeric_limits<double>::lowest());
-
-    auto func = [&](const size3_t& pos) {
+    auto func = [&](const size3_t& pos, dvec2& minmax) {
         const dvec3 world{m * dvec4((dvec3(pos) + dvec3(0.5)) * resDim, 1.0)};
 
         const auto center = 2.0 * s.sample(world);
@@ -99,13 +96,20 @@ std::shared_ptr<Volume> VolumeLaplacianDispatcher::operator()(
         const auto laplacian = center + D2x + D2y + D2z;
 
         for (size_t i = 0; i < comp; ++i) {
-            minval = glm::min(minval, util::glmcomp(laplacian, i));
-            maxval = glm::max(maxval, util::glmcomp(laplacian, i));
+            minmax.x = glm::min(minmax.x, util::glmcomp(laplacian, i));
+            minmax.y = glm::max(minmax.y, util::glmcomp(laplacian, i));
         }
         newData[index(pos)] = static_cast<R>(laplacian);
     };
 
-    util::forEachVoxelParallel(*volume->getRepresentation<VolumeRAM>(), func);
+    const auto minmax = util::forEachVoxelParallelReduce(
+        *volume->getRepresentation<VolumeRAM>(),
+        dvec2{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()}, func,
+        [](const dvec2& a, const dvec2& b) {
+            return dvec2{std::min(a.x, b.x), std::max(a.y, b.y)};
+        });
+    const auto minval = minmax.x;
+    const auto maxval = minmax.y;
 
     // Make range symmetric
     auto rangemax = std::max(std::abs(minval), std::abs(maxval));
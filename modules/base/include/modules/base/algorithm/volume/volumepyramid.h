@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Volume;
+class VolumeRAM;
+
+namespace util {
+
+enum class DownsampleFilter {
+    Box,       ///< Average weighted by the overlap of the output voxel with each input voxel
+    Gaussian,  ///< Gaussian with a standard deviation of half the output voxel size
+    Max        ///< Maximum of all input voxels overlapped by the output voxel
+};
+
+/**
+ * Dimensions of the levels of a volume pyramid, starting with dims itself. Each level is `factor`
+ * times smaller than the previous one along every axis, rounded to the nearest integer but at least
+ * one, until all dimensions are one or maxLevels levels have been generated. The factor does not
+ * need to be an integer but has to be larger than one.
+ */
+IVW_MODULE_BASE_API std::vector<size3_t> volumePyramidDimensions(
+    size3_t dims, double factor = 2.0, size_t maxLevels = std::numeric_limits<size_t>::max());
+
+/**
+ * Resample the volume to the given dimensions using a separable filter. The dimensions do not
+ * need to be an integer fraction of the input dimensions. The result has the same data format as
+ * the input, integer formats are rounded to the nearest value.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeResample(const VolumeRAM& volume,
+                                                              size3_t dims,
+                                                              DownsampleFilter filter);
+
+/**
+ * Build the levels of a volume pyramid with the given dimensions, usually from
+ * volumePyramidDimensions. Each level is computed from the previous one, the first from the input,
+ * and each level is processed in parallel on the thread pool.
+ * @param volume the input
+ * @param dims the dimensions of the levels to create, not including the input.
+ * @param filter the filter used between two consecutive levels.
+ * @return one representation per entry in dims
+ */
+IVW_MODULE_BASE_API std::vector<std::shared_ptr<VolumeRAM>> volumePyramid(
+    const VolumeRAM& volume, const std::vector<size3_t>& dims, DownsampleFilter filter);
+
+/**
+ * Build a volume pyramid where each level is `factor` times smaller than the previous, see
+ * volumePyramidDimensions. The returned volumes do not include the input volume, but share its
+ * model and world matrix, data map, swizzle mask, interpolation, wrapping, and meta data.
+ */
+IVW_MODULE_BASE_API std::vector<std::shared_ptr<Volume>> volumePyramid(
+    const Volume& volume, double factor = 2.0, DownsampleFilter filter = DownsampleFilter::Box,
+    size_t maxLevels = std::numeric_limits<size_t>::max());
+
+/**
+ * Same as volumePyramid(const Volume&, double, DownsampleFilter, size_t) with all levels, but the
+ * result is cached and shared between all callers asking for the same volume, factor, and filter.
+ * The cache does not own the levels, a cached pyramid is reused as long as some caller still holds
+ * its levels, the volume is alive, and its dimensions and format are unchanged. Concurrent callers
+ * wait for a single calculation. Volumes that are modified in place need to be invalidated using
+ * invalidateVolumePyramids.
+ */
+IVW_MODULE_BASE_API std::vector<std::shared_ptr<const Volume>> cachedVolumePyramid(
+    const std::shared_ptr<const Volume>& volume, double factor = 2.0,
+    DownsampleFilter filter = DownsampleFilter::Box);
+
+/**
+ * Remove all cached pyramids of the volume.
+ */
+IVW_MODULE_BASE_API void invalidateVolumePyramids(const Volume* volume);
+
+}  // namespace util
+
+}  // namespace inviwo
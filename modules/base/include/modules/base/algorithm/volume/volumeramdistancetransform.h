@@ -31,44 +31,57 @@
 #define IVW_VOLUMERAMDISTANCETRANSFORM_H
 
 #include <modules/base/basemoduledefine.h>
+#include <modules/base/algorithm/distancetransform.h>
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/indexmapper.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
-#ifndef __clang__
-#include <omp.h>
-#endif
-
 namespace inviwo {
 
 namespace util {
 
 /**
- *	Implementation of Euclidean Distance Transform according to Saito's algorithm:
- *  T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance transformations
- *  of an n-dimensional digitized picture with applications. Pattern Recognition, 27(11).
- *  pp. 1551-1565, 1994.
- *  http://www.cs.jhu.edu/~misha/ReadingSeminar/Papers/Saito94.pdf
+ *	Implementation of Euclidean Distance Transform. The first pass scans along x, the following
+ *  passes along y and z are computed in linear time per line using the lower envelope of parabolas:
+ *  P. Felzenszwalb and D. Huttenlocher. Distance Transforms of Sampled Functions.
+ *  Theory of Computing, 8(19), pp. 415-428, 2012.
+ *  The lines of each pass are processed in parallel using the Inviwo thread pool.
  *
  * Calculates the distance in grid index space
  *     * Predicate is a function of type (const T &value) -> bool to deside if a value in the input
  *       is a "feature".
- *     * ValueTransform is a function of type (const U& squaredDist) -> U that is appiled to all
- *       squared distance values at the end of the calculation.
+ *     * ValueTransform is a function of type (const F& squaredDist) -> F that is appiled to all
+ *       squared distance values at the end of the calculation. F is double for double output and
+ *       float otherwise, i.e. a half output is calculated in float and converted at the end.
  *     * ProcessCallback is a function of type (double progress) -> void that is called with a value
- *       from 0 to 1 to indicate the progress of the calculation.
+ *       from 0 to 1 to indicate the progress of the calculation. It is only called from the calling
+ *       thread.
+ *     * Stop is a type convertible to bool, like pool::Stop, the calculation is canceled when it
+ *       evaluates to true, leaving the output incomplete.
  */
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback, typename Stop>
+void volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
+                                VolumeRAMPrecision<U> *outDistanceField,
+                                const Matrix<3, detail::DistanceTransformType<U>> basis,
+                                const size3_t upsample, Predicate predicate,
+                                ValueTransform valueTransform, ProgressCallback callback,
+                                const Stop &stop);
+
 template <typename T, typename U, typename Predicate, typename ValueTransform,
           typename ProgressCallback>
 void volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
-                                VolumeRAMPrecision<U> *outDistanceField, const Matrix<3, U> basis,
+                                VolumeRAMPrecision<U> *outDistanceField,
+                                const Matrix<3, detail::DistanceTransformType<U>> basis,
                                 const size3_t upsample, Predicate predicate,
                                 ValueTransform valueTransform, ProgressCallback callback);
 
 template <typename T, typename U>
 void volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
-                                VolumeRAMPrecision<U> *outDistanceField, const Matrix<3, U> basis,
+                                VolumeRAMPrecision<U> *outDistanceField,
+                                const Matrix<3, detail::DistanceTransformType<U>> basis,
                                 const size3_t upsample);
 
 template <typename U, typename Predicate, typename ValueTransform, typename ProgressCallback>
@@ -76,6 +89,12 @@ void volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U> *outD
                              const size3_t upsample, Predicate predicate,
                              ValueTransform valueTransform, ProgressCallback callback);
 
+template <typename U, typename ProgressCallback, typename Stop>
+void volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U> *outDistanceField,
+                             const size3_t upsample, double threshold, bool normalize, bool flip,
+                             bool square, double scale, ProgressCallback callback,
+                             const Stop &stop);
+
 template <typename U, typename ProgressCallback>
 void volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U> *outDistanceField,
                              const size3_t upsample, double threshold, bool normalize, bool flip,
@@ -89,18 +108,15 @@ void volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U> *outD
 }  // namespace util
 
 template <typename T, typename U, typename Predicate, typename ValueTransform,
-          typename ProgressCallback>
+          typename ProgressCallback, typename Stop>
 void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
                                       VolumeRAMPrecision<U> *outDistanceField,
-                                      const Matrix<3, U> basis, const size3_t upsample,
-                                      Predicate predicate, ValueTransform valueTransform,
-                                      ProgressCallback callback) {
-
-#ifndef __clang__
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
-
+                                      const Matrix<3, detail::DistanceTransformType<U>> basis,
+                                      const size3_t upsample, Predicate predicate,
+                                      ValueTransform valueTransform, ProgressCallback callback,
+                                      const Stop &stop) {
     using int64 = glm::int64;
+    using F = detail::DistanceTransformType<U>;
 
     auto square = [](auto a) { return a * a; };
 
@@ -114,9 +130,8 @@ void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
     const i64vec3 sm{upsample};
 
     const auto squareBasis = glm::transpose(basis) * basis;
-    const Vector<3, U> squareBasisDiag{squareBasis[0][0], squareBasis[1][1], squareBasis[2][2]};
-    const Vector<3, U> squareVoxelSize{squareBasisDiag / Vector<3, U>{dstDim * dstDim}};
-    const Vector<3, U> invSquareVoxelSize{Vector<3, U>{1.0f} / squareVoxelSize};
+    const Vector<3, F> squareBasisDiag{squareBasis[0][0], squareBasis[1][1], squareBasis[2][2]};
+    const Vector<3, F> squareVoxelSize{squareBasisDiag / Vector<3, F>{dstDim * dstDim}};
 
     {
         const auto maxdist = glm::compMax(squareBasisDiag);
@@ -153,126 +168,122 @@ void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
         return predicate(src[srcInd(x / sm.x, y / sm.y, z / sm.z)]);
     };
 
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#pragma omp parallel for
-    for (int64 z = 0; z < dstDim.z; ++z) {
-        for (int64 y = 0; y < dstDim.y; ++y) {
-            // forward
-            U dist = static_cast<U>(dstDim.x);
-            for (int64 x = 0; x < dstDim.x; ++x) {
-                if (!is_feature(x, y, z)) {
-                    ++dist;
-                } else {
-                    dist = U(0);
-                }
-                dst[dstInd(x, y, z)] = squareVoxelSize.x * square(dist);
-            }
+    const auto progress = [&callback](double begin, double end) {
+        return [&callback, begin, end](size_t i, size_t n) {
+            callback(begin + (end - begin) * static_cast<double>(i) / static_cast<double>(n));
+        };
+    };
 
-            // backward
-            dist = static_cast<U>(dstDim.x);
-            for (int64 x = dstDim.x - 1; x >= 0; --x) {
-                if (!is_feature(x, y, z)) {
-                    ++dist;
-                } else {
-                    dist = U(0);
-                }
-                dst[dstInd(x, y, z)] =
-                    std::min<U>(dst[dstInd(x, y, z)], squareVoxelSize.x * square(dist));
-            }
-        }
+    // The squared distances are calculated in place if the output has full precision, otherwise
+    // in a temporary buffer
+    const auto size = static_cast<size_t>(dstDim.x * dstDim.y * dstDim.z);
+    std::vector<F> buffer;
+    F *dist = nullptr;
+    if constexpr (std::is_same_v<U, F>) {
+        dist = dst;
+    } else {
+        buffer.resize(size);
+        dist = buffer.data();
     }
 
-    // second pass, scan y direction
-    // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
-    // result: min distance in x and y direction
-    callback(0.3);
-#pragma omp parallel
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.y);
-#pragma omp for
-        for (int64 z = 0; z < dstDim.z; ++z) {
-            for (int64 x = 0; x < dstDim.x; ++x) {
-
-                // cache column data into temporary buffer
-                for (int64 y = 0; y < dstDim.y; ++y) {
-                    buff[y] = dst[dstInd(x, y, z)];
+    // Squared distance used for voxels in lines without any feature, larger than any real distance
+    // but finite to keep the following passes well defined.
+    const F noFeature = F(2) * glm::compAdd(squareBasisDiag);
+
+    // first pass, forward and backward scan along x
+    // result: min distance in x direction
+    util::forEachRangeParallel(
+        static_cast<size_t>(dstDim.y * dstDim.z), stop, progress(0.0, 0.3),
+        [&](size_t first, size_t last) {
+            for (auto line = static_cast<int64>(first); line < static_cast<int64>(last); ++line) {
+                const auto y = line % dstDim.y;
+                const auto z = line / dstDim.y;
+                F *row = dist + dstInd(0, y, z);
+
+                // forward
+                F d = std::numeric_limits<F>::infinity();
+                for (int64 x = 0; x < dstDim.x; ++x) {
+                    d = is_feature(x, y, z) ? F(0) : d + F(1);
+                    row[x] = std::min(squareVoxelSize.x * square(d), noFeature);
                 }
 
-                for (int64 y = 0; y < dstDim.y; ++y) {
-                    auto d = buff[y];
-                    if (d != U(0)) {
-                        const auto rMax =
-                            static_cast<int64>(std::sqrt(d * invSquareVoxelSize.y)) + 1;
-                        const auto rStart = std::min(rMax, y - 1);
-                        const auto rEnd = std::min(rMax, dstDim.y - y);
-                        for (int64 n = -rStart; n < rEnd; ++n) {
-                            const auto w = buff[y + n] + squareVoxelSize.y * square(n);
-                            if (w < d) d = w;
-                        }
-                    }
-                    dst[dstInd(x, y, z)] = d;
+                // backward, features are already marked with a zero distance
+                d = std::numeric_limits<F>::infinity();
+                for (int64 x = dstDim.x - 1; x >= 0; --x) {
+                    d = row[x] == F(0) ? F(0) : d + F(1);
+                    row[x] = std::min(row[x], squareVoxelSize.x * square(d));
                 }
             }
-        }
-    }
+        });
+    if (stop) return;
+
+    // Scan all lines of length n with the given stride, the start of each line is given by
+    // lineStart(line). For each voxel v(i) find min_j(data(j) + w * (i - j)^2), 0 <= j < n
+    const auto scan = [&](int64 n, int64 stride, auto lineStart, F w, double begin, double end) {
+        util::forEachRangeParallel(
+            size / static_cast<size_t>(n), stop, progress(begin, end),
+            [&](size_t first, size_t last) {
+                std::vector<F> f(static_cast<size_t>(n));
+                std::vector<F> d(static_cast<size_t>(n));
+                std::vector<F> z;
+                std::vector<std::ptrdiff_t> v;
+                for (auto line = static_cast<int64>(first); line < static_cast<int64>(last);
+                     ++line) {
+                    F *data = dist + lineStart(line);
+                    for (int64 i = 0; i < n; ++i) f[i] = data[i * stride];
+                    detail::distanceTransform1D(f.data(), d.data(), n, w, v, z);
+                    for (int64 i = 0; i < n; ++i) data[i * stride] = d[i];
+                }
+            });
+    };
 
-    // third pass, scan z direction
-    // for each voxel v(x,y,z) find min_i(data(x,y,i) + (z - i)^2), 0 <= i < dimZ
+    // second pass, scan y direction
     // result: min distance in x and y direction
-    callback(0.6);
-#pragma omp parallel
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.z);
-#pragma omp for
-        for (int64 y = 0; y < dstDim.y; ++y) {
-            for (int64 x = 0; x < dstDim.x; ++x) {
-
-                // cache column data into temporary buffer
-                for (int64 z = 0; z < dstDim.z; ++z) {
-                    buff[z] = dst[dstInd(x, y, z)];
-                }
+    scan(
+        dstDim.y, dstDim.x,
+        [&](int64 line) { return dstInd(line % dstDim.x, 0, line / dstDim.x); },
+        squareVoxelSize.y, 0.3, 0.6);
+    if (stop) return;
 
-                for (int64 z = 0; z < dstDim.z; ++z) {
-                    auto d = buff[z];
-                    if (d != U(0)) {
-                        const auto rMax =
-                            static_cast<int64>(std::sqrt(d * invSquareVoxelSize.z)) + 1;
-                        const auto rStart = std::min(rMax, z - 1);
-                        const auto rEnd = std::min(rMax, dstDim.z - z);
-                        for (int64 n = -rStart; n < rEnd; ++n) {
-                            const auto w = buff[z + n] + squareVoxelSize.z * square(n);
-                            if (w < d) d = w;
-                        }
-                    }
-                    dst[dstInd(x, y, z)] = d;
-                }
-            }
-        }
-    }
+    // third pass, scan z direction
+    // result: min distance in x, y, and z direction
+    scan(
+        dstDim.z, dstDim.x * dstDim.y,
+        [&](int64 line) { return dstInd(line % dstDim.x, line / dstDim.x, 0); },
+        squareVoxelSize.z, 0.6, 0.9);
+    if (stop) return;
 
     // scale data
-    callback(0.9);
-    const int64 volSize = dstDim.x * dstDim.y * dstDim.z;
-#pragma omp parallel for
-    for (int64 i = 0; i < volSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
+    util::forEachRangeParallel(size, stop, progress(0.9, 1.0), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            dst[i] = static_cast<U>(valueTransform(dist[i]));
+        }
+    });
     callback(1.0);
 }
 
-template <typename T, typename U>
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
 void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
                                       VolumeRAMPrecision<U> *outDistanceField,
-                                      const Matrix<3, U> basis, const size3_t upsample) {
+                                      const Matrix<3, detail::DistanceTransformType<U>> basis,
+                                      const size3_t upsample, Predicate predicate,
+                                      ValueTransform valueTransform, ProgressCallback callback) {
+    util::volumeRAMDistanceTransform(inVolume, outDistanceField, basis, upsample, predicate,
+                                     valueTransform, callback, detail::NoStop{});
+}
 
+template <typename T, typename U>
+void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
+                                      VolumeRAMPrecision<U> *outDistanceField,
+                                      const Matrix<3, detail::DistanceTransformType<U>> basis,
+                                      const size3_t upsample) {
+    using F = detail::DistanceTransformType<U>;
     util::volumeRAMDistanceTransform(
         inVolume, outDistanceField, basis, upsample,
         [](const T &val) { return util::glm_convert_normalized<double>(val) > 0.5; },
-        [](const U &squareDist) {
-            return static_cast<U>(std::sqrt(static_cast<double>(squareDist)));
+        [](const F &squareDist) {
+            return static_cast<F>(std::sqrt(static_cast<double>(squareDist)));
         },
         [](double f) {});
 }
@@ -282,18 +293,20 @@ void util::volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U>
                                    const size3_t upsample, Predicate predicate,
                                    ValueTransform valueTransform, ProgressCallback callback) {
 
+    const Matrix<3, detail::DistanceTransformType<U>> basis{inVolume->getBasis()};
     const auto inputVolumeRep = inVolume->getRepresentation<VolumeRAM>();
     inputVolumeRep->dispatch<void, dispatching::filter::Scalars>([&](const auto vrprecision) {
-        volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(), upsample,
-                                   predicate, valueTransform, callback);
+        volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample, predicate,
+                                   valueTransform, callback);
     });
 }
 
-template <typename U, typename ProgressCallback>
+template <typename U, typename ProgressCallback, typename Stop>
 void util::volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U> *outDistanceField,
                                    const size3_t upsample, double threshold, bool normalize,
-                                   bool flip, bool square, double scale,
-                                   ProgressCallback progress) {
+                                   bool flip, bool square, double scale, ProgressCallback progress,
+                                   const Stop &stop) {
+    using F = detail::DistanceTransformType<U>;
 
     const auto inputVolumeRep = inVolume->getRepresentation<VolumeRAM>();
     inputVolumeRep->dispatch<void, dispatching::filter::Scalars>([&](const auto vrprecision) {
@@ -309,41 +322,52 @@ void util::volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U>
             return util::glm_convert_normalized<double>(val) > threshold;
         };
 
-        const auto valTransIdent = [scale](const float &squareDist) {
-            return static_cast<float>(scale * squareDist);
+        const auto valTransIdent = [scale](const F &squareDist) {
+            return static_cast<F>(scale * squareDist);
         };
-        const auto valTransSqrt = [scale](const float &squareDist) {
-            return static_cast<float>(scale * std::sqrt(squareDist));
+        const auto valTransSqrt = [scale](const F &squareDist) {
+            return static_cast<F>(scale * std::sqrt(squareDist));
         };
 
+        const Matrix<3, F> basis{inVolume->getBasis()};
+
         if (normalize && square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateIn, valTransIdent, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             normPredicateIn, valTransIdent, progress, stop);
         } else if (normalize && square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateOut, valTransIdent, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             normPredicateOut, valTransIdent, progress, stop);
         } else if (normalize && !square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateIn, valTransSqrt, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             normPredicateIn, valTransSqrt, progress, stop);
         } else if (normalize && !square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, normPredicateOut, valTransSqrt, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             normPredicateOut, valTransSqrt, progress, stop);
         } else if (!normalize && square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateIn, valTransIdent, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             predicateIn, valTransIdent, progress, stop);
         } else if (!normalize && square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateOut, valTransIdent, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             predicateOut, valTransIdent, progress, stop);
         } else if (!normalize && !square && flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateIn, valTransSqrt, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             predicateIn, valTransSqrt, progress, stop);
         } else if (!normalize && !square && !flip) {
-            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, inVolume->getBasis(),
-                                             upsample, predicateOut, valTransSqrt, progress);
+            util::volumeRAMDistanceTransform(vrprecision, outDistanceField, basis, upsample,
+                                             predicateOut, valTransSqrt, progress, stop);
         }
     });
 }
 
+template <typename U, typename ProgressCallback>
+void util::volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U> *outDistanceField,
+                                   const size3_t upsample, double threshold, bool normalize,
+                                   bool flip, bool square, double scale,
+                                   ProgressCallback progress) {
+    util::volumeDistanceTransform(inVolume, outDistanceField, upsample, threshold, normalize, flip,
+                                  square, scale, progress, detail::NoStop{});
+}
+
 template <typename U>
 void util::volumeDistanceTransform(const Volume *inVolume, VolumeRAMPrecision<U> *outDistanceField,
                                    const size3_t upsample, double threshold, bool normalize,
@@ -0,0 +1,103 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/imageramutils.h>
+#include <modules/base/algorithm/image/renderbufferram.h>
+
+#include <vector>
+
+namespace inviwo {
+
+class Volume;
+class Camera;
+class TransferFunction;
+
+namespace util {
+
+struct IVW_MODULE_BASE_API VolumeRaycastingSettings {
+    /// Number of samples per voxel along the ray
+    float samplingRate = 2.0f;
+    /// The volume channel to render
+    size_t channel = 0;
+    /// Rays are terminated once the accumulated opacity reaches this value
+    float opacityThreshold = 0.99f;
+    /// Size of the screen tiles that are rendered in parallel
+    size2_t tileSize = defaultPixelTileSize;
+};
+
+/**
+ * One channel of a volume normalized to [0,1] using the data range of the volume, stored as a
+ * flat float array in the same order as the voxels.
+ */
+struct IVW_MODULE_BASE_API NormalizedVolumeChannel {
+    size3_t dims{0};
+    std::vector<float> values;
+};
+
+/**
+ * Normalize the given channel of the volume, see NormalizedVolumeChannel. The channel is clamped
+ * to the number of channels of the volume.
+ */
+IVW_MODULE_BASE_API NormalizedVolumeChannel normalizeVolumeChannel(const Volume& volume,
+                                                                   size_t channel);
+
+/**
+ * Direct volume rendering on the CPU. For each pixel of target a ray is cast through the volume,
+ * sampled with trilinear interpolation, classified with the transfer function lookup table
+ * (the LayerRAM of TransferFunction::getData()) and composited front to back. Rays stop at the
+ * depth already in target and the existing color is blended behind the volume, hence a volume
+ * can be composited with geometry drawn by rasterizeMeshes. The depth of the first non
+ * transparent sample is written to target. The opacity is corrected for the sampling rate in the
+ * same way as the OpenGL raycaster.
+ *
+ * The selected channel is normalized into a flat float array once, using the data range of the
+ * volume, and then the screen tiles are rendered in parallel. Use the overload taking a
+ * NormalizedVolumeChannel to reuse the normalized data when rendering the same volume repeatedly.
+ */
+IVW_MODULE_BASE_API void raycastVolume(const Volume& volume, const TransferFunction& tf,
+                                       const Camera& camera, RenderBufferRAM& target,
+                                       const VolumeRaycastingSettings& settings = {});
+
+/**
+ * Same as raycastVolume above, but sampling the already normalized \p channel. The volume only
+ * provides the transformations, settings.channel is ignored.
+ */
+IVW_MODULE_BASE_API void raycastVolume(const Volume& volume,
+                                       const NormalizedVolumeChannel& channel,
+                                       const TransferFunction& tf, const Camera& camera,
+                                       RenderBufferRAM& target,
+                                       const VolumeRaycastingSettings& settings = {});
+
+}  // namespace util
+
+}  // namespace inviwo
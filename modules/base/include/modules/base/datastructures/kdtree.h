@@ -33,8 +33,12 @@
 #include <vector>
 #include <sstream>
 #include <algorithm>
+#include <limits>
+#include <numeric>
 
 #include <inviwo/core/util/glm.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/foreach.h>
 
 namespace inviwo {
 
@@ -741,5 +745,299 @@ void KDNode<N, T, P>::findNNearest(const P pos[N], size_t amount,
         leftChild_->findNNearest(pos, amount, current);
     }
 }
+/**
+ * \brief A static KD-tree stored in flat arrays, built in bulk from a set of points.
+ *
+ * The tree is balanced by construction, every inner node splits its range of points at the
+ * median along the dimension of largest spread. Since the split position is always the middle of
+ * the range, the tree has an implicit layout: the children of node i are 2i+1 and 2i+2, and
+ * only the split value and dimension of each inner node are stored. The points are kept in tree
+ * order in buckets of at most about `leafSize` points. All queries return indices into the point
+ * vector the tree was built from. Building the lower levels of the tree and batched queries are
+ * done in parallel on the thread pool if there is one.
+ *
+ * \code{.cpp}
+ * FlatKDTree<3, float> tree(points);
+ * const auto nearest = tree.findNNearest(vec3{0.5f}, 10);
+ * \endcode
+ */
+template <unsigned int N, typename P = double>
+class FlatKDTree {
+public:
+    using Point = Vector<N, P>;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    FlatKDTree() = default;
+    explicit FlatKDTree(const std::vector<Point> &points, size_t leafSize = 16);
+
+    size_t size() const { return points_.size(); }
+    bool empty() const { return points_.empty(); }
+    /// Number of inner levels, i.e. the leaves are at this depth
+    size_t depth() const { return depth_; }
+
+    /// Position of the point with the given original index
+    const Point &getPoint(size_t index) const { return points_[position_[index]]; }
+
+    /**
+     * Index of the point closest to pos, or npos if the tree is empty
+     */
+    size_t findNearest(const Point &pos) const;
+
+    /**
+     * Indices of the k points closest to pos sorted by increasing distance. Fewer than k indices
+     * are returned if the tree has less than k points.
+     */
+    std::vector<size_t> findNNearest(const Point &pos, size_t k) const;
+    void findNNearest(const Point &pos, size_t k, std::vector<size_t> &result) const;
+
+    /**
+     * Indices of all points within radius of pos, in no particular order
+     */
+    std::vector<size_t> findCloseTo(const Point &pos, P radius) const;
+    void findCloseTo(const Point &pos, P radius, std::vector<size_t> &result) const;
+
+    /**
+     * Batched kNN query. Returns queries.size() * k indices, the k nearest for each query sorted by
+     * increasing distance, padded with npos if the tree has less than k points.
+     */
+    std::vector<size_t> findNNearest(const std::vector<Point> &queries, size_t k) const;
+
+    /**
+     * Batched radius query. Returns the indices within radius for each query.
+     */
+    std::vector<std::vector<size_t>> findCloseTo(const std::vector<Point> &queries,
+                                                 P radius) const;
+
+private:
+    using Candidate = std::pair<P, size_t>;  // squared distance and position in points_
+
+    void build(std::vector<size_t> &order, const std::vector<Point> &points, size_t node,
+               size_t begin, size_t end, size_t level);
+    void nearest(const Point &pos, size_t k, std::vector<Candidate> &heap, size_t node,
+                 size_t begin, size_t end, size_t level) const;
+    void closeTo(const Point &pos, P sqRadius, std::vector<size_t> &result, size_t node,
+                 size_t begin, size_t end, size_t level) const;
+
+    std::vector<Point> points_;     ///< points in tree order
+    std::vector<size_t> indices_;   ///< original index of each point in tree order
+    std::vector<size_t> position_;  ///< position in tree order of each original index
+    std::vector<P> splits_;         ///< split value of each inner node
+    std::vector<unsigned char> dims_;  ///< split dimension of each inner node
+    size_t depth_ = 0;
+};
+
+template <unsigned int N, typename P>
+FlatKDTree<N, P>::FlatKDTree(const std::vector<Point> &points, size_t leafSize) {
+    leafSize = std::max<size_t>(leafSize, 1);
+    while ((points.size() >> depth_) > leafSize) ++depth_;
+
+    const size_t innerNodes = (size_t{1} << depth_) - 1;
+    splits_.resize(innerNodes);
+    dims_.resize(innerNodes);
+
+    std::vector<size_t> order(points.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+
+    // Build the top levels serially until there are enough subtrees to keep the pool busy, then
+    // build the subtrees in parallel. Each subtree only touches its own range and nodes.
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    size_t parallelLevel = 0;
+    while (parallelLevel < depth_ && (size_t{1} << parallelLevel) < 4 * poolSize &&
+           (points.size() >> parallelLevel) > 65536) {
+        ++parallelLevel;
+    }
+    if (poolSize == 0 || parallelLevel == 0) {
+        build(order, points, 0, 0, points.size(), 0);
+    } else {
+        const auto topDepth = depth_;
+        depth_ = parallelLevel;
+        build(order, points, 0, 0, points.size(), 0);
+        depth_ = topDepth;
+
+        const size_t subtrees = size_t{1} << parallelLevel;
+        util::forEachRangeParallel(subtrees, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                // the range of subtree i follows from repeated halving, like in the queries
+                size_t begin = 0;
+                size_t end = points.size();
+                for (size_t l = parallelLevel; l-- > 0;) {
+                    const size_t mid = begin + (end - begin) / 2;
+                    if ((i >> l) & 1) {
+                        begin = mid;
+                    } else {
+                        end = mid;
+                    }
+                }
+                build(order, points, subtrees - 1 + i, begin, end, parallelLevel);
+            }
+        });
+    }
+
+    points_.resize(points.size());
+    position_.resize(points.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        points_[i] = points[order[i]];
+        position_[order[i]] = i;
+    }
+    indices_ = std::move(order);
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::build(std::vector<size_t> &order, const std::vector<Point> &points,
+                             size_t node, size_t begin, size_t end, size_t level) {
+    if (level == depth_) return;
+
+    Point min{std::numeric_limits<P>::max()};
+    Point max{std::numeric_limits<P>::lowest()};
+    for (size_t i = begin; i < end; ++i) {
+        min = glm::min(min, points[order[i]]);
+        max = glm::max(max, points[order[i]]);
+    }
+    const Point extent = max - min;
+    unsigned char dim = 0;
+    for (unsigned int d = 1; d < N; ++d) {
+        if (extent[d] > extent[dim]) dim = static_cast<unsigned char>(d);
+    }
+
+    const size_t mid = begin + (end - begin) / 2;
+    if (mid < end) {
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                         [&](size_t a, size_t b) { return points[a][dim] < points[b][dim]; });
+        splits_[node] = points[order[mid]][dim];
+    } else {
+        splits_[node] = P{0};
+    }
+    dims_[node] = dim;
+
+    build(order, points, 2 * node + 1, begin, mid, level + 1);
+    build(order, points, 2 * node + 2, mid, end, level + 1);
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::nearest(const Point &pos, size_t k, std::vector<Candidate> &heap,
+                               size_t node, size_t begin, size_t end, size_t level) const {
+    if (level == depth_) {
+        for (size_t i = begin; i < end; ++i) {
+            const Point diff = points_[i] - pos;
+            const P sqDist = glm::dot(diff, diff);
+            if (heap.size() < k) {
+                heap.emplace_back(sqDist, i);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (sqDist < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = {sqDist, i};
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        return;
+    }
+
+    const size_t mid = begin + (end - begin) / 2;
+    const P diff = pos[dims_[node]] - splits_[node];
+    // points left of the split are <= the split value, points right of it are >=
+    const bool left = diff < P{0};
+    if (left) {
+        nearest(pos, k, heap, 2 * node + 1, begin, mid, level + 1);
+    } else {
+        nearest(pos, k, heap, 2 * node + 2, mid, end, level + 1);
+    }
+    if (heap.size() < k || diff * diff < heap.front().first) {
+        if (left) {
+            nearest(pos, k, heap, 2 * node + 2, mid, end, level + 1);
+        } else {
+            nearest(pos, k, heap, 2 * node + 1, begin, mid, level + 1);
+        }
+    }
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::closeTo(const Point &pos, P sqRadius, std::vector<size_t> &result,
+                               size_t node, size_t begin, size_t end, size_t level) const {
+    if (level == depth_) {
+        for (size_t i = begin; i < end; ++i) {
+            const Point diff = points_[i] - pos;
+            if (glm::dot(diff, diff) <= sqRadius) result.push_back(indices_[i]);
+        }
+        return;
+    }
+
+    const size_t mid = begin + (end - begin) / 2;
+    const P diff = pos[dims_[node]] - splits_[node];
+    if (diff <= P{0} || diff * diff <= sqRadius) {
+        closeTo(pos, sqRadius, result, 2 * node + 1, begin, mid, level + 1);
+    }
+    if (diff >= P{0} || diff * diff <= sqRadius) {
+        closeTo(pos, sqRadius, result, 2 * node + 2, mid, end, level + 1);
+    }
+}
+
+template <unsigned int N, typename P>
+size_t FlatKDTree<N, P>::findNearest(const Point &pos) const {
+    std::vector<Candidate> heap;
+    nearest(pos, 1, heap, 0, 0, points_.size(), 0);
+    return heap.empty() ? npos : indices_[heap.front().second];
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findNNearest(const Point &pos, size_t k, std::vector<size_t> &result) const {
+    result.clear();
+    if (k == 0) return;
+    std::vector<Candidate> heap;
+    heap.reserve(std::min(k, points_.size()));
+    nearest(pos, k, heap, 0, 0, points_.size(), 0);
+    std::sort_heap(heap.begin(), heap.end());
+    for (const auto &candidate : heap) {
+        result.push_back(indices_[candidate.second]);
+    }
+}
+
+template <unsigned int N, typename P>
+std::vector<size_t> FlatKDTree<N, P>::findNNearest(const Point &pos, size_t k) const {
+    std::vector<size_t> result;
+    findNNearest(pos, k, result);
+    return result;
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findCloseTo(const Point &pos, P radius, std::vector<size_t> &result) const {
+    result.clear();
+    closeTo(pos, radius * radius, result, 0, 0, points_.size(), 0);
+}
+
+template <unsigned int N, typename P>
+std::vector<size_t> FlatKDTree<N, P>::findCloseTo(const Point &pos, P radius) const {
+    std::vector<size_t> result;
+    findCloseTo(pos, radius, result);
+    return result;
+}
+
+template <unsigned int N, typename P>
+std::vector<size_t> FlatKDTree<N, P>::findNNearest(const std::vector<Point> &queries,
+                                                   size_t k) const {
+    if (k == 0) return {};
+    std::vector<size_t> result(queries.size() * k, npos);
+    util::forEachRangeParallel(queries.size(), [&](size_t first, size_t last) {
+        std::vector<size_t> nearest;
+        for (size_t i = first; i < last; ++i) {
+            findNNearest(queries[i], k, nearest);
+            std::copy(nearest.begin(), nearest.end(), result.begin() + i * k);
+        }
+    });
+    return result;
+}
+
+template <unsigned int N, typename P>
+std::vector<std::vector<size_t>> FlatKDTree<N, P>::findCloseTo(const std::vector<Point> &queries,
+                                                               P radius) const {
+    std::vector<std::vector<size_t>> result(queries.size());
+    util::forEachRangeParallel(queries.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            findCloseTo(queries[i], radius, result[i]);
+        }
+    });
+    return result;
+}
+
 }  // namespace inviwo
 #endif
@@ -54,7 +54,8 @@ namespace inviwo {
 *
 * Computes the distance transform of a volume dataset using a threshold value
 * The result is the distance from each voxel to the closest feature. It will only work correctly for
-* volumes with a orthogonal basis. It uses the Saito's algorithm to compute the Euclidean distance.
+* volumes with a orthogonal basis. The Euclidean distance is computed in separable linear time
+* passes on the thread pool.
 *
 * ### Inports
 *   * __inputVolume__ Input volume
@@ -69,6 +70,7 @@ namespace inviwo {
 *   * __Use normalized threshold__ Use normalized values when comparing to the threshold.
 *   * __Scaling Factor__ Scaling factor to apply to the output distance field.
 *   * __Squared Distance__ Output the squared distance field
+*   * __Output Format__ Store the distance field as 32-bit float or 16-bit half.
 *   * __Up sample__ Make the output volume have a higher resolution.
 *   * __Data Range__ Data range to use for the output volume:
 *       * Diagonal use [0, volume diagonal].
@@ -100,6 +102,7 @@ private:
     BoolProperty normalize_;
     DoubleProperty resultDistScale_;  // scaling factor for distances
     BoolProperty resultSquaredDist_;  // determines whether output uses squared euclidean distances
+    TemplateOptionProperty<DataFormatId> outputFormat_;
     BoolProperty uniformUpsampling_;
     IntProperty upsampleFactorUniform_;    // uniform upscaling of the output field
     IntSize3Property upsampleFactorVec3_;  // non-uniform upscaling of the output field
@@ -32,7 +32,7 @@
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
@@ -61,6 +61,9 @@ class DataReaderFactory;
  * Single channels, i.e. red, green, blue, alpha, and grayscale, will result in a scalar volume
  * whereas rgb and rgba will yield a vec3 or vec4 volume, respectively.
  *
+ * The slices are decoded concurrently on the thread pool, each directly into its z-plane of the
+ * output volume. Loading can be canceled by changing the file pattern or reloading.
+ *
  * ### Outports
  *   * __volume__ Volume generated from a stack of input images.
  *
@@ -74,7 +77,7 @@ class DataReaderFactory;
  *   * __Data Information__       Metadata of the generated volume data set.
  *
  */
-class IVW_MODULE_BASE_API ImageStackVolumeSource : public Processor {
+class IVW_MODULE_BASE_API ImageStackVolumeSource : public PoolProcessor {
 public:
     ImageStackVolumeSource(InviwoApplication* app);
     void addFileNameFilters();
@@ -86,7 +89,12 @@ public:
     static const ProcessorInfo processorInfo_;
 
 protected:
-    std::shared_ptr<Volume> load();
+    /**
+     * Reads the first slice to determine the volume format and dimensions and dispatches the
+     * decoding of all slices to the thread pool. The volume is set on the outport once all
+     * slices have been loaded.
+     */
+    void load();
     bool isValidImageFile(std::string);
 
     virtual void deserialize(Deserializer& d) override;
@@ -0,0 +1,88 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/interaction/cameratrackball.h>
+#include <inviwo/core/ports/imageport.h>
+#include <inviwo/core/ports/meshport.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/cameraproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.MeshRasterizerCPU, Mesh Rasterizer CPU}
+ * ![](org.inviwo.MeshRasterizerCPU.png?classIdentifier=org.inviwo.MeshRasterizerCPU)
+ * Renders the triangles of the input meshes on the CPU, without any OpenGL context. Intended for
+ * headless and offline rendering. Vertex colors are used when available, and meshes with normals
+ * are shaded with a headlight.
+ * @see util::rasterizeMeshes
+ *
+ * ### Inports
+ *   * __geometry__ Input meshes
+ *   * __imageInport__ Optional background image, its depth is used for the depth test
+ *
+ * ### Outports
+ *   * __image__ The rendered image with color and depth
+ *
+ * ### Properties
+ *   * __Camera__ Camera used for rendering
+ *   * __Background__ Background color used when there is no background image
+ *   * __Default Color__ Color of meshes without a color buffer
+ *   * __Shading__ Apply headlight shading to meshes with normals
+ *   * __Ambient__ Fraction of the color that is not affected by the shading
+ */
+class IVW_MODULE_BASE_API MeshRasterizerCPU : public Processor {
+public:
+    MeshRasterizerCPU();
+    virtual ~MeshRasterizerCPU() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    MeshFlatMultiInport inport_;
+    ImageInport imageInport_;
+    ImageOutport outport_;
+
+    CameraProperty camera_;
+    CameraTrackball trackball_;
+    FloatVec4Property background_;
+    FloatVec4Property defaultColor_;
+    BoolProperty shading_;
+    FloatProperty ambient_;
+};
+
+}  // namespace inviwo
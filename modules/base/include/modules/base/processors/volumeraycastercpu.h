@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/interaction/cameratrackball.h>
+#include <inviwo/core/ports/imageport.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/cameraproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/transferfunctionproperty.h>
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+
+#include <optional>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.VolumeRaycasterCPU, Volume Raycaster CPU}
+ * ![](org.inviwo.VolumeRaycasterCPU.png?classIdentifier=org.inviwo.VolumeRaycasterCPU)
+ * Direct volume rendering on the CPU, without any OpenGL context. Intended for headless and
+ * offline rendering. The volume is composited in front of an optional background image, for
+ * example the output of a Mesh Rasterizer CPU using the same camera.
+ * @see util::raycastVolume
+ *
+ * ### Inports
+ *   * __volume__ Input volume
+ *   * __background__ Optional background image, rays stop at its depth
+ *
+ * ### Outports
+ *   * __image__ The rendered image with color and depth
+ *
+ * ### Properties
+ *   * __Channel__ The volume channel to render
+ *   * __Transfer Function__ Maps normalized volume values to color and opacity
+ *   * __Sampling Rate__ Number of samples per voxel along the rays
+ *   * __Camera__ Camera used for rendering
+ *   * __Background__ Background color used when there is no background image
+ */
+class IVW_MODULE_BASE_API VolumeRaycasterCPU : public Processor {
+public:
+    VolumeRaycasterCPU();
+    virtual ~VolumeRaycasterCPU() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    VolumeInport volume_;
+    ImageInport backgroundPort_;
+    ImageOutport outport_;
+
+    IntSizeTProperty channel_;
+    TransferFunctionProperty transferFunction_;
+    FloatProperty samplingRate_;
+    CameraProperty camera_;
+    CameraTrackball trackball_;
+    FloatVec4Property background_;
+
+    /// The selected channel of the input volume, updated when the volume or channel changes
+    std::optional<util::NormalizedVolumeChannel> normalized_;
+};
+
+}  // namespace inviwo
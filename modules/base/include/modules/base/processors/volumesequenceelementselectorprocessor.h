@@ -34,8 +34,14 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
 #include <modules/base/processors/vectorelementselectorprocessor.h>
 
+#include <future>
+#include <list>
+#include <unordered_map>
+
 namespace inviwo {
 
 /** \docpage{org.inviwo.TimeStepSelector, Volume Sequence/Time Selector}
@@ -50,6 +56,11 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The volume sequence index to extract
+ *   * __Prefetch Steps__ Number of steps before and after the selected one that are loaded into
+ *                        memory in the background
+ *   * __Memory Budget__ Volumes outside of the prefetch window that have been loaded from disk
+ *                       are unloaded, least recently used first, when their total size exceeds
+ *                       this budget (in MB)
  */
 class IVW_MODULE_BASE_API VolumeSequenceElementSelectorProcessor
     : public VectorElementSelectorProcessor<Volume> {
@@ -57,8 +68,24 @@ public:
     VolumeSequenceElementSelectorProcessor();
     virtual ~VolumeSequenceElementSelectorProcessor() = default;
 
+    virtual void process() override;
+
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
+
+private:
+    void prefetch(const std::vector<std::shared_ptr<Volume>>& volumes, size_t index);
+    void evict(const std::vector<std::shared_ptr<Volume>>& volumes,
+               const std::vector<std::shared_ptr<Volume>>& window);
+
+    CompositeProperty prefetch_;
+    IntSizeTProperty prefetchSteps_;
+    IntSizeTProperty memoryBudget_;
+
+    /// Volumes in order of use, most recent first
+    std::list<std::weak_ptr<Volume>> lru_;
+    /// Background loads that have not been collected yet
+    std::unordered_map<const Volume*, std::future<void>> pending_;
 };
 
 }  // namespace inviwo
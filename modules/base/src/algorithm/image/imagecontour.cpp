@@ -29,17 +29,112 @@
 
 #include <modules/base/algorithm/image/imagecontour.h>
 
+#include <unordered_map>
+
 namespace inviwo {
 
 std::shared_ptr<Mesh> ImageContour::apply(const LayerRepresentation *in, size_t channel,
                                           double isoValue, vec4 color) {
+    return apply(in, channel, std::vector<double>{isoValue}, std::vector<vec4>{color});
+}
+
+std::shared_ptr<Mesh> ImageContour::apply(const LayerRepresentation *in, size_t channel,
+                                          const std::vector<double> &isoValues,
+                                          const std::vector<vec4> &colors) {
     detail::ImageContourDispatcher disp;
     auto df = in->getDataFormat();
+    auto values = isoValues;
     if (df->getNumericType() != NumericType::Float) {
-        isoValue = df->getMin() + isoValue * (df->getMax() - df->getMin());
+        for (auto &isoValue : values) {
+            isoValue = df->getMin() + isoValue * (df->getMax() - df->getMin());
+        }
     }
     return dispatching::dispatch<std::shared_ptr<Mesh>, dispatching::filter::All>(
-        df->getId(), disp, in, channel, isoValue, color);
+        df->getId(), disp, in, channel, values, colors);
+}
+
+std::shared_ptr<Mesh> detail::assembleContours(
+    size2_t dim, const std::vector<std::vector<ContourSegment>> &segments,
+    const std::vector<vec4> &colors) {
+
+    auto mesh = std::make_shared<BasicMesh>();
+    if (dim.x < 2 || dim.y < 2) return mesh;
+
+    const vec3 scale{1.0f / static_cast<float>(dim.x - 1),
+                     1.0f / static_cast<float>(dim.y - 1), 1.0f};
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    std::vector<BasicMesh::Vertex> vertices;
+    for (size_t iso = 0; iso < segments.size(); ++iso) {
+        const auto &segs = segments[iso];
+        const vec4 color = colors.empty() ? vec4{1.0f} : colors[std::min(iso, colors.size() - 1)];
+
+        // The segments meeting at each edge, at most two
+        std::unordered_map<size_t, std::array<size_t, 2>> edgeSegments;
+        edgeSegments.reserve(segs.size());
+        for (size_t i = 0; i < segs.size(); ++i) {
+            for (auto &p : segs[i]) {
+                auto res = edgeSegments.try_emplace(p.edge, std::array<size_t, 2>{i, none});
+                if (!res.second) res.first->second[1] = i;
+            }
+        }
+
+        std::unordered_map<size_t, std::uint32_t> edgeVertex;
+        edgeVertex.reserve(edgeSegments.size());
+        const auto vertex = [&](const ContourPoint &p) {
+            auto res = edgeVertex.try_emplace(p.edge, static_cast<std::uint32_t>(vertices.size()));
+            if (res.second) {
+                const size_t index = p.edge / 2;
+                const vec3 a(index % dim.x, index / dim.x, 0);
+                const vec3 b = a + (p.edge % 2 == 0 ? vec3{1, 0, 0} : vec3{0, 1, 0});
+                const vec3 pos = glm::mix(a, b, p.t) * scale;
+                vertices.emplace_back(pos, pos, pos, color);
+            }
+            return res.first->second;
+        };
+
+        std::vector<bool> visited(segs.size(), false);
+        // Follow the segments from the start edge until we reach a dead end or get back to the
+        // start. Returns true if the polyline is closed.
+        const auto walk = [&](size_t seg, size_t startEdge, std::vector<std::uint32_t> &indices) {
+            size_t edge = startEdge;
+            indices.push_back(vertex(segs[seg][segs[seg][0].edge == edge ? 0 : 1]));
+            while (seg != none && !visited[seg]) {
+                visited[seg] = true;
+                const auto &next = segs[seg][segs[seg][0].edge == edge ? 1 : 0];
+                edge = next.edge;
+                if (edge == startEdge) return true;
+                indices.push_back(vertex(next));
+                const auto &adjacent = edgeSegments[edge];
+                seg = adjacent[0] == seg ? adjacent[1] : adjacent[0];
+            }
+            return false;
+        };
+
+        // Open polylines start and end at edges with a single segment, at the borders
+        for (size_t i = 0; i < segs.size(); ++i) {
+            if (visited[i]) continue;
+            for (auto &p : segs[i]) {
+                if (visited[i] || edgeSegments[p.edge][1] != none) continue;
+                std::vector<std::uint32_t> indices;
+                walk(i, p.edge, indices);
+                mesh->addIndices(Mesh::MeshInfo{DrawType::Lines, ConnectivityType::Strip},
+                                 util::makeIndexBuffer(std::move(indices)));
+            }
+        }
+        // The rest are closed loops
+        for (size_t i = 0; i < segs.size(); ++i) {
+            if (visited[i]) continue;
+            std::vector<std::uint32_t> indices;
+            const auto ct = walk(i, segs[i][0].edge, indices) ? ConnectivityType::Loop
+                                                               : ConnectivityType::Strip;
+            mesh->addIndices(Mesh::MeshInfo{DrawType::Lines, ct},
+                             util::makeIndexBuffer(std::move(indices)));
+        }
+    }
+    mesh->addVertices(vertices);
+
+    return mesh;
 }
 
 }  // namespace inviwo
@@ -0,0 +1,72 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/image/renderbufferram.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace util {
+
+RenderBufferRAM::RenderBufferRAM(size2_t dims, vec4 clearColor, float clearDepth)
+    : dims{dims}, color(dims.x * dims.y, clearColor), depth(dims.x * dims.y, clearDepth) {}
+
+RenderBufferRAM::RenderBufferRAM(const Image& image)
+    : dims{image.getDimensions()}, color(dims.x * dims.y), depth(dims.x * dims.y) {
+    image.getColorLayer()->getRepresentation<LayerRAM>()->readRegion(
+        size2_t{0}, dims, color.data(), util::ValueConversion::Normalized);
+    image.getDepthLayer()->getRepresentation<LayerRAM>()->readRegion(size2_t{0}, dims,
+                                                                     depth.data());
+}
+
+void RenderBufferRAM::clear(vec4 clearColor, float clearDepth) {
+    std::fill(color.begin(), color.end(), clearColor);
+    std::fill(depth.begin(), depth.end(), clearDepth);
+}
+
+std::shared_ptr<Image> RenderBufferRAM::toImage(const DataFormatBase* colorFormat) const {
+    auto image = std::make_shared<Image>(dims, colorFormat);
+
+    std::vector<vec4> clamped(color.size());
+    std::transform(color.begin(), color.end(), clamped.begin(),
+                   [](const vec4& c) { return glm::clamp(c, vec4{0.0f}, vec4{1.0f}); });
+    image->getColorLayer()->getEditableRepresentation<LayerRAM>()->writeRegion(
+        size2_t{0}, dims, clamped.data(), util::ValueConversion::Normalized);
+    image->getDepthLayer()->getEditableRepresentation<LayerRAM>()->writeRegion(size2_t{0}, dims,
+                                                                               depth.data());
+    return image;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
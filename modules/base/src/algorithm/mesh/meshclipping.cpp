@@ -31,8 +31,13 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -147,52 +152,122 @@ void removeDuplicateEdges(std::vector<glm::u32vec2>& cuts, const std::vector<vec
 
 std::vector<std::vector<std::uint32_t>> gatherLoops(std::vector<glm::u32vec2>& edges,
                                                     const std::vector<vec3>& positions, float eps) {
-    std::vector<std::vector<std::uint32_t>> loops;
-
-    auto findMatch = [eps, &positions](std::vector<glm::u32vec2>& edges, std::uint32_t index) {
-        const auto it1 = std::find_if(edges.begin(), edges.end(), [&](glm::u32vec2 edge) {
-            return glm::all(glm::equal(positions[edge[0]], positions[index], eps));
-        });
-
-        if (it1 != edges.end()) {
-            return std::make_tuple(it1, (*it1)[1]);
+    // Weld the end points that are within eps of each other, using a hash grid with cells of size
+    // eps, so that the loops can be followed by index instead of searching all edges by position.
+    std::vector<std::uint32_t> points;
+    points.reserve(2 * edges.size());
+    for (auto edge : edges) {
+        points.push_back(edge[0]);
+        points.push_back(edge[1]);
+    }
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+    std::vector<std::uint32_t> weld(points.size());
+    std::iota(weld.begin(), weld.end(), 0);
+    const auto find = [&](std::uint32_t i) {
+        while (weld[i] != i) {
+            weld[i] = weld[weld[i]];
+            i = weld[i];
         }
-        const auto it2 = std::find_if(edges.begin(), edges.end(), [&](glm::u32vec2 edge) {
-            return glm::all(glm::equal(positions[edge[1]], positions[index], eps));
-        });
+        return i;
+    };
 
-        if (it2 != edges.end()) {
-            return std::make_tuple(it2, (*it2)[0]);
+    const double cellSize = eps > 0.0f ? static_cast<double>(eps) : 1.0;
+    const auto cellKey = [](std::int64_t x, std::int64_t y, std::int64_t z) {
+        std::uint64_t h = static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<std::uint64_t>(y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= static_cast<std::uint64_t>(z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        return h;
+    };
+    std::unordered_multimap<std::uint64_t, std::uint32_t> grid;
+    grid.reserve(points.size());
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(points.size()); ++i) {
+        const auto& p = positions[points[i]];
+        std::array<std::int64_t, 3> cell;
+        for (int k = 0; k < 3; ++k) {
+            cell[k] = static_cast<std::int64_t>(std::floor(static_cast<double>(p[k]) / cellSize));
         }
+        for (std::int64_t dz = -1; dz <= 1; ++dz) {
+            for (std::int64_t dy = -1; dy <= 1; ++dy) {
+                for (std::int64_t dx = -1; dx <= 1; ++dx) {
+                    const auto range =
+                        grid.equal_range(cellKey(cell[0] + dx, cell[1] + dy, cell[2] + dz));
+                    for (auto it = range.first; it != range.second; ++it) {
+                        if (glm::all(glm::equal(p, positions[points[it->second]], eps))) {
+                            weld[find(i)] = find(it->second);
+                        }
+                    }
+                }
+            }
+        }
+        grid.emplace(cellKey(cell[0], cell[1], cell[2]), i);
+    }
 
-        return std::make_tuple(edges.end(), uint32_t{0});
+    const auto welded = [&](std::uint32_t index) {
+        return find(static_cast<std::uint32_t>(
+            std::lower_bound(points.begin(), points.end(), index) - points.begin()));
     };
 
-    while (!edges.empty()) {
+    // Adjacency from welded points to edges, edges that collapse to a point are dropped
+    std::vector<glm::u32vec2> weldedEdges(edges.size());
+    std::vector<char> used(edges.size(), 0);
+    std::vector<std::uint32_t> offsets(points.size() + 1, 0);
+    size_t remaining = 0;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        weldedEdges[i] = glm::u32vec2{welded(edges[i][0]), welded(edges[i][1])};
+        if (weldedEdges[i][0] == weldedEdges[i][1]) {
+            used[i] = 1;
+        } else {
+            ++offsets[weldedEdges[i][0] + 1];
+            ++offsets[weldedEdges[i][1] + 1];
+            ++remaining;
+        }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::uint32_t> adjacency(offsets.back());
+    {
+        std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(edges.size()); ++i) {
+            if (used[i]) continue;
+            adjacency[cursor[weldedEdges[i][0]]++] = i;
+            adjacency[cursor[weldedEdges[i][1]]++] = i;
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> loops;
+    for (size_t i = edges.size(); i-- > 0;) {
+        if (used[i]) continue;
+        used[i] = 1;
+        --remaining;
+
         auto& loop = loops.emplace_back();
-        loop.push_back(edges.back()[0]);
-        loop.push_back(edges.back()[1]);
-        edges.pop_back();
-
-        while (!edges.empty()) {
-            const auto [it, index] = findMatch(edges, loop.back());
-            if (it != edges.end()) {
-                if (glm::all(glm::equal(positions[index], positions[loop.front()], eps))) {
-                    edges.erase(it);
-                    break;
-                } else {
-                    loop.push_back(index);
-                    edges.erase(it);
-                }
-            } else {
+        loop.push_back(edges[i][0]);
+        loop.push_back(edges[i][1]);
+        const auto start = weldedEdges[i][0];
+        auto current = weldedEdges[i][1];
+
+        while (remaining > 0) {
+            const auto begin = adjacency.begin() + offsets[current];
+            const auto end = adjacency.begin() + offsets[current + 1];
+            const auto it = std::find_if(begin, end, [&](std::uint32_t e) { return !used[e]; });
+            if (it == end) {
                 LogWarnCustom(
                     "MeshClipping",
                     "Found edge, that is not connected to any other edge. This could mean, the "
                     "clipped mesh was not manifold.");
                 break;
             }
+            used[*it] = 1;
+            --remaining;
+
+            const auto next = weldedEdges[*it][0] == current ? 1 : 0;
+            if (weldedEdges[*it][next] == start) break;
+            loop.push_back(edges[*it][next]);
+            current = weldedEdges[*it][next];
         }
     }
+    edges.clear();
     return loops;
 }
 
@@ -303,11 +378,147 @@ void capHoles(std::vector<glm::u32vec2>& edges, const Plane& plane,
     }
 }
 
+/**
+ * A new vertex on the edge between v1 and v2, at weight from v1 towards v2
+ */
+struct EdgeSplit {
+    std::uint32_t v1;
+    std::uint32_t v2;
+    float weight;
+};
+
+/**
+ * Appends one interpolated vertex per split to the output buffers
+ */
+using InterpolateEdgesFunctor = std::function<void(const std::vector<EdgeSplit>&)>;
+
+/*
+ * Clip triangles in two passes over blocks of triangles in parallel. The first pass classifies
+ * the triangles, counting the output triangles and collecting the edges that cross the plane.
+ * Each crossing edge is then split once and the new vertex is shared by the triangles on both
+ * sides of it. The second pass writes the clipped triangles and the cut edges of each block at
+ * precomputed offsets, so the output is the same as when clipping the triangles in order.
+ */
+template <typename GetTriangle>
+std::vector<glm::u32vec2> clipTriangles(size_t nTriangles, GetTriangle getTriangle,
+                                        const std::vector<char>& inside, const Plane& plane,
+                                        const std::vector<vec3>& positions,
+                                        const InterpolateEdgesFunctor& interpolateEdges,
+                                        std::vector<std::uint32_t>& outIndices) {
+    constexpr size_t blockSize = 4096;
+    const size_t nBlocks = (nTriangles + blockSize - 1) / blockSize;
+    const auto forEachBlock = [&](auto&& callback) {
+        util::forEachRangeParallel(nBlocks, [&](size_t first, size_t last) {
+            for (size_t block = first; block < last; ++block) {
+                callback(block, block * blockSize, std::min(nTriangles, (block + 1) * blockSize));
+            }
+        });
+    };
+    const auto edgeKey = [](std::uint32_t a, std::uint32_t b) {
+        return a < b ? (std::uint64_t{a} << 32) | b : (std::uint64_t{b} << 32) | a;
+    };
+
+    // Classify
+    std::vector<size_t> triangleOffsets(nBlocks + 1, 0);
+    std::vector<std::vector<std::uint64_t>> blockEdges(nBlocks);
+    forEachBlock([&](size_t block, size_t begin, size_t end) {
+        size_t count = 0;
+        auto& edges = blockEdges[block];
+        for (size_t t = begin; t < end; ++t) {
+            const auto triangle = getTriangle(t);
+            const auto nInside = inside[triangle[0]] + inside[triangle[1]] + inside[triangle[2]];
+            if (nInside == 3) {
+                ++count;
+            } else if (nInside > 0) {
+                // One vertex inside gives one triangle, two vertices inside give two
+                count += nInside;
+                for (size_t i = 0; i < 3; ++i) {
+                    const auto i1 = triangle[i];
+                    const auto i2 = triangle[(i + 1) % 3];
+                    if (inside[i1] != inside[i2]) edges.push_back(edgeKey(i1, i2));
+                }
+            }
+        }
+        triangleOffsets[block + 1] = count;
+    });
+    std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+
+    // Split each crossing edge once, in order of first appearance
+    const auto nVertices = static_cast<std::uint32_t>(positions.size());
+    std::unordered_map<std::uint64_t, std::uint32_t> splitIndex;
+    std::vector<EdgeSplit> splits;
+    std::vector<size_t> cutOffsets(nBlocks + 1, 0);
+    for (size_t block = 0; block < nBlocks; ++block) {
+        for (auto key : blockEdges[block]) {
+            const auto index = nVertices + static_cast<std::uint32_t>(splits.size());
+            if (splitIndex.try_emplace(key, index).second) {
+                splits.push_back({static_cast<std::uint32_t>(key >> 32),
+                                  static_cast<std::uint32_t>(key & 0xffffffffu), 0.0f});
+            }
+        }
+        // Each triangle crossing the plane has two crossing edges and one cut edge
+        cutOffsets[block + 1] = cutOffsets[block] + blockEdges[block].size() / 2;
+        blockEdges[block] = std::vector<std::uint64_t>{};
+    }
+    util::forEachRangeParallel(splits.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            auto& split = splits[i];
+            const auto weight =
+                plane.getIntersectionWeight(positions[split.v1], positions[split.v2]);
+            split.weight = weight.value_or(0.0f);
+        }
+    });
+    interpolateEdges(splits);
+
+    // Emit, using the same polygon construction as sutherlandHodgman
+    const auto offset = outIndices.size();
+    outIndices.resize(offset + 3 * triangleOffsets.back());
+    std::vector<glm::u32vec2> cuts(cutOffsets.back());
+    forEachBlock([&](size_t block, size_t begin, size_t end) {
+        auto out = outIndices.begin() + offset + 3 * triangleOffsets[block];
+        auto cut = cuts.begin() + cutOffsets[block];
+        for (size_t t = begin; t < end; ++t) {
+            const auto triangle = getTriangle(t);
+            std::array<std::uint32_t, 4> polygon;
+            size_t nPolygon = 0;
+            std::array<std::uint32_t, 2> cutEdge;
+            size_t nCutEdge = 0;
+
+            for (size_t i = 0; i < 3; ++i) {
+                const auto i1 = triangle[i];
+                const auto i2 = triangle[(i + 1) % 3];
+                if (inside[i1] && inside[i2]) {
+                    polygon[nPolygon++] = i2;
+                } else if (inside[i1] || inside[i2]) {
+                    const auto split = splitIndex.find(edgeKey(i1, i2))->second;
+                    polygon[nPolygon++] = split;
+                    cutEdge[nCutEdge++] = split;
+                    if (inside[i2]) polygon[nPolygon++] = i2;
+                }
+            }
+            if (nPolygon >= 3) {
+                *out++ = polygon[0];
+                *out++ = polygon[1];
+                *out++ = polygon[2];
+            }
+            if (nPolygon == 4) {
+                *out++ = polygon[0];
+                *out++ = polygon[2];
+                *out++ = polygon[3];
+            }
+            if (nCutEdge == 2) *cut++ = glm::u32vec2{cutEdge[0], cutEdge[1]};
+        }
+    });
+    return cuts;
+}
+
 std::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
                                       std::shared_ptr<Mesh>& clippedMesh,
                                       const std::vector<uint32_t>& indices, const Plane& plane,
                                       const std::vector<vec3>& positions,
-                                      const InterpolateFunctor& addInterpolatedVertex) {
+                                      const std::vector<char>& inside,
+                                      const InterpolateFunctor& addInterpolatedVertex,
+                                      const InterpolateEdgesFunctor& interpolateEdges) {
 
     std::vector<glm::u32vec2> newEdges;
 
@@ -432,22 +643,20 @@ std::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
         auto outIndices = clippedMesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
 
         if (meshInfo.ct == ConnectivityType::Strip) {
-            for (unsigned int t = 0; t < indices.size() - 2; ++t) {
-                const glm::u32vec3 triangle{indices[t], indices[t & 1 ? t + 2 : t + 1],
-                                            indices[t & 1 ? t + 1 : t + 2]};
-                auto newEdge = detail::sutherlandHodgman(triangle, plane, positions,
-                                                         outIndices->getDataContainer(),
-                                                         addInterpolatedVertex);
-                if (newEdge) newEdges.push_back(*newEdge);
-            }
+            newEdges = clipTriangles(
+                indices.size() - 2,
+                [&](size_t t) {
+                    return glm::u32vec3{indices[t], indices[t & 1 ? t + 2 : t + 1],
+                                        indices[t & 1 ? t + 1 : t + 2]};
+                },
+                inside, plane, positions, interpolateEdges, outIndices->getDataContainer());
         } else if (meshInfo.ct == ConnectivityType::None) {
-            for (unsigned int t = 0; t < indices.size() - 2; t += 3) {
-                const glm::u32vec3 triangle{indices[t], indices[t + 1], indices[t + 2]};
-                auto newEdge = detail::sutherlandHodgman(triangle, plane, positions,
-                                                         outIndices->getDataContainer(),
-                                                         addInterpolatedVertex);
-                if (newEdge) newEdges.push_back(*newEdge);
-            }
+            newEdges = clipTriangles(
+                indices.size() / 3,
+                [&](size_t t) {
+                    return glm::u32vec3{indices[3 * t], indices[3 * t + 1], indices[3 * t + 2]};
+                },
+                inside, plane, positions, interpolateEdges, outIndices->getDataContainer());
         } else {
             throw Exception("Cannot clip, need triangle connectivity Strip or None",
                             IVW_CONTEXT_CUSTOM("MeshClipping"));
@@ -470,66 +679,89 @@ std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh, const Plane& worldS
     clippedMesh->copyMetaDataFrom(mesh);
 
     std::vector<detail::InterpolateFunctor> interpolateFunctors;
+    std::vector<detail::InterpolateEdgesFunctor> interpolateEdgesFunctors;
     std::shared_ptr<BufferRAMPrecision<vec3, BufferTarget::Data>> posBuffer;
 
+    using Functors = std::pair<detail::InterpolateFunctor, detail::InterpolateEdgesFunctor>;
     for (const auto& item : mesh.getBuffers()) {
         const auto& bufferType = item.first;
         const auto& inBuffer = item.second;
-        auto functor =
-            inBuffer->getRepresentation<BufferRAM>()->dispatch<detail::InterpolateFunctor>(
-                [&clippedMesh, bufferType, &posBuffer](auto inRam) -> detail::InterpolateFunctor {
-                    using PB = util::PrecisionType<decltype(inRam)>;
-                    using ValueType = util::PrecisionValueType<decltype(inRam)>;
-                    using T = typename util::same_extent<ValueType, float>::type;
-
-                    static const auto mix = [](const PB& buffer,
-                                               const std::vector<uint32_t>& indices,
-                                               const std::vector<float>& weights) {
-                        return static_cast<ValueType>(std::inner_product(
-                            indices.begin(), indices.end(), weights.begin(), T{0}, std::plus<>{},
-                            [&](uint32_t index, float weight) {
-                                return static_cast<T>(buffer[index]) * weight;
-                            }));
-                    };
-                    (void)mix;
-
-                    auto outRam =
-                        std::make_shared<BufferRAMPrecision<ValueType, PB::target>>(*inRam);
-                    auto outBuffer = std::make_shared<Buffer<ValueType, PB::target>>(outRam);
-                    clippedMesh->addBuffer(bufferType, outBuffer);
-
-                    if constexpr (std::is_same_v<ValueType, vec3> &&
-                                  PB::target == BufferTarget::Data) {
-                        if (bufferType == BufferType::NormalAttrib) {
-                            return [outRam](const std::vector<uint32_t>& indices,
-                                            const std::vector<float>& weights,
-                                            std::optional<vec3> normal) {
-                                outRam->add(normal ? *normal : mix(*outRam, indices, weights));
-                                return static_cast<uint32_t>(outRam->getSize() - 1);
-                            };
-                        } else if (bufferType == BufferType::PositionAttrib) {
-                            posBuffer = outRam;
+        auto functors = inBuffer->getRepresentation<BufferRAM>()->dispatch<Functors>(
+            [&clippedMesh, bufferType, &posBuffer](auto inRam) -> Functors {
+                using PB = util::PrecisionType<decltype(inRam)>;
+                using ValueType = util::PrecisionValueType<decltype(inRam)>;
+                using T = typename util::same_extent<ValueType, float>::type;
+
+                static const auto mix = [](const PB& buffer, const std::vector<uint32_t>& indices,
+                                           const std::vector<float>& weights) {
+                    return static_cast<ValueType>(std::inner_product(
+                        indices.begin(), indices.end(), weights.begin(), T{0}, std::plus<>{},
+                        [&](uint32_t index, float weight) {
+                            return static_cast<T>(buffer[index]) * weight;
+                        }));
+                };
+                (void)mix;
+
+                auto outRam = std::make_shared<BufferRAMPrecision<ValueType, PB::target>>(*inRam);
+                auto outBuffer = std::make_shared<Buffer<ValueType, PB::target>>(outRam);
+                clippedMesh->addBuffer(bufferType, outBuffer);
+
+                // Floating types use linear interpolation, integer types use nearest.
+                const auto interpolateEdges = [outRam](const auto& splits) {
+                    auto& data = outRam->getDataContainer();
+                    const auto offset = data.size();
+                    data.resize(offset + splits.size());
+                    util::forEachRangeParallel(splits.size(), [&](size_t first, size_t last) {
+                        for (size_t i = first; i < last; ++i) {
+                            const auto& split = splits[i];
+                            if constexpr (DataFormat<ValueType>::numtype == NumericType::Float) {
+                                data[offset + i] = static_cast<ValueType>(
+                                    T{0} + static_cast<T>(data[split.v1]) * (1.0f - split.weight) +
+                                    static_cast<T>(data[split.v2]) * split.weight);
+                            } else {
+                                data[offset + i] =
+                                    data[1.0f - split.weight >= split.weight ? split.v1
+                                                                             : split.v2];
+                            }
                         }
+                    });
+                };
+
+                if constexpr (std::is_same_v<ValueType, vec3> && PB::target == BufferTarget::Data) {
+                    if (bufferType == BufferType::NormalAttrib) {
+                        return {[outRam](const std::vector<uint32_t>& indices,
+                                         const std::vector<float>& weights,
+                                         std::optional<vec3> normal) {
+                                    outRam->add(normal ? *normal : mix(*outRam, indices, weights));
+                                    return static_cast<uint32_t>(outRam->getSize() - 1);
+                                },
+                                interpolateEdges};
+                    } else if (bufferType == BufferType::PositionAttrib) {
+                        posBuffer = outRam;
                     }
+                }
 
-                    if constexpr (DataFormat<ValueType>::numtype == NumericType::Float) {
-                        return [outRam](const std::vector<uint32_t>& indices,
-                                        const std::vector<float>& weights, std::optional<vec3>) {
-                            outRam->add(mix(*outRam, indices, weights));
-                            return static_cast<uint32_t>(outRam->getSize() - 1);
-                        };
-                    } else {  // Only interpolate floating point buffers;
-                        return [outRam](const std::vector<uint32_t>& indices,
-                                        const std::vector<float>& weights, std::optional<vec3>) {
-                            const auto it = std::max_element(weights.begin(), weights.end());
-                            const auto index = std::distance(weights.begin(), it);
-
-                            outRam->add(static_cast<ValueType>((*outRam)[indices[index]]));
-                            return static_cast<uint32_t>(outRam->getSize() - 1);
-                        };
-                    }
-                });
-        interpolateFunctors.push_back(functor);
+                if constexpr (DataFormat<ValueType>::numtype == NumericType::Float) {
+                    return {[outRam](const std::vector<uint32_t>& indices,
+                                     const std::vector<float>& weights, std::optional<vec3>) {
+                                outRam->add(mix(*outRam, indices, weights));
+                                return static_cast<uint32_t>(outRam->getSize() - 1);
+                            },
+                            interpolateEdges};
+                } else {  // Only interpolate floating point buffers;
+                    return {[outRam](const std::vector<uint32_t>& indices,
+                                     const std::vector<float>& weights, std::optional<vec3>) {
+                                const auto it = std::max_element(weights.begin(), weights.end());
+                                const auto index = std::distance(weights.begin(), it);
+
+                                outRam->add(static_cast<ValueType>((*outRam)[indices[index]]));
+                                return static_cast<uint32_t>(outRam->getSize() - 1);
+                            },
+                            interpolateEdges};
+                }
+            });
+        interpolateFunctors.push_back(functors.first);
+        interpolateEdgesFunctors.push_back(functors.second);
     }
 
     const detail::InterpolateFunctor addInterpolatedVertex =
@@ -540,6 +772,10 @@ std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh, const Plane& worldS
         for (auto& fun : interpolateFunctors) res = fun(indices, weights, normal);
         return res;
     };
+    const detail::InterpolateEdgesFunctor interpolateEdges =
+        [&interpolateEdgesFunctors](const std::vector<detail::EdgeSplit>& splits) {
+            for (auto& fun : interpolateEdgesFunctors) fun(splits);
+        };
 
     if (!posBuffer) {
         throw Exception("Unsupported mesh type, vec3 position buffer not found",
@@ -547,6 +783,13 @@ std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh, const Plane& worldS
     }
 
     const auto& positions = posBuffer->getDataContainer();
+
+    // All index buffers refer to the vertices of the input mesh, classify them once
+    std::vector<char> inside(positions.size());
+    util::forEachRangeParallel(positions.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) inside[i] = plane.isInside(positions[i]);
+    });
+
     std::vector<glm::u32vec2> newEdges;
 
     for (const auto& item : mesh.getIndexBuffers()) {
@@ -554,16 +797,16 @@ std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh, const Plane& worldS
         const auto indexBuffer = item.second;
         const auto& indices = indexBuffer->getRAMRepresentation()->getDataContainer();
 
-        auto edges = detail::clipIndices(meshInfo, clippedMesh, indices, plane, positions,
-                                         addInterpolatedVertex);
+        auto edges = detail::clipIndices(meshInfo, clippedMesh, indices, plane, positions, inside,
+                                         addInterpolatedVertex, interpolateEdges);
         newEdges.insert(newEdges.end(), edges.begin(), edges.end());
     }
     if (mesh.getIndexBuffers().empty()) {
         const auto meshInfo = mesh.getDefaultMeshInfo();
         std::vector<uint32_t> indices(mesh.getBuffer(0)->getSize());
         std::iota(indices.begin(), indices.end(), 0);
-        auto edges = detail::clipIndices(meshInfo, clippedMesh, indices, plane, positions,
-                                         addInterpolatedVertex);
+        auto edges = detail::clipIndices(meshInfo, clippedMesh, indices, plane, positions, inside,
+                                         addInterpolatedVertex, interpolateEdges);
         newEdges.insert(newEdges.end(), edges.begin(), edges.end());
     }
 
@@ -0,0 +1,310 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/mesh/meshrasterization.h>
+#include <inviwo/core/datastructures/camera/camera.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+struct Vertex {
+    vec4 clip;
+    vec4 color;
+};
+
+struct Triangle {
+    std::array<vec3, 3> screen;  ///< x and y in pixels, z is the depth in [0,1]
+    vec3 invW;
+    std::array<vec4, 3> color;
+    float area;
+    size2_t min;  ///< First pixel of the bounding box
+    size2_t max;  ///< One past the last pixel of the bounding box
+};
+
+template <typename T>
+std::vector<T> getAttribute(const BufferBase& buffer, ValueConversion conversion) {
+    return buffer.getRepresentation<BufferRAM>()->dispatch<std::vector<T>>([&](auto br) {
+        const auto& data = br->getDataContainer();
+        std::vector<T> res(data.size());
+        glm_convert_n(data.data(), data.size(), res.data(), conversion);
+        return res;
+    });
+}
+
+std::vector<Vertex> transformVertices(const Mesh& mesh, const mat4& viewProj,
+                                      const vec3& lightDir,
+                                      const MeshRasterizationSettings& settings) {
+    const auto positionBuffer = mesh.findBuffer(BufferType::PositionAttrib).first;
+    if (!positionBuffer) return {};
+    const auto positions = getAttribute<vec3>(*positionBuffer, ValueConversion::Plain);
+
+    std::vector<vec4> colors;
+    if (const auto colorBuffer = mesh.findBuffer(BufferType::ColorAttrib).first) {
+        colors = getAttribute<vec4>(*colorBuffer, ValueConversion::Normalized);
+        if (colorBuffer->getDataFormat()->getComponents() < 4) {
+            for (auto& c : colors) c.a = 1.0f;
+        }
+    }
+    std::vector<vec3> normals;
+    if (settings.shading) {
+        if (const auto normalBuffer = mesh.findBuffer(BufferType::NormalAttrib).first) {
+            normals = getAttribute<vec3>(*normalBuffer, ValueConversion::Plain);
+        }
+    }
+
+    const mat4 model = mesh.getCoordinateTransformer().getDataToWorldMatrix();
+    const mat4 mvp = viewProj * model;
+    const mat3 normalMatrix = glm::transpose(glm::inverse(mat3(model)));
+
+    std::vector<Vertex> vertices(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        auto& v = vertices[i];
+        v.clip = mvp * vec4(positions[i], 1.0f);
+        v.color = i < colors.size() ? colors[i] : settings.defaultColor;
+        if (i < normals.size()) {
+            const auto n = normalMatrix * normals[i];
+            const auto len = glm::length(n);
+            const float diffuse = len > 0.0f ? std::abs(glm::dot(n / len, lightDir)) : 1.0f;
+            v.color = vec4(vec3(v.color) * (settings.ambient + (1.0f - settings.ambient) * diffuse),
+                           v.color.a);
+        }
+    }
+    return vertices;
+}
+
+template <typename Callback>
+void forEachTriangle(ConnectivityType ct, const std::vector<std::uint32_t>& ind,
+                     Callback callback) {
+    const auto size = ind.size();
+    switch (ct) {
+        case ConnectivityType::None:
+            for (size_t i = 0; i + 2 < size; i += 3) callback(ind[i], ind[i + 1], ind[i + 2]);
+            break;
+        case ConnectivityType::Strip:
+            for (size_t i = 0; i + 2 < size; ++i) callback(ind[i], ind[i + 1], ind[i + 2]);
+            break;
+        case ConnectivityType::Fan:
+            for (size_t i = 1; i + 1 < size; ++i) callback(ind[0], ind[i], ind[i + 1]);
+            break;
+        case ConnectivityType::Adjacency:
+            for (size_t i = 0; i + 5 < size; i += 6) callback(ind[i], ind[i + 2], ind[i + 4]);
+            break;
+        case ConnectivityType::StripAdjacency:
+            for (size_t i = 0; i + 4 < size; i += 2) callback(ind[i], ind[i + 2], ind[i + 4]);
+            break;
+        case ConnectivityType::Loop:
+        case ConnectivityType::NumberOfConnectivityTypes:
+        default:
+            break;
+    }
+}
+
+/**
+ * Clip the triangle against the near plane, z >= -w, in clip space. Returns the number of
+ * vertices of the resulting convex polygon, 0, 3, or 4.
+ */
+size_t clipNear(const std::array<Vertex, 3>& in, std::array<Vertex, 4>& out) {
+    size_t n = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& a = in[i];
+        const auto& b = in[(i + 1) % 3];
+        const float da = a.clip.z + a.clip.w;
+        const float db = b.clip.z + b.clip.w;
+        if (da >= 0.0f) out[n++] = a;
+        if ((da >= 0.0f) != (db >= 0.0f)) {
+            const float t = da / (da - db);
+            out[n++] = Vertex{glm::mix(a.clip, b.clip, t), glm::mix(a.color, b.color, t)};
+        }
+    }
+    return n;
+}
+
+float edge(const vec3& a, const vec3& b, const vec2& p) {
+    return (p.x - a.x) * (b.y - a.y) - (p.y - a.y) * (b.x - a.x);
+}
+
+void setupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, size2_t dims,
+                   std::vector<Triangle>& triangles) {
+    Triangle tri;
+    const std::array<const Vertex*, 3> vertices{&v0, &v1, &v2};
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& clip = vertices[i]->clip;
+        if (clip.w <= 0.0f) return;
+        const float invW = 1.0f / clip.w;
+        const vec3 ndc = vec3(clip) * invW;
+        tri.screen[i] = vec3((ndc.x * 0.5f + 0.5f) * static_cast<float>(dims.x),
+                             (ndc.y * 0.5f + 0.5f) * static_cast<float>(dims.y),
+                             ndc.z * 0.5f + 0.5f);
+        tri.invW[i] = invW;
+        tri.color[i] = vertices[i]->color;
+    }
+
+    tri.area = edge(tri.screen[0], tri.screen[1], vec2(tri.screen[2]));
+    if (!std::isfinite(tri.area) || tri.area == 0.0f) return;
+    if (tri.area < 0.0f) {
+        std::swap(tri.screen[1], tri.screen[2]);
+        std::swap(tri.invW[1], tri.invW[2]);
+        std::swap(tri.color[1], tri.color[2]);
+        tri.area = -tri.area;
+    }
+
+    const auto lower = glm::min(glm::min(vec2(tri.screen[0]), vec2(tri.screen[1])),
+                                vec2(tri.screen[2]));
+    const auto upper = glm::max(glm::max(vec2(tri.screen[0]), vec2(tri.screen[1])),
+                                vec2(tri.screen[2]));
+    const auto screen = vec2(dims);
+    if (upper.x <= 0.0f || upper.y <= 0.0f || lower.x >= screen.x || lower.y >= screen.y) return;
+
+    tri.min = size2_t(glm::max(glm::floor(lower), vec2(0.0f)));
+    tri.max = size2_t(glm::min(glm::ceil(upper), screen));
+    if (tri.min.x >= tri.max.x || tri.min.y >= tri.max.y) return;
+
+    triangles.push_back(tri);
+}
+
+void rasterizeTriangles(const std::vector<Triangle>& triangles, RenderBufferRAM& target,
+                        size2_t tileSize) {
+    const auto tile = glm::max(tileSize, size2_t{1});
+    const auto tiles = (target.dims + tile - size2_t{1}) / tile;
+
+    std::vector<std::vector<std::uint32_t>> bins(tiles.x * tiles.y);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        const auto first = triangles[t].min / tile;
+        const auto last = (triangles[t].max - size2_t{1}) / tile;
+        for (size_t y = first.y; y <= last.y; ++y) {
+            for (size_t x = first.x; x <= last.x; ++x) {
+                bins[x + y * tiles.x].push_back(static_cast<std::uint32_t>(t));
+            }
+        }
+    }
+
+    forEachPixelTileParallel(
+        target.dims,
+        [&](size2_t begin, size2_t end) {
+            const auto tileIndex = begin / tile;
+            for (auto t : bins[tileIndex.x + tileIndex.y * tiles.x]) {
+                const auto& tri = triangles[t];
+                const auto from = glm::max(begin, tri.min);
+                const auto to = glm::min(end, tri.max);
+                for (size_t y = from.y; y < to.y; ++y) {
+                    for (size_t x = from.x; x < to.x; ++x) {
+                        const vec2 p{static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f};
+                        const vec3 w{edge(tri.screen[1], tri.screen[2], p),
+                                     edge(tri.screen[2], tri.screen[0], p),
+                                     edge(tri.screen[0], tri.screen[1], p)};
+                        if (w.x < 0.0f || w.y < 0.0f || w.z < 0.0f) continue;
+
+                        const vec3 b = w / tri.area;
+                        const float z = b.x * tri.screen[0].z + b.y * tri.screen[1].z +
+                                        b.z * tri.screen[2].z;
+                        const auto i = target.index(size2_t{x, y});
+                        if (z < 0.0f || z > 1.0f || z >= target.depth[i]) continue;
+
+                        const vec3 pb = b * tri.invW;
+                        target.color[i] = (pb.x * tri.color[0] + pb.y * tri.color[1] +
+                                           pb.z * tri.color[2]) /
+                                          (pb.x + pb.y + pb.z);
+                        target.depth[i] = z;
+                    }
+                }
+            }
+        },
+        tile);
+}
+
+void rasterize(const std::vector<const Mesh*>& meshes, const Camera& camera,
+               RenderBufferRAM& target, const MeshRasterizationSettings& settings) {
+    if (target.dims.x == 0 || target.dims.y == 0) return;
+
+    const mat4 viewProj = camera.getProjectionMatrix() * camera.getViewMatrix();
+    const auto dir = camera.getDirection();
+    const vec3 lightDir = glm::length(dir) > 0.0f ? glm::normalize(dir) : vec3(0.0f, 0.0f, -1.0f);
+
+    std::vector<Triangle> triangles;
+    for (const auto mesh : meshes) {
+        const auto vertices = transformVertices(*mesh, viewProj, lightDir, settings);
+        if (vertices.empty()) continue;
+
+        const auto triangle = [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+            if (a >= vertices.size() || b >= vertices.size() || c >= vertices.size()) return;
+            std::array<Vertex, 4> polygon;
+            const auto n = clipNear({vertices[a], vertices[b], vertices[c]}, polygon);
+            for (size_t i = 1; i + 1 < n; ++i) {
+                setupTriangle(polygon[0], polygon[i], polygon[i + 1], target.dims, triangles);
+            }
+        };
+
+        if (mesh->getNumberOfIndicies() == 0) {
+            const auto info = mesh->getDefaultMeshInfo();
+            if (info.dt != DrawType::Triangles) continue;
+            std::vector<std::uint32_t> sequential(vertices.size());
+            std::iota(sequential.begin(), sequential.end(), 0u);
+            forEachTriangle(info.ct, sequential, triangle);
+        } else {
+            for (const auto& [info, indices] : mesh->getIndexBuffers()) {
+                if (info.dt != DrawType::Triangles) continue;
+                forEachTriangle(info.ct, indices->getRAMRepresentation()->getDataContainer(),
+                                triangle);
+            }
+        }
+    }
+
+    rasterizeTriangles(triangles, target, settings.tileSize);
+}
+
+}  // namespace
+
+void rasterizeMeshes(const std::vector<std::shared_ptr<const Mesh>>& meshes, const Camera& camera,
+                     RenderBufferRAM& target, const MeshRasterizationSettings& settings) {
+    std::vector<const Mesh*> ptrs;
+    ptrs.reserve(meshes.size());
+    for (const auto& mesh : meshes) {
+        if (mesh) ptrs.push_back(mesh.get());
+    }
+    rasterize(ptrs, camera, target, settings);
+}
+
+void rasterizeMesh(const Mesh& mesh, const Camera& camera, RenderBufferRAM& target,
+                   const MeshRasterizationSettings& settings) {
+    rasterize({&mesh}, camera, target, settings);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
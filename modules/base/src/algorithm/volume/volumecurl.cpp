@@ -70,33 +70,38 @@ std::unique_ptr<Volume> curlVolume(const Volume& volume) {
 
         util::IndexMapper3D index(volume.getDimensions());
         auto data = newVolumeRep->getDataTyped();
-        float minV = std::numeric_limits<float>::max();
-        float maxV = std::numeric_limits<float>::lowest();
-
         const auto worldSpace = Sampler::Space::World;
         const Sampler sampler(volume, worldSpace);
 
-        util::forEachVoxel(*vol, [&](const size3_t& pos) {
-            const vec3 world{m * vec4(vec3(pos) / vec3(volume.getDimensions() - size3_t(1)), 1)};
-
-            const auto Fxp = static_cast<vec3>(sampler.sample(world + ox));
-            const auto Fxm = static_cast<vec3>(sampler.sample(world - ox));
-            const auto Fyp = static_cast<vec3>(sampler.sample(world + oy));
-            const auto Fym = static_cast<vec3>(sampler.sample(world - oy));
-            const auto Fzp = static_cast<vec3>(sampler.sample(world + oz));
-            const auto Fzm = static_cast<vec3>(sampler.sample(world - oz));
-
-            const vec3 Fx = (Fxp - Fxm) / (2.0f * spacing.x);
-            const vec3 Fy = (Fyp - Fym) / (2.0f * spacing.y);
-            const vec3 Fz = (Fzp - Fzm) / (2.0f * spacing.z);
-
-            const vec3 c{Fy.z - Fz.y, Fz.x - Fx.z, Fx.y - Fy.x};
-
-            minV = std::min({minV, c.x, c.y, c.z});
-            maxV = std::max({maxV, c.x, c.y, c.z});
-
-            data[index(pos)] = c;
-        });
+        const auto minMax = util::forEachVoxelParallelReduce(
+            *vol, vec2{std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()},
+            [&](const size3_t& pos, vec2& res) {
+                const vec3 world{
+                    m * vec4(vec3(pos) / vec3(volume.getDimensions() - size3_t(1)), 1)};
+
+                const auto Fxp = static_cast<vec3>(sampler.sample(world + ox));
+                const auto Fxm = static_cast<vec3>(sampler.sample(world - ox));
+                const auto Fyp = static_cast<vec3>(sampler.sample(world + oy));
+                const auto Fym = static_cast<vec3>(sampler.sample(world - oy));
+                const auto Fzp = static_cast<vec3>(sampler.sample(world + oz));
+                const auto Fzm = static_cast<vec3>(sampler.sample(world - oz));
+
+                const vec3 Fx = (Fxp - Fxm) / (2.0f * spacing.x);
+                const vec3 Fy = (Fyp - Fym) / (2.0f * spacing.y);
+                const vec3 Fz = (Fzp - Fzm) / (2.0f * spacing.z);
+
+                const vec3 c{Fy.z - Fz.y, Fz.x - Fx.z, Fx.y - Fy.x};
+
+                res.x = std::min({res.x, c.x, c.y, c.z});
+                res.y = std::max({res.y, c.x, c.y, c.z});
+
+                data[index(pos)] = c;
+            },
+            [](const vec2& a, const vec2& b) {
+                return vec2{std::min(a.x, b.x), std::max(a.y, b.y)};
+            });
+        const auto minV = minMax.x;
+        const auto maxV = minMax.y;
 
         auto range = std::max(std::abs(minV), std::abs(maxV));
         newVolume->dataMap_.dataRange = dvec2(-range, range);
@@ -0,0 +1,391 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumepyramid.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <mutex>
+#include <optional>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+/**
+ * Filter taps along one axis, the taps of output sample i are in the range [begin(i), end(i)).
+ * Each tap is an input index and a weight, the weights of each output sample sum to one.
+ */
+struct Taps {
+    Taps(size_t srcSize, size_t dstSize, DownsampleFilter filter) {
+        offsets.reserve(dstSize + 1);
+        offsets.push_back(0);
+        const double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+
+        for (size_t i = 0; i < dstSize; ++i) {
+            const auto first = taps.size();
+            if (srcSize == dstSize) {
+                taps.emplace_back(i, 1.0);
+            } else if (filter == DownsampleFilter::Gaussian) {
+                const double center = (static_cast<double>(i) + 0.5) * scale - 0.5;
+                const double sigma = 0.5 * std::max(scale, 1.0);
+                const auto a = static_cast<std::ptrdiff_t>(std::floor(center - 3.0 * sigma));
+                const auto b = static_cast<std::ptrdiff_t>(std::ceil(center + 3.0 * sigma));
+                const auto last = static_cast<std::ptrdiff_t>(srcSize) - 1;
+                for (auto j = std::max<std::ptrdiff_t>(a, 0); j <= std::min(b, last); ++j) {
+                    const double d = (static_cast<double>(j) - center) / sigma;
+                    taps.emplace_back(static_cast<size_t>(j), std::exp(-0.5 * d * d));
+                }
+            } else {
+                // the footprint of the output voxel in input index space
+                const double a = static_cast<double>(i) * scale;
+                const double b = std::min(static_cast<double>(i + 1) * scale,
+                                          static_cast<double>(srcSize));
+                for (auto j = static_cast<size_t>(a); static_cast<double>(j) < b; ++j) {
+                    const double overlap =
+                        std::min(b, static_cast<double>(j) + 1.0) - std::max(a, double(j));
+                    if (overlap > 1.0e-9) taps.emplace_back(j, overlap);
+                }
+            }
+
+            double sum = 0.0;
+            for (auto t = first; t < taps.size(); ++t) sum += taps[t].second;
+            for (auto t = first; t < taps.size(); ++t) taps[t].second /= sum;
+            offsets.push_back(taps.size());
+        }
+    }
+
+    auto begin(size_t i) const { return taps.begin() + offsets[i]; }
+    auto end(size_t i) const { return taps.begin() + offsets[i + 1]; }
+
+    std::vector<size_t> offsets;
+    std::vector<std::pair<size_t, double>> taps;
+};
+
+template <typename T, bool IsMax>
+std::shared_ptr<VolumeRAM> resample(const VolumeRAMPrecision<T>& srcVol, const size3_t dstDims,
+                                    DownsampleFilter filter) {
+    // use a double type to perform the summation
+    using P = typename util::same_extent<T, double>::type;
+
+    const size3_t srcDims{srcVol.getDimensions()};
+    auto dstVol = std::make_shared<VolumeRAMPrecision<T>>(
+        dstDims, srcVol.getSwizzleMask(), srcVol.getInterpolation(), srcVol.getWrapping());
+
+    const T* src = srcVol.getDataTyped();
+    T* dst = dstVol->getDataTyped();
+
+    const Taps tx{srcDims.x, dstDims.x, filter};
+    const Taps ty{srcDims.y, dstDims.y, filter};
+    const Taps tz{srcDims.z, dstDims.z, filter};
+
+    const P init{IsMax ? std::numeric_limits<double>::lowest() : 0.0};
+    const auto accumulate = [](P& acc, const P& value, double weight) {
+        if constexpr (IsMax) {
+            acc = glm::max(acc, value);
+        } else {
+            acc += value * weight;
+        }
+    };
+    const auto convert = [](P value) {
+        if constexpr (std::is_integral_v<typename util::value_type<T>::type>) {
+            value = glm::round(value);
+        }
+#include <warn/push>
+#include <warn/ignore/conversion>
+        return static_cast<T>(value);
+#include <warn/pop>
+    };
+
+    const size_t srcSliceSize = srcDims.x * srcDims.y;
+    const size_t dstSliceSize = dstDims.x * dstDims.y;
+
+    // Output slices are computed as the weighted sum of the input slices in their footprint, each
+    // resampled along x and y. The resampled input slices are kept while consecutive output
+    // slices need them, so every input slice is processed about once per range.
+    util::forEachRangeParallel(dstDims.z, [&](size_t first, size_t last) {
+        std::vector<P> rows(dstDims.x * srcDims.y);
+        std::vector<P> acc(dstSliceSize);
+        std::vector<std::pair<size_t, std::vector<P>>> slices;
+        std::vector<std::vector<P>> unused;
+
+        const auto resampleSlice = [&](size_t z, std::vector<P>& out) {
+            const T* slice = src + z * srcSliceSize;
+            for (size_t y = 0; y < srcDims.y; ++y) {
+                const T* line = slice + y * srcDims.x;
+                for (size_t x = 0; x < dstDims.x; ++x) {
+                    P value = init;
+                    for (auto t = tx.begin(x); t != tx.end(x); ++t) {
+                        accumulate(value, static_cast<P>(line[t->first]), t->second);
+                    }
+                    rows[y * dstDims.x + x] = value;
+                }
+            }
+            out.assign(dstSliceSize, init);
+            for (size_t y = 0; y < dstDims.y; ++y) {
+                P* line = out.data() + y * dstDims.x;
+                for (auto t = ty.begin(y); t != ty.end(y); ++t) {
+                    const P* in = rows.data() + t->first * dstDims.x;
+                    for (size_t x = 0; x < dstDims.x; ++x) accumulate(line[x], in[x], t->second);
+                }
+            }
+        };
+
+        for (size_t z = first; z < last; ++z) {
+            // release the slices before the footprint of this output slice
+            const auto zFirst = tz.begin(z)->first;
+            for (auto it = slices.begin(); it != slices.end();) {
+                if (it->first < zFirst) {
+                    unused.push_back(std::move(it->second));
+                    it = slices.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            std::fill(acc.begin(), acc.end(), init);
+            for (auto t = tz.begin(z); t != tz.end(z); ++t) {
+                auto it = std::find_if(slices.begin(), slices.end(),
+                                       [&](const auto& s) { return s.first == t->first; });
+                if (it == slices.end()) {
+                    std::vector<P> buffer;
+                    if (!unused.empty()) {
+                        buffer = std::move(unused.back());
+                        unused.pop_back();
+                    }
+                    resampleSlice(t->first, buffer);
+                    it = slices.emplace(slices.end(), t->first, std::move(buffer));
+                }
+                for (size_t i = 0; i < dstSliceSize; ++i) {
+                    accumulate(acc[i], it->second[i], t->second);
+                }
+            }
+
+            T* out = dst + z * dstSliceSize;
+            for (size_t i = 0; i < dstSliceSize; ++i) out[i] = convert(acc[i]);
+        }
+    });
+
+    return dstVol;
+}
+
+// The cache only holds the levels weakly, a pyramid is kept as long as any caller uses it. While a
+// pyramid is being calculated the entry holds the future of the result, which concurrent callers
+// wait on. Nothing in the cache keeps a volume alive.
+struct PyramidCache {
+    using Levels = std::vector<std::shared_ptr<const Volume>>;
+    struct Entry {
+        size_t id;
+        const Volume* key;
+        std::weak_ptr<const Volume> volume;
+        size3_t dims;
+        const DataFormatBase* format;
+        double factor;
+        DownsampleFilter filter;
+        std::shared_future<Levels> pending;
+        std::vector<std::weak_ptr<const Volume>> levels;
+
+        bool expired() const {
+            return volume.expired() ||
+                   (!pending.valid() &&
+                    std::any_of(levels.begin(), levels.end(),
+                                [](const std::weak_ptr<const Volume>& l) { return l.expired(); }));
+        }
+        std::optional<Levels> lock() const {
+            Levels res;
+            for (const auto& level : levels) {
+                if (auto l = level.lock()) {
+                    res.push_back(std::move(l));
+                } else {
+                    return std::nullopt;
+                }
+            }
+            return res;
+        }
+    };
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+    size_t nextId{0};
+};
+
+PyramidCache& pyramidCache() {
+    static PyramidCache cache;
+    return cache;
+}
+
+}  // namespace
+
+std::vector<size3_t> volumePyramidDimensions(size3_t dims, double factor, size_t maxLevels) {
+    if (!(factor > 1.0)) {
+        throw Exception("The pyramid factor has to be larger than one, got " + toString(factor),
+                        IVW_CONTEXT_CUSTOM("volumePyramidDimensions"));
+    }
+    std::vector<size3_t> res;
+    if (maxLevels == 0) return res;
+
+    res.push_back(dims);
+    while (res.size() < maxLevels && glm::compMax(res.back()) > 1) {
+        const auto& prev = res.back();
+        const size3_t next{glm::round(dvec3{prev} / factor)};
+        // make sure each level shrinks even for factors close to one
+        res.push_back(glm::max(glm::min(next, prev - size3_t{1}), size3_t{1}));
+    }
+    return res;
+}
+
+std::shared_ptr<VolumeRAM> volumeResample(const VolumeRAM& volume, size3_t dims,
+                                          DownsampleFilter filter) {
+    if (glm::compMul(dims) == 0) {
+        throw Exception("Invalid dimensions " + toString(dims),
+                        IVW_CONTEXT_CUSTOM("volumeResample"));
+    }
+    return volume.dispatch<std::shared_ptr<VolumeRAM>>(
+        [&](auto srcVol) -> std::shared_ptr<VolumeRAM> {
+            using ValueType = util::PrecisionValueType<decltype(srcVol)>;
+            if (filter == DownsampleFilter::Max) {
+                return resample<ValueType, true>(*srcVol, dims, filter);
+            } else {
+                return resample<ValueType, false>(*srcVol, dims, filter);
+            }
+        });
+}
+
+std::vector<std::shared_ptr<VolumeRAM>> volumePyramid(const VolumeRAM& volume,
+                                                      const std::vector<size3_t>& dims,
+                                                      DownsampleFilter filter) {
+    std::vector<std::shared_ptr<VolumeRAM>> levels;
+    levels.reserve(dims.size());
+    const VolumeRAM* prev = &volume;
+    for (const auto& levelDims : dims) {
+        levels.push_back(volumeResample(*prev, levelDims, filter));
+        prev = levels.back().get();
+    }
+    return levels;
+}
+
+std::vector<std::shared_ptr<Volume>> volumePyramid(const Volume& volume, double factor,
+                                                   DownsampleFilter filter, size_t maxLevels) {
+    auto dims = volumePyramidDimensions(volume.getDimensions(), factor, maxLevels);
+    if (!dims.empty()) dims.erase(dims.begin());
+
+    const auto reprs = volumePyramid(*volume.getRepresentation<VolumeRAM>(), dims, filter);
+
+    std::vector<std::shared_ptr<Volume>> levels;
+    levels.reserve(reprs.size());
+    for (const auto& repr : reprs) {
+        auto level = std::make_shared<Volume>(repr);
+        level->setModelMatrix(volume.getModelMatrix());
+        level->setWorldMatrix(volume.getWorldMatrix());
+        level->dataMap_ = volume.dataMap_;
+        level->copyMetaDataFrom(volume);
+        levels.push_back(level);
+    }
+    return levels;
+}
+
+std::vector<std::shared_ptr<const Volume>> cachedVolumePyramid(
+    const std::shared_ptr<const Volume>& volume, double factor, DownsampleFilter filter) {
+
+    auto& cache = pyramidCache();
+    const auto dims = volume->getDimensions();
+    const auto format = volume->getDataFormat();
+    const auto matches = [&](const PyramidCache::Entry& e) {
+        return e.key == volume.get() && e.factor == factor && e.filter == filter;
+    };
+    size_t id = 0;
+    const auto isOwn = [&](const PyramidCache::Entry& e) { return e.id == id; };
+
+    std::promise<PyramidCache::Levels> promise;
+    std::shared_future<PyramidCache::Levels> pending;
+    {
+        std::scoped_lock lock{cache.mutex};
+        util::erase_remove_if(cache.entries, [&](const PyramidCache::Entry& e) {
+            return e.expired() ||
+                   (e.key == volume.get() && (e.dims != dims || e.format != format));
+        });
+        auto it = std::find_if(cache.entries.begin(), cache.entries.end(), matches);
+        if (it != cache.entries.end()) {
+            if (it->pending.valid()) {
+                pending = it->pending;
+            } else if (auto levels = it->lock()) {
+                return *levels;
+            }
+        }
+        if (!pending.valid()) {
+            id = cache.nextId++;
+            cache.entries.push_back({id, volume.get(), volume, dims, format, factor, filter,
+                                     promise.get_future().share(), {}});
+        }
+    }
+    if (pending.valid()) return pending.get();
+
+    try {
+        auto result = volumePyramid(*volume, factor, filter);
+        PyramidCache::Levels levels(result.begin(), result.end());
+        promise.set_value(levels);
+
+        // Replace the future, which holds the levels, with weak references. The entry is gone if
+        // it was invalidated during the calculation.
+        std::scoped_lock lock{cache.mutex};
+        auto it = std::find_if(cache.entries.begin(), cache.entries.end(), isOwn);
+        if (it != cache.entries.end()) {
+            it->pending = std::shared_future<PyramidCache::Levels>{};
+            it->levels.assign(levels.begin(), levels.end());
+        }
+        return levels;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::scoped_lock lock{cache.mutex};
+        util::erase_remove_if(cache.entries, isOwn);
+        throw;
+    }
+}
+
+void invalidateVolumePyramids(const Volume* volume) {
+    auto& cache = pyramidCache();
+    std::scoped_lock lock{cache.mutex};
+    util::erase_remove_if(cache.entries,
+                          [&](const PyramidCache::Entry& e) { return e.key == volume; });
+}
+
+}  // namespace util
+
+}  // namespace inviwo
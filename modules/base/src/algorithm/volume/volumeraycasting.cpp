@@ -0,0 +1,190 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+#include <inviwo/core/datastructures/camera/camera.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/transferfunction.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+/// Same reference sampling interval as used for the opacity correction in the OpenGL raycaster
+constexpr float referenceSamplingInterval = 150.0f;
+
+float sampleTrilinear(const std::vector<float>& values, const size3_t& dims, const vec3& pos) {
+    const auto q = glm::clamp(pos * vec3(dims) - 0.5f, vec3(0.0f), vec3(dims - size3_t{1}));
+    const auto i0 = size3_t(q);
+    const auto i1 = glm::min(i0 + size3_t{1}, dims - size3_t{1});
+    const auto f = q - vec3(i0);
+    const auto at = [&](size_t x, size_t y, size_t z) {
+        return values[x + dims.x * (y + dims.y * z)];
+    };
+    const auto c00 = glm::mix(at(i0.x, i0.y, i0.z), at(i1.x, i0.y, i0.z), f.x);
+    const auto c10 = glm::mix(at(i0.x, i1.y, i0.z), at(i1.x, i1.y, i0.z), f.x);
+    const auto c01 = glm::mix(at(i0.x, i0.y, i1.z), at(i1.x, i0.y, i1.z), f.x);
+    const auto c11 = glm::mix(at(i0.x, i1.y, i1.z), at(i1.x, i1.y, i1.z), f.x);
+    return glm::mix(glm::mix(c00, c10, f.y), glm::mix(c01, c11, f.y), f.z);
+}
+
+/**
+ * Intersect the segment origin + t * dir, t in [0,1], with the unit cube. Returns false if the
+ * segment misses the cube, otherwise the parameter range inside the cube in t0 and t1.
+ */
+bool intersectUnitCube(const vec3& origin, const vec3& dir, float& t0, float& t1) {
+    t0 = 0.0f;
+    t1 = 1.0f;
+    for (int k = 0; k < 3; ++k) {
+        if (std::abs(dir[k]) < std::numeric_limits<float>::epsilon()) {
+            if (origin[k] < 0.0f || origin[k] > 1.0f) return false;
+        } else {
+            const float ta = -origin[k] / dir[k];
+            const float tb = (1.0f - origin[k]) / dir[k];
+            t0 = std::max(t0, std::min(ta, tb));
+            t1 = std::min(t1, std::max(ta, tb));
+        }
+    }
+    return t0 < t1;
+}
+
+}  // namespace
+
+NormalizedVolumeChannel normalizeVolumeChannel(const Volume& volume, size_t channel) {
+    const auto volumeRAM = volume.getRepresentation<VolumeRAM>();
+    const auto dataRange = volume.dataMap_.dataRange;
+    const double scale = dataRange.y > dataRange.x ? 1.0 / (dataRange.y - dataRange.x) : 1.0;
+
+    NormalizedVolumeChannel result{volumeRAM->getDimensions(), {}};
+    auto& values = result.values;
+    values.resize(glm::compMul(result.dims));
+    volumeRAM->dispatch<void>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        const auto data = vrprecision->getDataTyped();
+        const auto comp = std::min(channel, util::extent<ValueType>::value - 1);
+        forEachRangeParallel(values.size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                values[i] = static_cast<float>(
+                    (static_cast<double>(util::glmcomp(data[i], comp)) - dataRange.x) * scale);
+            }
+        });
+    });
+    return result;
+}
+
+void raycastVolume(const Volume& volume, const TransferFunction& tf, const Camera& camera,
+                   RenderBufferRAM& target, const VolumeRaycastingSettings& settings) {
+    if (target.dims.x == 0 || target.dims.y == 0) return;
+    if (glm::compMul(volume.getDimensions()) == 0) return;
+    raycastVolume(volume, normalizeVolumeChannel(volume, settings.channel), tf, camera, target,
+                  settings);
+}
+
+void raycastVolume(const Volume& volume, const NormalizedVolumeChannel& channel,
+                   const TransferFunction& tf, const Camera& camera, RenderBufferRAM& target,
+                   const VolumeRaycastingSettings& settings) {
+    if (target.dims.x == 0 || target.dims.y == 0) return;
+
+    const auto dims = channel.dims;
+    if (glm::compMul(dims) == 0) return;
+    const auto& values = channel.values;
+
+    const auto tfLayer = tf.getData()->getRepresentation<LayerRAM>();
+    const auto tfSize = tfLayer->getDimensions().x;
+    std::vector<vec4> lut(tfSize);
+    tfLayer->readRegion(size2_t{0}, size2_t{tfSize, 1}, lut.data());
+    const auto classify = [&](float v) {
+        const float x = glm::clamp(v, 0.0f, 1.0f) * static_cast<float>(tfSize - 1);
+        const auto i = static_cast<size_t>(x);
+        return glm::mix(lut[i], lut[std::min(i + 1, tfSize - 1)], x - static_cast<float>(i));
+    };
+
+    const mat4 viewProj = camera.getProjectionMatrix() * camera.getViewMatrix();
+    const auto& transformer = volume.getCoordinateTransformer();
+    const mat4 clipToData = transformer.getWorldToDataMatrix() * glm::inverse(viewProj);
+    const mat4 dataToClip = viewProj * transformer.getDataToWorldMatrix();
+    const auto unproject = [&](const vec2& ndc, float z) {
+        const vec4 p = clipToData * vec4(ndc, z, 1.0f);
+        return vec3(p) / p.w;
+    };
+
+    const float dataStep =
+        1.0f / (std::max(settings.samplingRate, 0.001f) * static_cast<float>(glm::compMax(dims)));
+    const float correction = dataStep * referenceSamplingInterval;
+
+    forEachPixelParallel(
+        target.dims,
+        [&](size2_t pixel) {
+            const auto i = target.index(pixel);
+            const vec2 ndc = (vec2(pixel) + 0.5f) / vec2(target.dims) * 2.0f - 1.0f;
+            const auto entry = unproject(ndc, -1.0f);
+            const auto dir = unproject(ndc, 2.0f * target.depth[i] - 1.0f) - entry;
+            const float length = glm::length(dir);
+
+            float t0 = 0.0f;
+            float t1 = 0.0f;
+            if (!(length > 0.0f) || !intersectUnitCube(entry, dir, t0, t1)) return;
+
+            const float dt = dataStep / length;
+            const auto steps = static_cast<size_t>(std::ceil((t1 - t0) / dt));
+            vec4 result{0.0f};
+            float firstHit = -1.0f;
+            for (size_t s = 0; s < steps; ++s) {
+                const float t = t0 + static_cast<float>(s) * dt;
+                auto color = classify(sampleTrilinear(values, dims, entry + t * dir));
+                if (color.a <= 0.0f) continue;
+                color.a = 1.0f - std::pow(1.0f - color.a, correction);
+                result += vec4(vec3(color) * color.a, color.a) * (1.0f - result.a);
+                if (firstHit < 0.0f) firstHit = t;
+                if (result.a >= settings.opacityThreshold) break;
+            }
+
+            if (firstHit >= 0.0f) {
+                const vec4 clip = dataToClip * vec4(entry + firstHit * dir, 1.0f);
+                target.depth[i] = std::min(target.depth[i], clip.z / clip.w * 0.5f + 0.5f);
+            }
+            target.color[i] = result + target.color[i] * (1.0f - result.a);
+        },
+        settings.tileSize);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -52,6 +52,10 @@ DistanceTransformRAM::DistanceTransformRAM()
     , normalize_("normalize", "Use normalized threshold", true)
     , resultDistScale_("distScale", "Scaling Factor", 1.0f, 0.0f, 1.0e3, 0.05f)
     , resultSquaredDist_("distSquared", "Squared Distance", false)
+    , outputFormat_("outputFormat", "Output Format",
+                    {{"float32", "Float (32-bit)", DataFormatId::Float32},
+                     {"float16", "Half (16-bit)", DataFormatId::Float16}},
+                    0)
     , uniformUpsampling_("uniformUpsampling", "Uniform Upsampling", false)
     , upsampleFactorUniform_("upsampleFactorUniform", "Sampling Factor", 1, 1, 10)
     , upsampleFactorVec3_("upsampleFactorVec3", "Sampling Factor", size3_t(1), size3_t(1),
@@ -69,8 +73,8 @@ DistanceTransformRAM::DistanceTransformRAM()
     addPort(outport_);
 
     addProperties(threshold_, flip_, normalize_, resultDistScale_, resultSquaredDist_,
-                  uniformUpsampling_, upsampleFactorVec3_, upsampleFactorUniform_, dataRangeMode_,
-                  customDataRange_, dataRangeOutput_);
+                  outputFormat_, uniformUpsampling_, upsampleFactorVec3_, upsampleFactorUniform_,
+                  dataRangeMode_, customDataRange_, dataRangeOutput_);
 
     upsampleFactorVec3_.visibilityDependsOn(uniformUpsampling_,
                                             [](const auto& p) { return !p.get(); });
@@ -92,15 +96,30 @@ void DistanceTransformRAM::process() {
                                                      : upsampleFactorVec3_.get(),
                  threshold = threshold_.get(), normalize = normalize_.get(), flip = flip_.get(),
                  square = resultSquaredDist_.get(), scale = resultDistScale_.get(),
-                 dataRangeMode = dataRangeMode_.get(), customDataRange = customDataRange_.get(),
-                 volume =
-                     volumePort_.getData()](pool::Progress fprogress) -> std::shared_ptr<Volume> {
-        auto volDim = glm::max(volume->getDimensions(), size3_t(1u));
-        auto dstRepr = std::make_shared<VolumeRAMPrecision<float>>(upsample * volDim);
-
+                 format = outputFormat_.get(), dataRangeMode = dataRangeMode_.get(),
+                 customDataRange = customDataRange_.get(),
+                 volume = volumePort_.getData()](
+                    pool::Stop stop, pool::Progress fprogress) -> std::shared_ptr<Volume> {
+        const auto dstDim = upsample * glm::max(volume->getDimensions(), size3_t(1u));
         const auto progress = [&](double f) { fprogress(static_cast<float>(f)); };
-        util::volumeDistanceTransform(volume.get(), dstRepr.get(), upsample, threshold, normalize,
-                                      flip, square, scale, progress);
+
+        std::shared_ptr<VolumeRAM> dstRepr;
+        dvec2 minmax{0.0};
+        const auto transform = [&](auto repr) {
+            util::volumeDistanceTransform(volume.get(), repr.get(), upsample, threshold, normalize,
+                                          flip, square, scale, progress, stop);
+            if (!stop && dataRangeMode == DistanceTransformRAM::DataRangeMode::MinMax) {
+                const auto mm = util::dataMinMax(repr->getDataTyped(), glm::compMul(dstDim));
+                minmax = dvec2(mm.first[0], mm.second[0]);
+            }
+            dstRepr = repr;
+        };
+        if (format == DataFormatId::Float16) {
+            transform(std::make_shared<VolumeRAMPrecision<f16>>(dstDim));
+        } else {
+            transform(std::make_shared<VolumeRAMPrecision<float>>(dstDim));
+        }
+        if (stop) return nullptr;
 
         auto dstVol = std::make_shared<Volume>(dstRepr);
         // pass meta data on
@@ -118,11 +137,8 @@ void DistanceTransformRAM::process() {
                 break;
             }
             case DistanceTransformRAM::DataRangeMode::MinMax: {
-                auto minmax = util::dataMinMax(dstRepr->getDataTyped(),
-                                               glm::compMul(dstRepr->getDimensions()));
-
-                dstVol->dataMap_.dataRange = dvec2(minmax.first[0], minmax.second[0]);
-                dstVol->dataMap_.valueRange = dvec2(minmax.first[0], minmax.second[0]);
+                dstVol->dataMap_.dataRange = minmax;
+                dstVol->dataMap_.valueRange = minmax;
                 break;
             }
             case DistanceTransformRAM::DataRangeMode::Custom: {
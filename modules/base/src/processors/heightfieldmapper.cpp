@@ -30,6 +30,7 @@
 #include <modules/base/processors/heightfieldmapper.h>
 #include <inviwo/core/datastructures/geometry/simplemeshcreator.h>
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
 
 namespace inviwo {
 
@@ -82,9 +83,6 @@ void HeightFieldMapper::process() {
         return;
     }
 
-    // check the number of channels
-    const DataFormatBase *format = srcImg->getDataFormat();
-    std::size_t numInputChannels = format->getComponents();
     size2_t dim = srcImg->getDimensions();
 
     Image *outImg = nullptr;
@@ -103,50 +101,9 @@ void HeightFieldMapper::process() {
     LayerRAM *dstLayer = outImg->getColorLayer(0)->getEditableRepresentation<LayerRAM>();
     float *data = static_cast<float *>(dstLayer->getData());
 
-    // convert input image to float image
+    // convert the first channel of the input image to float, float images are copied as is
     const LayerRAM *srcLayer = srcImg->getColorLayer(0)->getRepresentation<LayerRAM>();
-
-    // special case: input image is already FLOAT32 with 1 channel
-    if ((numInputChannels == 1) && (format->getId() == DataFormatId::Float32)) {
-        const float *srcData = static_cast<const float *>(srcLayer->getData());
-        std::copy(srcData, srcData + dim.x * dim.y, data);
-    } else {
-        switch (numInputChannels) {
-            case 2:
-                for (unsigned int y = 0; y < dim.y; ++y) {
-                    for (unsigned int x = 0; x < dim.x; ++x) {
-                        data[y * dim.x + x] =
-                            static_cast<float>(srcLayer->getAsNormalizedDVec2(glm::uvec2(x, y)).r);
-                    }
-                }
-                break;
-            case 3:
-                for (unsigned int y = 0; y < dim.y; ++y) {
-                    for (unsigned int x = 0; x < dim.x; ++x) {
-                        data[y * dim.x + x] =
-                            static_cast<float>(srcLayer->getAsNormalizedDVec3(glm::uvec2(x, y)).r);
-                    }
-                }
-                break;
-            case 4:
-                for (unsigned int y = 0; y < dim.y; ++y) {
-                    for (unsigned int x = 0; x < dim.x; ++x) {
-                        data[y * dim.x + x] =
-                            static_cast<float>(srcLayer->getAsNormalizedDVec4(glm::uvec2(x, y)).r);
-                    }
-                }
-                break;
-            case 1:
-            default:
-                for (unsigned int y = 0; y < dim.y; ++y) {
-                    for (unsigned int x = 0; x < dim.x; ++x) {
-                        data[y * dim.x + x] =
-                            static_cast<float>(srcLayer->getAsNormalizedDouble(glm::uvec2(x, y)));
-                    }
-                }
-                break;
-        }
-    }
+    srcLayer->readRegion(size2_t{0}, dim, data, util::ValueConversion::Normalized);
 
     // rescale data set
     std::size_t numValues = dim.x * dim.y;
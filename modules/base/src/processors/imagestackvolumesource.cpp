@@ -41,11 +41,11 @@
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/vectoroperations.h>
-#include <inviwo/core/util/zip.h>
-#include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/io/datareaderexception.h>
 
 #include <algorithm>
+#include <limits>
+#include <map>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -59,6 +59,8 @@ struct FloatOrIntMax32
     : std::integral_constant<bool, Format::numtype == NumericType::Float || Format::compsize <= 4> {
 };
 
+constexpr size_t noReader = std::numeric_limits<size_t>::max();
+
 }  // namespace
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
@@ -72,7 +74,7 @@ const ProcessorInfo ImageStackVolumeSource::processorInfo_{
 const ProcessorInfo ImageStackVolumeSource::getProcessorInfo() const { return processorInfo_; }
 
 ImageStackVolumeSource::ImageStackVolumeSource(InviwoApplication* app)
-    : Processor()
+    : PoolProcessor()
     , outport_("volume")
     , filePattern_("filePattern", "File Pattern", "####.jpeg", "")
     , reload_("reload", "Reload data")
@@ -102,15 +104,11 @@ void ImageStackVolumeSource::addFileNameFilters() {
 }
 
 void ImageStackVolumeSource::process() {
-    util::OnScopeExit guard{[&]() { outport_.setData(nullptr); }};
-
     if (filePattern_.isModified() || reload_.isModified() || skipUnsupportedFiles_.isModified()) {
-        volume_ = load();
-        if (volume_) {
-            basis_.updateForNewEntity(*volume_, deserialized_);
-            information_.updateForNewVolume(*volume_, deserialized_);
-        }
-        deserialized_ = false;
+        volume_.reset();
+        outport_.setData(nullptr);
+        load();
+        return;
     }
 
     if (volume_) {
@@ -118,7 +116,6 @@ void ImageStackVolumeSource::process() {
         information_.updateVolume(*volume_);
     }
     outport_.setData(volume_);
-    guard.release();
 }
 
 bool ImageStackVolumeSource::isValidImageFile(std::string fileName) {
@@ -126,51 +123,57 @@ bool ImageStackVolumeSource::isValidImageFile(std::string fileName) {
         filesystem::getFileExtension(fileName));
 }
 
-std::shared_ptr<Volume> ImageStackVolumeSource::load() {
+void ImageStackVolumeSource::load() {
     const auto files = filePattern_.getFileList();
     if (files.empty()) {
-        return nullptr;
+        return;
     }
 
-    using ReaderMap = std::map<std::string, std::unique_ptr<DataReaderType<Layer>>>;
-    ReaderMap readerMap;
+    // one reader per file extension, each job gets its own clones since readers are not
+    // guaranteed to be thread safe
+    using Reader = DataReaderType<Layer>;
+    std::vector<std::unique_ptr<Reader>> readers;
+    std::map<std::string, size_t> readerMap;
 
     const auto getReader = [&](const std::string& filename) {
         const auto fext = toLower(filesystem::getFileExtension(filename));
         const auto it = readerMap.find(fext);
         if (it != readerMap.end()) {
-            return it->second.get();
+            return it->second;
         }
         const auto sext = filePattern_.getSelectedExtension();
         auto reader = readerFactory_->getReaderForTypeAndExtension<Layer>(sext, fext);
-        auto ptr = reader.get();
-        readerMap.emplace(fext, std::move(reader));
-        return ptr;
+        const auto index = reader ? readers.size() : noReader;
+        if (reader) readers.push_back(std::move(reader));
+        readerMap.emplace(fext, index);
+        return index;
     };
 
-    std::vector<std::pair<std::string, DataReaderType<Layer>*>> slices;
+    std::vector<std::pair<std::string, size_t>> slices;
     slices.reserve(files.size());
 
     std::transform(files.begin(), files.end(), std::back_inserter(slices),
-                   [&](const auto& file) -> std::pair<std::string, DataReaderType<Layer>*> {
+                   [&](const auto& file) -> std::pair<std::string, size_t> {
                        return {file, getReader(file)};
                    });
     if (skipUnsupportedFiles_) {
         slices.erase(std::remove_if(slices.begin(), slices.end(),
-                                    [](auto& elem) { return elem.second == nullptr; }),
+                                    [](auto& elem) { return elem.second == noReader; }),
                      slices.end());
     }
 
     // identify first slice with a reader
     const auto first = std::find_if(slices.begin(), slices.end(),
-                                    [](auto& item) { return item.second != nullptr; });
+                                    [](auto& item) { return item.second != noReader; });
     if (first == slices.end()) {  // could not find any suitable data reader for the images
         throw Exception(
             fmt::format("No supported images found in '{}'", filePattern_.getFilePatternPath()),
             IVW_CONTEXT);
     }
 
-    const auto referenceLayer = first->second->readData(first->first);
+    const std::shared_ptr<const Layer> referenceLayer =
+        readers[first->second]->readData(first->first);
+    const size_t referenceSlice = static_cast<size_t>(std::distance(slices.begin(), first));
 
     // Call getRepresentation here to enforce creating a ram representation.
     // Otherwise the default image size, i.e. 256x256, will be reported since the LayerDisk
@@ -189,43 +192,67 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
             IVW_CONTEXT);
     }
 
-    return referenceRAM->dispatch<std::shared_ptr<Volume>, FloatOrIntMax32>(
-        [&](auto reflayerprecision) {
-            using ValueType = util::PrecisionValueType<decltype(reflayerprecision)>;
-            using PrimitiveType = typename DataFormat<ValueType>::primitive;
-
-            const size2_t layerDims = reflayerprecision->getDimensions();
-            const size_t sliceOffset = glm::compMul(layerDims);
-
-            // create matching volume representation
-            auto volumeRAM =
-                std::make_shared<VolumeRAMPrecision<ValueType>>(size3_t{layerDims, slices.size()});
-            auto volData = volumeRAM->getDataTyped();
-
+    referenceRAM->dispatch<void, FloatOrIntMax32>([&](auto reflayerprecision) {
+        using ValueType = util::PrecisionValueType<decltype(reflayerprecision)>;
+        using PrimitiveType = typename DataFormat<ValueType>::primitive;
+
+        const size2_t layerDims = reflayerprecision->getDimensions();
+        const size_t sliceOffset = glm::compMul(layerDims);
+        const size_t nSlices = slices.size();
+
+        // create matching volume representation, the slices are decoded directly into it
+        auto volumeRAM =
+            std::make_shared<VolumeRAMPrecision<ValueType>>(size3_t{layerDims, nSlices});
+        ValueType* volData = volumeRAM->getDataTyped();
+
+        auto volume = std::make_shared<Volume>(volumeRAM);
+        volume->dataMap_.dataRange =
+            dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
+        volume->dataMap_.valueRange =
+            dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
+
+        const auto size = vec3(0.01f) * static_cast<vec3>(volumeRAM->getDimensions());
+        volume->setBasis(glm::diagonal3x3(size));
+        volume->setOffset(-0.5 * size);
+
+        // Decodes slices [begin, end) into the volume and returns a list of warnings.
+        // All state is captured by value since the job might outlive the processor, the volume
+        // keeps volData alive.
+        auto decode = [volume, volData, layerDims, sliceOffset,
+                       slices = std::make_shared<const decltype(slices)>(std::move(slices)),
+                       referenceLayer,
+                       referenceSlice](std::vector<std::shared_ptr<Reader>> jobReaders,
+                                       size_t begin, size_t end, pool::Stop stop,
+                                       pool::Progress progress) {
+            std::vector<std::string> warnings;
             const auto fill = [&](size_t s) {
                 std::fill(volData + s * sliceOffset, volData + (s + 1) * sliceOffset, ValueType{0});
             };
-
-            const auto read = [&](const auto& file, auto reader) -> std::shared_ptr<Layer> {
+            const auto read = [&](const std::string& file,
+                                  Reader* reader) -> std::shared_ptr<const Layer> {
                 try {
                     return reader->readData(file);
                 } catch (DataReaderException const& e) {
-                    LogProcessorWarn(
+                    warnings.push_back(
                         fmt::format("Could not load image: {}, {}", file, e.getMessage()));
                     return nullptr;
                 }
             };
 
-            for (auto&& elem : util::enumerate(slices)) {
-                const auto slice = elem.first();
-                const auto file = elem.second().first;
-                const auto reader = elem.second().second;
-                if (!reader) {
+            for (size_t slice = begin; slice < end; ++slice) {
+                if (stop) return warnings;
+                progress(slice - begin, end - begin);
+
+                const auto& file = (*slices)[slice].first;
+                const auto readerIndex = (*slices)[slice].second;
+                if (readerIndex == noReader) {
                     fill(slice);
                     continue;
                 }
 
-                const auto layer = read(file, reader);
+                const auto layer = slice == referenceSlice
+                                       ? referenceLayer
+                                       : read(file, jobReaders[readerIndex].get());
                 if (!layer) {
                     fill(slice);
                     continue;
@@ -235,16 +262,17 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
                 const auto format = layerRAM->getDataFormat();
                 if ((format->getNumericType() != NumericType::Float) &&
                     (format->getPrecision() > 32)) {
-                    LogProcessorWarn(fmt::format("Unsupported integer bit depth: {}, for image: {}",
-                                                 format->getPrecision(), file));
+                    warnings.push_back(
+                        fmt::format("Unsupported integer bit depth: {}, for image: {}",
+                                    format->getPrecision(), file));
                     fill(slice);
                     continue;
                 }
 
                 if (layerRAM->getDimensions() != layerDims) {
-                    LogProcessorWarn(
+                    warnings.push_back(
                         fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
-                                    layer->getDimensions(), layerDims, file));
+                                    layerRAM->getDimensions(), layerDims, file));
                     fill(slice);
                     continue;
                 }
@@ -255,23 +283,51 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
                         [](auto value) { return util::glm_convert_normalized<ValueType>(value); });
                 });
             }
+            progress(1.0f);
+            return warnings;
+        };
+
+        // a few jobs per thread to balance slices of varying decoding cost
+        const size_t nJobs = std::min(
+            nSlices, 4 * std::max<size_t>(InviwoApplication::getPtr()->getPoolSize(), 1));
+        const size_t slicesPerJob = (nSlices + nJobs - 1) / nJobs;
+
+        using Job = std::function<std::vector<std::string>(pool::Stop, pool::Progress)>;
+        std::vector<Job> jobs;
+        for (size_t begin = 0; begin < nSlices; begin += slicesPerJob) {
+            std::vector<std::shared_ptr<Reader>> jobReaders;
+            for (const auto& reader : readers) {
+                jobReaders.emplace_back(reader->clone());
+            }
+            const size_t end = std::min(nSlices, begin + slicesPerJob);
+            jobs.push_back([decode, jobReaders, begin, end](pool::Stop stop,
+                                                            pool::Progress progress) {
+                return decode(jobReaders, begin, end, stop, progress);
+            });
+        }
 
-            auto volume = std::make_shared<Volume>(volumeRAM);
-            volume->dataMap_.dataRange =
-                dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
-            volume->dataMap_.valueRange =
-                dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
+        dispatchMany(jobs, [this, volume](std::vector<std::vector<std::string>> warnings) {
+            for (const auto& jobWarnings : warnings) {
+                for (const auto& warning : jobWarnings) {
+                    LogProcessorWarn(warning);
+                }
+            }
 
-            const auto size = vec3(0.01f) * static_cast<vec3>(volumeRAM->getDimensions());
-            volume->setBasis(glm::diagonal3x3(size));
-            volume->setOffset(-0.5 * size);
+            volume_ = volume;
+            basis_.updateForNewEntity(*volume_, deserialized_);
+            information_.updateForNewVolume(*volume_, deserialized_);
+            deserialized_ = false;
 
-            return volume;
+            basis_.updateEntity(*volume_);
+            information_.updateVolume(*volume_);
+            outport_.setData(volume_);
+            newResults();
         });
+    });
 }
 
 void ImageStackVolumeSource::deserialize(Deserializer& d) {
-    Processor::deserialize(d);
+    PoolProcessor::deserialize(d);
     addFileNameFilters();
     deserialized_ = true;
 }
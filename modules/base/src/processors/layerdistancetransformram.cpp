@@ -53,6 +53,10 @@ LayerDistanceTransformRAM::LayerDistanceTransformRAM()
     , normalize_("normalize", "Use normalized threshold", true)
     , resultDistScale_("distScale", "Scaling Factor", 1.0f, 0.0f, 1.0e3, 0.05f)
     , resultSquaredDist_("distSquared", "Squared Distance", false)
+    , outputFormat_("outputFormat", "Output Format",
+                    {{"float32", "Float (32-bit)", DataFormatId::Float32},
+                     {"float16", "Half (16-bit)", DataFormatId::Float16}},
+                    0)
     , uniformUpsampling_("uniformUpsampling", "Uniform Upsampling", false)
     , upsampleFactorUniform_("upsampleFactorUniform", "Sampling Factor", 1, 1, 10)
     , upsampleFactorVec2_("upsampleFactorVec2", "Sampling Factor", size2_t(1), size2_t(1),
@@ -62,7 +66,7 @@ LayerDistanceTransformRAM::LayerDistanceTransformRAM()
     addPort(outport_);
 
     addProperties(threshold_, flip_, normalize_, resultDistScale_, resultSquaredDist_,
-                  uniformUpsampling_, upsampleFactorVec2_, upsampleFactorUniform_);
+                  outputFormat_, uniformUpsampling_, upsampleFactorVec2_, upsampleFactorUniform_);
 
     upsampleFactorVec2_.visibilityDependsOn(uniformUpsampling_,
                                             [](const auto& p) { return !p.get(); });
@@ -78,22 +82,30 @@ void LayerDistanceTransformRAM::process() {
                                                            : upsampleFactorVec2_.get(),
                        threshold = threshold_.get(), normalize = normalize_.get(),
                        flip = flip_.get(), square = resultSquaredDist_.get(),
-                       scale = resultDistScale_.get(),
-                       &cache = imageCache_](pool::Progress progress) -> std::shared_ptr<Image> {
-        auto imgDim = glm::max(image->getDimensions(), size2_t(1u));
-
-        auto [dstImage, dstRepr] = cache.getTypedUnused<float>(upsample * imgDim);
-
-        // pass meta data on
-        dstImage->getColorLayer()->setModelMatrix(image->getColorLayer()->getModelMatrix());
-        dstImage->getColorLayer()->setWorldMatrix(image->getColorLayer()->getWorldMatrix());
-        dstImage->copyMetaDataFrom(*image);
-
-        util::layerDistanceTransform(image->getColorLayer(), dstRepr, upsample, threshold,
-                                     normalize, flip, square, scale, progress);
-
-        cache.add(dstImage);
-        return dstImage;
+                       scale = resultDistScale_.get(), format = outputFormat_.get(),
+                       &cache = imageCache_](pool::Stop stop,
+                                             pool::Progress progress) -> std::shared_ptr<Image> {
+        const auto dstDim = upsample * glm::max(image->getDimensions(), size2_t(1u));
+
+        const auto transform = [&](auto typed) {
+            auto [dstImage, dstRepr] = typed;
+
+            // pass meta data on
+            dstImage->getColorLayer()->setModelMatrix(image->getColorLayer()->getModelMatrix());
+            dstImage->getColorLayer()->setWorldMatrix(image->getColorLayer()->getWorldMatrix());
+            dstImage->copyMetaDataFrom(*image);
+
+            util::layerDistanceTransform(image->getColorLayer(), dstRepr, upsample, threshold,
+                                         normalize, flip, square, scale, progress, stop);
+
+            cache.add(dstImage);
+            return dstImage;
+        };
+
+        auto dstImage = format == DataFormatId::Float16
+                            ? transform(cache.getTypedUnused<f16>(dstDim))
+                            : transform(cache.getTypedUnused<float>(dstDim));
+        return stop ? nullptr : dstImage;
     };
 
     outport_.clear();
@@ -0,0 +1,84 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/meshrasterizercpu.h>
+#include <modules/base/algorithm/image/renderbufferram.h>
+#include <modules/base/algorithm/mesh/meshrasterization.h>
+#include <inviwo/core/algorithm/boundingbox.h>
+#include <inviwo/core/datastructures/image/image.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo MeshRasterizerCPU::processorInfo_{
+    "org.inviwo.MeshRasterizerCPU",  // Class identifier
+    "Mesh Rasterizer CPU",           // Display name
+    "Mesh Rendering",                // Category
+    CodeState::Experimental,         // Code state
+    Tags::CPU,                       // Tags
+};
+const ProcessorInfo MeshRasterizerCPU::getProcessorInfo() const { return processorInfo_; }
+
+MeshRasterizerCPU::MeshRasterizerCPU()
+    : Processor()
+    , inport_("geometry")
+    , imageInport_("imageInport")
+    , outport_("image")
+    , camera_("camera", "Camera", util::boundingBox(inport_))
+    , trackball_(&camera_)
+    , background_("background", "Background", vec4(0.0f), vec4(0.0f), vec4(1.0f))
+    , defaultColor_("defaultColor", "Default Color", vec4(0.75f, 0.75f, 0.75f, 1.0f), vec4(0.0f),
+                    vec4(1.0f))
+    , shading_("shading", "Shading", true)
+    , ambient_("ambient", "Ambient", 0.3f, 0.0f, 1.0f) {
+
+    addPort(inport_);
+    addPort(imageInport_).setOptional(true);
+    addPort(outport_);
+
+    background_.setSemantics(PropertySemantics::Color);
+    defaultColor_.setSemantics(PropertySemantics::Color);
+    addProperties(camera_, trackball_, background_, defaultColor_, shading_, ambient_);
+}
+
+void MeshRasterizerCPU::process() {
+    auto target = imageInport_.hasData()
+                      ? util::RenderBufferRAM(*imageInport_.getData())
+                      : util::RenderBufferRAM(outport_.getDimensions(), background_.get());
+
+    util::MeshRasterizationSettings settings;
+    settings.defaultColor = defaultColor_.get();
+    settings.shading = shading_.get();
+    settings.ambient = ambient_.get();
+    util::rasterizeMeshes(inport_.getVectorData(), camera_.get(), target, settings);
+
+    outport_.setData(target.toImage());
+}
+
+}  // namespace inviwo
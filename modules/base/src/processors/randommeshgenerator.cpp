@@ -204,6 +204,10 @@ void RandomMeshGenerator::process() {
     auto mesh = std::make_shared<BasicMesh>();
     if (enablePicking_) addPickingBuffer(*mesh, 0);
 
+    std::vector<std::shared_ptr<BasicMesh>> parts;
+    parts.reserve(boxes_.size() + spheres_.size() + cylinders_.size() + cones_.size() +
+                  toruses_.size());
+
     size_t i = 0;
     for (const auto& box : boxes_) {
         mat4 o = glm::translate(mat4(1.0f), box.position);
@@ -213,14 +217,14 @@ void RandomMeshGenerator::process() {
         o = glm::scale(o, box.scale);
         auto mesh2 = meshutil::cube(o, box.color);
         if (enablePicking_) addPickingBuffer(*mesh2, boxPicking_.getPickingId(i++));
-        mesh->Mesh::append(*mesh2);
+        parts.push_back(mesh2);
     }
 
     i = 0;
     for (const auto& sphere : spheres_) {
         auto mesh2 = meshutil::sphere(sphere.center, sphere.radius, sphere.color);
         if (enablePicking_) addPickingBuffer(*mesh2, spherePicking_.getPickingId(i++));
-        mesh->Mesh::append(*mesh2);
+        parts.push_back(mesh2);
     }
 
     i = 0;
@@ -228,14 +232,14 @@ void RandomMeshGenerator::process() {
         auto mesh2 =
             meshutil::cylinder(cylinder.start, cylinder.end, cylinder.color, cylinder.radius);
         if (enablePicking_) addPickingBuffer(*mesh2, cylinderPicking_.getPickingId(i++));
-        mesh->Mesh::append(*mesh2);
+        parts.push_back(mesh2);
     }
 
     i = 0;
     for (const auto& cone : cones_) {
         auto mesh2 = meshutil::cone(cone.start, cone.end, cone.color, cone.radius);
         if (enablePicking_) addPickingBuffer(*mesh2, conePicking_.getPickingId(i++));
-        mesh->Mesh::append(*mesh2);
+        parts.push_back(mesh2);
     }
 
     i = 0;
@@ -243,9 +247,11 @@ void RandomMeshGenerator::process() {
         auto mesh2 = meshutil::torus(torus.center, torus.up, torus.radius1, torus.radius2,
                                      ivec2(32, 8), torus.color);
         if (enablePicking_) addPickingBuffer(*mesh2, torusPicking_.getPickingId(i++));
-        mesh->Mesh::append(*mesh2);
+        parts.push_back(mesh2);
     }
 
+    mesh->Mesh::append(
+        util::transform(parts, [](const auto& part) -> const Mesh* { return part.get(); }));
     mesh_.setData(mesh);
 }
 
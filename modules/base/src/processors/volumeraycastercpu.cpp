@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumeraycastercpu.h>
+#include <modules/base/algorithm/image/renderbufferram.h>
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+#include <inviwo/core/algorithm/boundingbox.h>
+#include <inviwo/core/datastructures/image/image.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo VolumeRaycasterCPU::processorInfo_{
+    "org.inviwo.VolumeRaycasterCPU",  // Class identifier
+    "Volume Raycaster CPU",           // Display name
+    "Volume Rendering",               // Category
+    CodeState::Experimental,          // Code state
+    Tags::CPU,                        // Tags
+};
+const ProcessorInfo VolumeRaycasterCPU::getProcessorInfo() const { return processorInfo_; }
+
+VolumeRaycasterCPU::VolumeRaycasterCPU()
+    : Processor()
+    , volume_("volume")
+    , backgroundPort_("background")
+    , outport_("image")
+    , channel_("channel", "Channel", 0, 0, 3)
+    , transferFunction_("transferFunction", "Transfer Function", &volume_)
+    , samplingRate_("samplingRate", "Sampling Rate", 2.0f, 0.1f, 16.0f)
+    , camera_("camera", "Camera", util::boundingBox(volume_))
+    , trackball_(&camera_)
+    , background_("backgroundColor", "Background", vec4(0.0f), vec4(0.0f), vec4(1.0f)) {
+
+    addPort(volume_);
+    addPort(backgroundPort_).setOptional(true);
+    addPort(outport_);
+
+    background_.setSemantics(PropertySemantics::Color);
+    addProperties(channel_, transferFunction_, samplingRate_, camera_, trackball_, background_);
+
+    volume_.onChange([this]() {
+        if (volume_.hasData()) {
+            const auto channels = volume_.getData()->getDataFormat()->getComponents();
+            channel_.setMaxValue(channels - 1);
+        }
+    });
+}
+
+void VolumeRaycasterCPU::process() {
+    auto target = backgroundPort_.hasData()
+                      ? util::RenderBufferRAM(*backgroundPort_.getData())
+                      : util::RenderBufferRAM(outport_.getDimensions(), background_.get());
+
+    // only normalize the volume again when it changed, not for every new camera or transfer
+    // function
+    if (volume_.isChanged() || channel_.isModified() || !normalized_) {
+        normalized_ = util::normalizeVolumeChannel(*volume_.getData(), channel_.get());
+    }
+
+    util::VolumeRaycastingSettings settings;
+    settings.samplingRate = samplingRate_.get();
+    settings.channel = channel_.get();
+    util::raycastVolume(*volume_.getData(), *normalized_, transferFunction_.get(), camera_.get(),
+                        target, settings);
+
+    outport_.setData(target.toImage());
+}
+
+}  // namespace inviwo
@@ -28,6 +28,13 @@
  *********************************************************************************/
 
 #include <modules/base/processors/volumesequenceelementselectorprocessor.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <chrono>
 
 namespace inviwo {
 
@@ -42,9 +49,109 @@ const ProcessorInfo VolumeSequenceElementSelectorProcessor::getProcessorInfo() c
     return processorInfo_;
 }
 VolumeSequenceElementSelectorProcessor::VolumeSequenceElementSelectorProcessor()
-    : VectorElementSelectorProcessor<Volume>() {
+    : VectorElementSelectorProcessor<Volume>()
+    , prefetch_("prefetch", "Prefetch")
+    , prefetchSteps_("prefetchSteps", "Prefetch Steps", 2, 0, 64)
+    , memoryBudget_("memoryBudget", "Memory Budget (MB)", 4096, 0, 262144, 256) {
     timeStep_.index_.autoLinkToProperty<VolumeSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    prefetch_.addProperties(prefetchSteps_, memoryBudget_);
+    prefetch_.setCollapsed(true);
+    addProperty(prefetch_);
+}
+
+void VolumeSequenceElementSelectorProcessor::process() {
+    VectorElementSelectorProcessor<Volume>::process();
+
+    if (auto data = inport_.getData(); data && !data->empty()) {
+        const size_t index =
+            std::min(data->size() - 1, static_cast<size_t>(timeStep_.index_.get() - 1));
+        prefetch(*data, index);
+    }
+}
+
+void VolumeSequenceElementSelectorProcessor::prefetch(
+    const std::vector<std::shared_ptr<Volume>>& volumes, size_t index) {
+
+    // collect finished background loads
+    util::map_erase_remove_if(pending_, [this](auto& item) {
+        if (item.second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+        try {
+            item.second.get();
+        } catch (const Exception& e) {
+            LogProcessorWarn("Could not prefetch volume: " << e.getMessage());
+        }
+        return true;
+    });
+
+    // the selected volume first, then alternating forward and backward. The sequence is
+    // considered cyclic since the timer might loop.
+    const size_t steps = std::min(prefetchSteps_.get(), (volumes.size() - 1) / 2);
+    std::vector<std::shared_ptr<Volume>> window{volumes[index]};
+    for (size_t i = 1; i <= steps; ++i) {
+        window.push_back(volumes[(index + i) % volumes.size()]);
+        window.push_back(volumes[(index + volumes.size() - i) % volumes.size()]);
+    }
+
+    // touch the window in reverse order of priority, leaving the selected volume in front
+    for (auto it = window.rbegin(); it != window.rend(); ++it) {
+        const auto& volume = *it;
+        lru_.remove_if([&](const std::weak_ptr<Volume>& item) {
+            auto v = item.lock();
+            return !v || v == volume;
+        });
+        lru_.push_front(volume);
+    }
+
+    for (const auto& volume : window) {
+        if (!volume || volume->hasRepresentation<VolumeRAM>() ||
+            pending_.find(volume.get()) != pending_.end()) {
+            continue;
+        }
+        // getRepresentation is synchronized, a concurrent request on the main thread
+        // will wait for the background load to finish
+        pending_.emplace(volume.get(),
+                         dispatchPool([volume]() { volume->getRepresentation<VolumeRAM>(); }));
+    }
+
+    evict(volumes, window);
+}
+
+void VolumeSequenceElementSelectorProcessor::evict(
+    const std::vector<std::shared_ptr<Volume>>& volumes,
+    const std::vector<std::shared_ptr<Volume>>& window) {
+    const auto ramSize = [](const Volume& volume) -> size_t {
+        if (!volume.hasRepresentation<VolumeRAM>()) return 0;
+        return glm::compMul(volume.getDimensions()) * volume.getDataFormat()->getSize();
+    };
+
+    const size_t budget = memoryBudget_.get() * 1024 * 1024;
+    size_t total = 0;
+    for (const auto& item : lru_) {
+        if (auto volume = item.lock()) total += ramSize(*volume);
+    }
+
+    // Only volumes that can be reloaded from disk and that are not in the window or being
+    // loaded are unloaded. A disk representation that is no longer valid means the data was
+    // edited, then the RAM representation holds the only copy of it. Volumes that are owned by
+    // anything but the input sequence and the local pointer are left alone, someone else might
+    // be holding on to their RAM representation. A RAM representation that is not valid is not
+    // removed either, getting it would first download the data from its valid representation.
+    for (auto it = lru_.rbegin(); it != lru_.rend() && total > budget; ++it) {
+        auto volume = it->lock();
+        if (!volume || volume.use_count() != 2 || !util::contains(volumes, volume) ||
+            util::contains(window, volume) || pending_.find(volume.get()) != pending_.end() ||
+            !volume->hasValidRepresentation<VolumeDisk>() ||
+            !volume->hasValidRepresentation<VolumeRAM>()) {
+            continue;
+        }
+        const auto size = ramSize(*volume);
+        volume->removeRepresentation(volume->getRepresentation<VolumeRAM>());
+        total -= size;
+    }
 }
 
 }  // namespace inviwo
@@ -32,7 +32,11 @@
 #include <inviwo/core/io/datareaderfactory.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/rawvolumereader.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/zip.h>
+
+#include <future>
 
 namespace inviwo {
 
@@ -166,45 +170,81 @@ void VolumeSequenceSource::loadFolder(bool deserialize) {
 
     volumes_ = std::make_shared<VolumeSequence>();
 
-    auto files = filesystem::getDirectoryContents(folder_.get());
-    for (auto f : files) {
+    std::vector<std::string> files;
+    for (auto f : filesystem::getDirectoryContents(folder_.get())) {
         auto file = folder_.get() + "/" + f;
         if (filesystem::wildcardStringMatch(filter_, file)) {
-            std::string ext = filesystem::getFileExtension(file);
+            files.push_back(file);
+        }
+    }
+    if (files.empty()) {
+        outport_.detachData();
+        return;
+    }
+
+    // Most volume readers only parse the header and return a disk representation, the actual
+    // data is loaded on first use. The readers are created per file, since they are not
+    // guaranteed to be thread safe.
+    const auto readFile = [rf = rf_](const std::string& file, MetaDataOwner* metadata) {
+        const auto ext = filesystem::getFileExtension(file);
+        if (auto reader1 = rf->getReaderForTypeAndExtension<Volume>(ext)) {
+            return std::make_shared<VolumeSequence>(1, reader1->readData(file, metadata));
+        } else if (auto reader2 = rf->getReaderForTypeAndExtension<VolumeSequence>(ext)) {
+            return reader2->readData(file, metadata);
+        } else {
+            throw DataReaderException("Could not find a data reader for file: " + file,
+                                      IVW_CONTEXT_CUSTOM("VolumeSequenceSource"));
+        }
+    };
+
+    // The RawVolumeReader asks the user for the data format in a dialog and remembers the answer
+    // in the metadata of the processor. Such files are read on the main thread, all other files
+    // are read on the pool without access to the metadata.
+    const auto needsMainThread = [rf = rf_](const std::string& file) {
+        const auto reader =
+            rf->getReaderForTypeAndExtension<Volume>(filesystem::getFileExtension(file));
+        return dynamic_cast<const RawVolumeReader*>(reader.get()) != nullptr;
+    };
+
+    std::vector<std::future<std::shared_ptr<VolumeSequence>>> results;
+    results.reserve(files.size());
+    for (const auto& file : files) {
+        if (needsMainThread(file)) {
+            std::promise<std::shared_ptr<VolumeSequence>> result;
             try {
-                if (auto reader1 = rf_->getReaderForTypeAndExtension<Volume>(ext)) {
-                    auto volume = reader1->readData(file, this);
-                    volume->setMetaData<StringMetaData>("filename", file);
-                    volumes_->push_back(volume);
-
-                } else if (auto reader2 = rf_->getReaderForTypeAndExtension<VolumeSequence>(ext)) {
-                    auto volumes = reader2->readData(file, this);
-                    for (auto volume : *volumes) {
-                        volume->setMetaData<StringMetaData>("filename", file);
-                        volumes_->push_back(volume);
-                    }
-                } else {
-                    LogProcessorError("Could not find a data reader for file: " << file);
-                    volumes_.reset();
-                    loadingFailed_ = true;
-                    isReady_.update();
-                }
-            } catch (DataReaderException const& e) {
-                LogProcessorError(e.getMessage());
-                volumes_.reset();
-                loadingFailed_ = true;
-                isReady_.update();
+                result.set_value(readFile(file, this));
+            } catch (...) {
+                result.set_exception(std::current_exception());
             }
+            results.push_back(result.get_future());
+        } else {
+            results.push_back(dispatchPool([readFile, file]() { return readFile(file, nullptr); }));
         }
     }
 
-    if (volumes_ && !volumes_->empty()) {
-        // store filename in metadata
-        for (auto volume : *volumes_) {
-            if (!volume->hasMetaData<StringMetaData>("filename"))
-                volume->setMetaData<StringMetaData>("filename", file_.get());
+    // Wait for all files, also after a failure, so no read is left running.
+    const auto fail = [this](const std::string& message) {
+        LogProcessorError(message);
+        volumes_.reset();
+        loadingFailed_ = true;
+        isReady_.update();
+    };
+    for (auto&& [file, result] : util::zip(files, results)) {
+        try {
+            for (auto volume : *result.get()) {
+                volume->setMetaData<StringMetaData>("filename", file);
+                if (volumes_) volumes_->push_back(volume);
+            }
+        } catch (const Exception& e) {
+            fail(e.getMessage());
+        } catch (const std::exception& e) {
+            fail("Could not read file: " + file + " (" + e.what() + ")");
+        } catch (...) {
+            fail("Could not read file: " + file);
         }
+    }
 
+    if (volumes_ && !volumes_->empty()) {
         // set basis of first volume
         if ((*volumes_)[0]) {
             basis_.updateForNewEntity(*(*volumes_)[0], deserialize);
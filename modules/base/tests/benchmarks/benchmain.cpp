@@ -37,9 +37,15 @@
 #include <modules/base/algorithm/volume/marchingcubes.h>
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
 
+#include <modules/base/datastructures/kdtree.h>
+
+#include <modules/base/algorithm/mesh/meshclipping.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
+
 #include <benchmark/benchmark.h>
 
 #include <cmath>
+#include <random>
 
 #include <warn/push>
 #include <warn/ignore/unused-function>
@@ -144,6 +150,147 @@ BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
 // BENCHMARK(SphereNew)->Arg(5);
 
+namespace {
+
+std::vector<vec3> randomPoints(size_t count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(count);
+    for (auto& p : points) p = vec3{dist(rng), dist(rng), dist(rng)};
+    return points;
+}
+
+constexpr size_t kdQueries = 1 << 12;
+constexpr int kdNeighbors = 8;
+
+}  // namespace
+
+static void KDTreeBuildOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    for (auto _ : state) {
+        K3DTree<size_t, float> tree;
+        for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+        benchmark::DoNotOptimize(tree.getRoot());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void KDTreeBuildFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    for (auto _ : state) {
+        FlatKDTree<3, float> tree(points);
+        benchmark::DoNotOptimize(tree.depth());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void KDTreeKNNOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(kdQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            auto nodes = tree.findNNearest(q, kdNeighbors);
+            benchmark::DoNotOptimize(nodes.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kdQueries);
+}
+
+static void KDTreeKNNFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(kdQueries, 1);
+    const FlatKDTree<3, float> tree(points);
+
+    for (auto _ : state) {
+        auto indices = tree.findNNearest(queries, kdNeighbors);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kdQueries);
+}
+
+static void KDTreeRadiusOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(kdQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            auto nodes = tree.findCloseTo(q, 0.02f);
+            benchmark::DoNotOptimize(nodes.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kdQueries);
+}
+
+static void KDTreeRadiusFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(kdQueries, 1);
+    const FlatKDTree<3, float> tree(points);
+
+    for (auto _ : state) {
+        auto indices = tree.findCloseTo(queries, 0.02f);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kdQueries);
+}
+
+BENCHMARK(KDTreeBuildOld)->RangeMultiplier(4)->Range(1 << 10, 1 << 18)->UseRealTime();
+BENCHMARK(KDTreeBuildFlat)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->UseRealTime();
+BENCHMARK(KDTreeKNNOld)->RangeMultiplier(4)->Range(1 << 10, 1 << 18)->UseRealTime();
+BENCHMARK(KDTreeKNNFlat)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->UseRealTime();
+BENCHMARK(KDTreeRadiusOld)->RangeMultiplier(4)->Range(1 << 10, 1 << 18)->UseRealTime();
+BENCHMARK(KDTreeRadiusFlat)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->UseRealTime();
+
+namespace {
+
+// A sphere with size x size quads and shared vertices, 2 * size^2 triangles
+std::shared_ptr<BasicMesh> createSphere(std::uint32_t size) {
+    auto mesh = std::make_shared<BasicMesh>();
+    const auto pi = glm::pi<float>();
+    for (std::uint32_t j = 0; j <= size; ++j) {
+        const auto theta = pi * static_cast<float>(j) / static_cast<float>(size);
+        for (std::uint32_t i = 0; i < size; ++i) {
+            const auto phi = 2.0f * pi * static_cast<float>(i) / static_cast<float>(size);
+            const vec3 pos{std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+                           std::cos(theta)};
+            mesh->addVertex(pos, pos, pos, vec4{1.0f});
+        }
+    }
+    auto indices = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
+    auto& data = indices->getDataContainer();
+    data.reserve(size_t{6} * size * size);
+    const auto index = [&](std::uint32_t i, std::uint32_t j) { return (i % size) + j * size; };
+    for (std::uint32_t j = 0; j < size; ++j) {
+        for (std::uint32_t i = 0; i < size; ++i) {
+            data.insert(data.end(), {index(i, j), index(i, j + 1), index(i + 1, j + 1)});
+            data.insert(data.end(), {index(i, j), index(i + 1, j + 1), index(i + 1, j)});
+        }
+    }
+    return mesh;
+}
+
+}  // namespace
+
+static void MeshClipping(benchmark::State& state) {
+    const auto sphere = createSphere(static_cast<std::uint32_t>(state.range(0)));
+    const Plane plane{vec3{0.1f, 0.0f, 0.0f}, glm::normalize(vec3{1.0f, 0.5f, 0.25f})};
+    const bool cap = state.range(1) != 0;
+    for (auto _ : state) {
+        auto clipped = meshutil::clipMeshAgainstPlane(*sphere, plane, cap);
+        benchmark::DoNotOptimize(clipped);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0) * state.range(0));
+}
+
+BENCHMARK(MeshClipping)
+    ->RangeMultiplier(4)
+    ->Ranges({{64, 2048}, {0, 1}})
+    ->UseRealTime();
+
 int main(int argc, char** argv) {
 
     benchmark::Initialize(&argc, argv);
@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <modules/base/algorithm/volume/volumeramdistancetransform.h>
+#include <modules/base/algorithm/image/layerramdistancetransform.h>
+
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+const std::vector<size3_t> features{{1, 1, 1}, {6, 4, 0}, {3, 5, 4}};
+
+template <typename U>
+void testVolumeDistanceTransform(double tolerance) {
+    const size3_t dim{8, 6, 5};
+    const util::IndexMapper3D im(dim);
+    VolumeRAMPrecision<unsigned char> in(dim);
+    std::fill(in.getDataTyped(), in.getDataTyped() + glm::compMul(dim), 0);
+    for (const auto& f : features) in.getDataTyped()[im(f)] = 255;
+
+    VolumeRAMPrecision<U> out(dim);
+    // unit voxel size with an anisotropic z axis
+    const mat3 basis{vec3{8.0f, 0.0f, 0.0f}, vec3{0.0f, 6.0f, 0.0f}, vec3{0.0f, 0.0f, 10.0f}};
+
+    util::volumeRAMDistanceTransform(
+        &in, &out, basis, size3_t{1},
+        [](const unsigned char& v) { return v > 127; }, [](const float& d) { return d; },
+        [](double) {});
+
+    for (size_t z = 0; z < dim.z; ++z) {
+        for (size_t y = 0; y < dim.y; ++y) {
+            for (size_t x = 0; x < dim.x; ++x) {
+                double expected = std::numeric_limits<double>::max();
+                for (const auto& f : features) {
+                    const dvec3 d = (dvec3{x, y, z} - dvec3{f}) * dvec3{1.0, 1.0, 2.0};
+                    expected = std::min(expected, glm::dot(d, d));
+                }
+                EXPECT_NEAR(expected, static_cast<double>(out.getDataTyped()[im(x, y, z)]),
+                            tolerance * std::max(1.0, expected))
+                    << "at " << x << ", " << y << ", " << z;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(DistanceTransform, volumeFloat) { testVolumeDistanceTransform<float>(1.0e-5); }
+
+TEST(DistanceTransform, volumeHalf) { testVolumeDistanceTransform<f16>(1.0e-3); }
+
+TEST(DistanceTransform, layer) {
+    const size2_t dim{9, 7};
+    const util::IndexMapper2D im(dim);
+    LayerRAMPrecision<float> in(dim);
+    std::fill(in.getDataTyped(), in.getDataTyped() + glm::compMul(dim), 0.0f);
+    in.getDataTyped()[im(2, 3)] = 1.0f;
+    in.getDataTyped()[im(8, 0)] = 1.0f;
+
+    LayerRAMPrecision<float> out(dim);
+    util::layerRAMDistanceTransform(
+        &in, &out, mat2{vec2{9.0f, 0.0f}, vec2{0.0f, 7.0f}}, size2_t{1},
+        [](const float& v) { return v > 0.5f; }, [](const float& d) { return std::sqrt(d); },
+        [](double) {});
+
+    for (size_t y = 0; y < dim.y; ++y) {
+        for (size_t x = 0; x < dim.x; ++x) {
+            const auto expected = std::min(glm::distance(dvec2{x, y}, dvec2{2.0, 3.0}),
+                                           glm::distance(dvec2{x, y}, dvec2{8.0, 0.0}));
+            EXPECT_NEAR(expected, out.getDataTyped()[im(x, y)], 1.0e-5)
+                << "at " << x << ", " << y;
+        }
+    }
+}
+
+TEST(DistanceTransform, noFeatures) {
+    const size2_t dim{4, 3};
+    LayerRAMPrecision<float> in(dim);
+    std::fill(in.getDataTyped(), in.getDataTyped() + glm::compMul(dim), 0.0f);
+
+    LayerRAMPrecision<float> out(dim);
+    util::layerRAMDistanceTransform(
+        &in, &out, mat2{vec2{4.0f, 0.0f}, vec2{0.0f, 3.0f}}, size2_t{1},
+        [](const float& v) { return v > 0.5f; }, [](const float& d) { return std::sqrt(d); },
+        [](double) {});
+
+    // all pixels are further away than the diagonal
+    for (size_t i = 0; i < glm::compMul(dim); ++i) {
+        EXPECT_GT(out.getDataTyped()[i], 5.0f);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,89 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <modules/base/algorithm/image/imagecontour.h>
+
+namespace inviwo {
+
+TEST(ImageContour, ClosedLoops) {
+    const size2_t dim{40, 30};
+    LayerRAMPrecision<float> layer(dim);
+    auto data = layer.getDataTyped();
+    const auto gaussian = [](vec2 p, vec2 center, float s) {
+        return std::exp(-glm::dot(p - center, p - center) / s);
+    };
+    for (size_t y = 0; y < dim.y; ++y) {
+        for (size_t x = 0; x < dim.x; ++x) {
+            const auto p = vec2(x, y);
+            data[x + y * dim.x] =
+                gaussian(p, vec2(15.3f, 14.7f), 40.0f) + gaussian(p, vec2(30.1f, 10.2f), 20.0f);
+        }
+    }
+
+    // Two separate peaks at 0.5, they merge at 0.1
+    auto mesh = ImageContour::apply(&layer, 0, {0.5, 0.1}, {vec4(1.0f)});
+    ASSERT_TRUE(mesh);
+    ASSERT_EQ(3, mesh->getNumberOfIndicies());
+
+    size_t indices = 0;
+    for (size_t i = 0; i < mesh->getNumberOfIndicies(); ++i) {
+        EXPECT_EQ(DrawType::Lines, mesh->getIndexMeshInfo(i).dt);
+        EXPECT_EQ(ConnectivityType::Loop, mesh->getIndexMeshInfo(i).ct);
+        indices += mesh->getIndices(i)->getSize();
+    }
+    // Each vertex is shared by two segments of a loop
+    EXPECT_EQ(indices, mesh->getBuffer(0)->getSize());
+}
+
+TEST(ImageContour, OpenStrip) {
+    const size2_t dim{16, 9};
+    LayerRAMPrecision<unsigned char> layer(dim);
+    auto data = layer.getDataTyped();
+    for (size_t y = 0; y < dim.y; ++y) {
+        for (size_t x = 0; x < dim.x; ++x) {
+            data[x + y * dim.x] = static_cast<unsigned char>(x * 255 / (dim.x - 1));
+        }
+    }
+
+    auto mesh = ImageContour::apply(&layer, 0, 0.5);
+    ASSERT_TRUE(mesh);
+    ASSERT_EQ(1, mesh->getNumberOfIndicies());
+    EXPECT_EQ(ConnectivityType::Strip, mesh->getIndexMeshInfo(0).ct);
+    EXPECT_EQ(dim.y, mesh->getIndices(0)->getSize());
+    EXPECT_EQ(dim.y, mesh->getBuffer(0)->getSize());
+}
+
+}  // namespace inviwo
@@ -34,6 +34,8 @@
 
 #include <modules/base/datastructures/kdtree.h>
 
+#include <random>
+
 namespace inviwo {
 
 TEST(KDTreeTests, init) { KDTree<3, char, float> tree; }
@@ -133,4 +135,65 @@ TEST(KDTreeTests, findNClosests) {
     EXPECT_EQ(n100.size(), 100);
 }
 
+TEST(FlatKDTreeTests, matchesBruteForce) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(5000);
+    for (auto& p : points) p = vec3{dist(rng), dist(rng), dist(rng)};
+    // add some duplicates
+    std::fill(points.begin(), points.begin() + 100, points.front());
+
+    const FlatKDTree<3, float> tree(points, 8);
+    ASSERT_EQ(points.size(), tree.size());
+
+    std::vector<vec3> queries(100);
+    for (auto& q : queries) q = vec3{dist(rng), dist(rng), dist(rng)};
+
+    const size_t k = 10;
+    const float radius = 0.1f;
+    const auto nearest = tree.findNNearest(queries, k);
+    const auto close = tree.findCloseTo(queries, radius);
+    ASSERT_EQ(queries.size() * k, nearest.size());
+    ASSERT_EQ(queries.size(), close.size());
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        std::vector<float> sqDists;
+        for (const auto& p : points) sqDists.push_back(glm::dot(p - queries[i], p - queries[i]));
+        auto sorted = sqDists;
+        std::sort(sorted.begin(), sorted.end());
+
+        for (size_t j = 0; j < k; ++j) {
+            EXPECT_EQ(sorted[j], sqDists[nearest[i * k + j]]);
+        }
+        EXPECT_EQ(sorted[0], sqDists[tree.findNearest(queries[i])]);
+
+        const auto inside = std::count_if(sqDists.begin(), sqDists.end(),
+                                          [&](float d) { return d <= radius * radius; });
+        EXPECT_EQ(static_cast<size_t>(inside), close[i].size());
+        for (auto index : close[i]) {
+            EXPECT_LE(sqDists[index], radius * radius);
+        }
+    }
+}
+
+TEST(FlatKDTreeTests, small) {
+    const FlatKDTree<2, double> empty(std::vector<dvec2>{});
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(FlatKDTree<2>::npos, empty.findNearest(dvec2{0.0}));
+
+    const FlatKDTree<2, double> tree(std::vector<dvec2>{{0.0, 0.0}, {1.0, 0.0}, {0.0, 2.0}});
+    EXPECT_EQ(1u, tree.findNearest(dvec2{0.9, 0.1}));
+    EXPECT_EQ((std::vector<size_t>{2, 0, 1}), tree.findNNearest(dvec2{0.0, 1.9}, 5));
+    EXPECT_EQ(dvec2(0.0, 2.0), tree.getPoint(2));
+}
+
+TEST(FlatKDTreeTests, zeroNeighbors) {
+    const FlatKDTree<2, double> tree(std::vector<dvec2>{{0.0, 0.0}, {1.0, 0.0}, {0.0, 2.0}});
+    std::vector<size_t> result{1, 2, 3};
+    tree.findNNearest(dvec2{0.5, 0.5}, 0, result);
+    EXPECT_TRUE(result.empty());
+    EXPECT_TRUE(tree.findNNearest(dvec2{0.5, 0.5}, 0).empty());
+    EXPECT_TRUE(tree.findNNearest(std::vector<dvec2>{{0.0, 0.0}, {1.0, 1.0}}, 0).empty());
+}
+
 }  // namespace inviwo
\ No newline at end of file
@@ -186,4 +186,41 @@ TEST(MeshCutting, PlaneBasis) {
     }
 }
 
+TEST(MeshCutting, GatherLoopsWelded) {
+    // Two edges of a square have separate copies of their shared corner
+    const std::vector<vec3> positions{vec3{0, 0, 0}, vec3{1, 0, 0}, vec3{1, 0, 0},
+                                      vec3{1, 1, 0}, vec3{0, 1, 0}};
+    std::vector<glm::u32vec2> edges{{0, 1}, {2, 3}, {3, 4}, {4, 0}};
+
+    const auto loops = meshutil::detail::gatherLoops(edges, positions, 0.0000001f);
+
+    ASSERT_EQ(loops.size(), 1);
+    ASSERT_EQ(loops[0].size(), 4);
+    EXPECT_TRUE(edges.empty());
+}
+
+TEST(MeshCutting, ClipCube) {
+    const auto cube = meshutil::cube(mat4{1.0f}, vec4{1.0f});
+    const Plane plane{vec3{0.5f}, vec3{0, 0, 1}};
+
+    const auto clipped = meshutil::clipMeshAgainstPlane(*cube, plane, false);
+    ASSERT_EQ(clipped->getNumberOfIndicies(), 1);
+
+    const auto positions = static_cast<const BufferRAMPrecision<vec3>*>(
+        clipped->getBuffer(BufferType::PositionAttrib)->getRepresentation<BufferRAM>());
+    const auto indices = clipped->getIndexBuffers()[0].second->getRAMRepresentation();
+
+    // The top face is kept, each side face gives three triangles with three shared new vertices
+    EXPECT_EQ(indices->getSize(), 3 * 14);
+    EXPECT_EQ(positions->getSize(), 24 + 4 * 3);
+    for (auto i : indices->getDataContainer()) {
+        EXPECT_GE((*positions)[i].z, 0.5f - 0.000001f);
+    }
+
+    const auto capped = meshutil::clipMeshAgainstPlane(*cube, plane, true);
+    ASSERT_EQ(capped->getNumberOfIndicies(), 2);
+    // The cut is one loop through the four corners and the middle of each side face
+    EXPECT_EQ(capped->getIndexBuffers()[1].second->getSize(), 3 * 8);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/camera/perspectivecamera.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <modules/base/algorithm/mesh/meshrasterization.h>
+
+#include <array>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<const Mesh> makeQuad(const std::array<vec3, 4>& corners, vec4 color) {
+    auto mesh = std::make_shared<Mesh>();
+    mesh->addBuffer(BufferType::PositionAttrib,
+                    util::makeBuffer(std::vector<vec3>(corners.begin(), corners.end())));
+    mesh->addBuffer(BufferType::ColorAttrib, util::makeBuffer(std::vector<vec4>(4, color)));
+    mesh->addIndices(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None},
+                     util::makeIndexBuffer({0, 1, 2, 0, 2, 3}));
+    return mesh;
+}
+
+std::shared_ptr<const Mesh> makeSquare(float z, vec4 color) {
+    return makeQuad({vec3(-0.5f, -0.5f, z), vec3(0.5f, -0.5f, z), vec3(0.5f, 0.5f, z),
+                     vec3(-0.5f, 0.5f, z)},
+                    color);
+}
+
+const vec4 clearColor{0.0f, 0.0f, 0.0f, 0.0f};
+const vec4 red{1.0f, 0.0f, 0.0f, 1.0f};
+const vec4 green{0.0f, 1.0f, 0.0f, 1.0f};
+
+}  // namespace
+
+TEST(MeshRasterization, Coverage) {
+    const PerspectiveCamera camera;
+    util::RenderBufferRAM target(size2_t{32, 32}, clearColor);
+    util::rasterizeMeshes({makeSquare(0.0f, red)}, camera, target);
+
+    const auto center = target.index(size2_t{16, 16});
+    EXPECT_EQ(red, target.color[center]);
+    EXPECT_GT(target.depth[center], 0.0f);
+    EXPECT_LT(target.depth[center], 1.0f);
+
+    // The square covers roughly the pixels [9, 23) in each direction
+    for (auto pos : {size2_t{0, 0}, size2_t{5, 16}, size2_t{16, 26}, size2_t{31, 31}}) {
+        EXPECT_EQ(clearColor, target.color[target.index(pos)]);
+        EXPECT_EQ(1.0f, target.depth[target.index(pos)]);
+    }
+}
+
+TEST(MeshRasterization, DepthTest) {
+    const PerspectiveCamera camera;
+    const auto center = size2_t{16, 16};
+
+    util::RenderBufferRAM farFirst(size2_t{32, 32}, clearColor);
+    util::rasterizeMeshes({makeSquare(0.0f, red), makeSquare(0.5f, green)}, camera, farFirst);
+    EXPECT_EQ(green, farFirst.color[farFirst.index(center)]);
+
+    util::RenderBufferRAM nearFirst(size2_t{32, 32}, clearColor);
+    util::rasterizeMeshes({makeSquare(0.5f, green), makeSquare(0.0f, red)}, camera, nearFirst);
+    EXPECT_EQ(green, nearFirst.color[nearFirst.index(center)]);
+    EXPECT_EQ(farFirst.depth, nearFirst.depth);
+}
+
+TEST(MeshRasterization, TileSizeIndependent) {
+    const PerspectiveCamera camera;
+    const std::vector<std::shared_ptr<const Mesh>> meshes{makeSquare(0.0f, red),
+                                                          makeSquare(0.5f, green)};
+    util::RenderBufferRAM reference(size2_t{57, 43}, clearColor);
+    util::rasterizeMeshes(meshes, camera, reference, {vec4(1.0f), false, 0.3f, size2_t{1024}});
+
+    for (auto tileSize : {size2_t{1}, size2_t{7, 5}, size2_t{16}}) {
+        util::RenderBufferRAM target(size2_t{57, 43}, clearColor);
+        util::rasterizeMeshes(meshes, camera, target, {vec4(1.0f), false, 0.3f, tileSize});
+        EXPECT_EQ(reference.color, target.color);
+        EXPECT_EQ(reference.depth, target.depth);
+    }
+}
+
+TEST(MeshRasterization, NearPlaneClipping) {
+    // A floor below the camera that extends behind it
+    const PerspectiveCamera camera;
+    const auto floor = makeQuad({vec3(-10.0f, -0.5f, 10.0f), vec3(10.0f, -0.5f, 10.0f),
+                                 vec3(10.0f, -0.5f, -10.0f), vec3(-10.0f, -0.5f, -10.0f)},
+                                red);
+    util::RenderBufferRAM target(size2_t{32, 32}, clearColor);
+    util::rasterizeMeshes({floor}, camera, target);
+
+    EXPECT_EQ(red, target.color[target.index(size2_t{16, 0})]);
+    EXPECT_EQ(red, target.color[target.index(size2_t{0, 0})]);
+    EXPECT_EQ(clearColor, target.color[target.index(size2_t{16, 31})]);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <modules/base/algorithm/volume/volumepyramid.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+TEST(VolumePyramid, dimensions) {
+    EXPECT_EQ((std::vector<size3_t>{{8, 4, 1}, {4, 2, 1}, {2, 1, 1}, {1, 1, 1}}),
+              util::volumePyramidDimensions(size3_t{8, 4, 1}));
+    EXPECT_EQ((std::vector<size3_t>{{10, 10, 10}, {7, 7, 7}}),
+              util::volumePyramidDimensions(size3_t{10}, 1.5, 2));
+
+    const auto dims = util::volumePyramidDimensions(size3_t{100, 3, 1}, 1.01);
+    for (size_t i = 1; i < dims.size(); ++i) {
+        EXPECT_LT(glm::compMul(dims[i]), glm::compMul(dims[i - 1]));
+    }
+    EXPECT_EQ(size3_t{1}, dims.back());
+
+    EXPECT_THROW(util::volumePyramidDimensions(size3_t{8}, 1.0), Exception);
+}
+
+TEST(VolumePyramid, resample) {
+    VolumeRAMPrecision<unsigned char> ram(size3_t{9, 6, 5});
+    std::fill(ram.getDataTyped(), ram.getDataTyped() + 9 * 6 * 5, static_cast<unsigned char>(7));
+    ram.getDataTyped()[0] = 250;
+
+    for (auto filter : {util::DownsampleFilter::Box, util::DownsampleFilter::Gaussian,
+                        util::DownsampleFilter::Max}) {
+        auto res = util::volumeResample(ram, size3_t{4, 4, 2}, filter);
+        ASSERT_EQ(size3_t(4, 4, 2), res->getDimensions());
+        ASSERT_EQ(ram.getDataFormat(), res->getDataFormat());
+        const auto data = static_cast<const unsigned char*>(res->getData());
+        if (filter == util::DownsampleFilter::Max) {
+            EXPECT_EQ(250, data[0]);
+        } else {
+            EXPECT_GT(data[0], 7);
+            EXPECT_LT(data[0], 250);
+        }
+        // voxels away from the corner keep the constant value
+        EXPECT_EQ(7, data[4 * 4 * 2 - 1]);
+    }
+}
+
+TEST(VolumePyramid, cached) {
+    auto volume =
+        std::make_shared<Volume>(std::make_shared<VolumeRAMPrecision<float>>(size3_t{16}));
+    volume->setBasis(mat3{2.0f});
+
+    const auto levels = util::cachedVolumePyramid(volume);
+    ASSERT_EQ(4u, levels.size());
+    EXPECT_EQ(size3_t{8}, levels[0]->getDimensions());
+    EXPECT_EQ(size3_t{1}, levels[3]->getDimensions());
+    EXPECT_EQ(volume->getBasis(), levels[0]->getBasis());
+
+    EXPECT_EQ(levels, util::cachedVolumePyramid(volume));
+    EXPECT_NE(levels, util::cachedVolumePyramid(volume, 2.0, util::DownsampleFilter::Max));
+
+    util::invalidateVolumePyramids(volume.get());
+    EXPECT_NE(levels, util::cachedVolumePyramid(volume));
+}
+
+TEST(VolumePyramid, cacheDoesNotOwnLevels) {
+    auto volume =
+        std::make_shared<Volume>(std::make_shared<VolumeRAMPrecision<float>>(size3_t{16}));
+
+    auto levels = util::cachedVolumePyramid(volume);
+    std::weak_ptr<const Volume> level = levels.front();
+    EXPECT_EQ(levels, util::cachedVolumePyramid(volume));
+
+    levels.clear();
+    EXPECT_TRUE(level.expired());
+    EXPECT_EQ(4u, util::cachedVolumePyramid(volume).size());
+}
+
+}  // namespace inviwo
@@ -38,6 +38,10 @@
 #include <inviwo/core/util/exception.h>
 
 #include <inviwo/dataframe/datastructures/datapoint.h>
+#include <inviwo/dataframe/datastructures/stringdictionary.h>
+
+#include <string_view>
+#include <variant>
 
 namespace inviwo {
 
@@ -52,6 +56,29 @@ public:
     virtual ~InvalidConversion() throw() {}
 };
 
+/**
+ * Value type representation of a single cell of a Column. Floating point values are stored as
+ * double, integers as std::int64_t or std::uint64_t depending on their signedness, and vectors as
+ * dvec2, dvec3, dvec4 or the corresponding 64-bit integer vectors. 8-bit integers and vectors of
+ * them are kept as they are, since they are formatted as characters. Categorical values are
+ * represented by a string_view into the categories of the column, which remains valid until the
+ * column is modified.
+ *
+ * Unlike Column::get(), accessing cells does not allocate, use std::visit for typed access.
+ */
+using CellValue = std::variant<
+    std::monostate, double, std::int64_t, std::uint64_t, std::int8_t, std::uint8_t, dvec2, dvec3,
+    dvec4, glm::vec<2, std::int64_t>, glm::vec<3, std::int64_t>, glm::vec<4, std::int64_t>,
+    glm::vec<2, std::uint64_t>, glm::vec<3, std::uint64_t>, glm::vec<4, std::uint64_t>,
+    glm::vec<2, std::int8_t>, glm::vec<3, std::int8_t>, glm::vec<4, std::int8_t>,
+    glm::vec<2, std::uint8_t>, glm::vec<3, std::uint8_t>, glm::vec<4, std::uint8_t>,
+    std::string_view>;
+
+/**
+ * \brief Format \p value the same way as Column::getAsString() does
+ */
+IVW_MODULE_DATAFRAME_API std::string toString(const CellValue &value);
+
 /**
  * \class Column
  * \brief pure interface for representing a data column, i.e. a Buffer with a name
@@ -66,6 +93,13 @@ public:
     virtual void setHeader(const std::string &header) = 0;
 
     virtual void add(const std::string &value) = 0;
+    /**
+     * \brief converts all given values and appends them to the column
+     *
+     * @param values
+     * @throws InvalidConversion if a value cannot be converted to the column type
+     */
+    virtual void append(const std::vector<std::string> &values) = 0;
 
     virtual std::shared_ptr<BufferBase> getBuffer() = 0;
     virtual std::shared_ptr<const BufferBase> getBuffer() const = 0;
@@ -80,6 +114,13 @@ public:
     virtual std::string getAsString(size_t idx) const = 0;
     virtual std::shared_ptr<DataPointBase> get(size_t idx, bool getStringsAsStrings) const = 0;
 
+    virtual CellValue getCell(size_t idx) const = 0;
+    /**
+     * \brief copy the cells of rows [\p begin, \p end) into \p dst, advancing \p stride
+     * elements for each row. No memory is allocated, \p dst must be large enough.
+     */
+    virtual void getCells(size_t begin, size_t end, CellValue *dst, size_t stride = 1) const = 0;
+
 protected:
     Column() = default;
 };
@@ -120,6 +161,13 @@ public:
      * @throws InvalidConversion if the value cannot be converted to T
      */
     virtual void add(const std::string &value) override;
+    /**
+     * \brief converts all given values to type T and appends them to the column
+     *
+     * @param values
+     * @throws InvalidConversion if a value cannot be converted to T
+     */
+    virtual void append(const std::vector<std::string> &values) override;
     virtual void set(size_t idx, const T &value);
 
     T get(size_t idx) const;
@@ -135,6 +183,10 @@ public:
      */
     virtual std::shared_ptr<DataPointBase> get(size_t idx, bool getStringsAsStrings) const override;
 
+    virtual CellValue getCell(size_t idx) const override;
+    virtual void getCells(size_t begin, size_t end, CellValue *dst,
+                          size_t stride = 1) const override;
+
     virtual double getAsDouble(size_t idx) const override;
 
     virtual dvec2 getAsDVec2(size_t idx) const override;
@@ -175,11 +227,22 @@ protected:
  *    by 0, 0, 1, 2.
  *    The original string values can be accessed using CategoricalColumn::get(index, true)
  *
+ * The categories are kept in a hash-indexed StringDictionary, adding a value is therefore
+ * amortized O(1) regardless of the number of categories. Large batches of values passed to
+ * append() are encoded in parallel on the thread pool.
+ *
  * \see TemplateColumn, \see CategoricalColumn::get()
  */
 class IVW_MODULE_DATAFRAME_API CategoricalColumn : public TemplateColumn<std::uint32_t> {
 public:
     CategoricalColumn(const std::string &header);
+    /**
+     * \brief creates a column from already encoded values, i.e. ids referring to \p categories
+     *
+     * @throws Exception if an id is not a valid index into \p categories
+     */
+    CategoricalColumn(const std::string &header, const std::vector<std::string> &categories,
+                      std::vector<std::uint32_t> ids);
     CategoricalColumn(const CategoricalColumn &rhs) = default;
     CategoricalColumn(CategoricalColumn &&rhs) = default;
 
@@ -204,20 +267,35 @@ public:
      */
     virtual std::shared_ptr<DataPointBase> get(size_t idx, bool getStringsAsStrings) const override;
 
+    /**
+     * \brief returns the category of the given index as a string_view
+     */
+    virtual CellValue getCell(size_t idx) const override;
+    virtual void getCells(size_t begin, size_t end, CellValue *dst,
+                          size_t stride = 1) const override;
+
     using TemplateColumn<std::uint32_t>::set;
     virtual void set(size_t idx, const std::string &str);
 
     virtual void add(const std::string &value) override;
 
+    /**
+     * \brief encodes and appends all given values. If the number of values is large enough and
+     * there is a thread pool available, the values are encoded in parallel using one dictionary
+     * per job, which are then merged in order. The resulting ids and category order are the same
+     * as when adding the values one by one.
+     */
+    virtual void append(const std::vector<std::string> &values) override;
+
     /**
      * Returns the unique set of categorical values.
      */
-    const std::vector<std::string> &getCategories() const { return lookUpTable_; }
+    const std::vector<std::string> &getCategories() const { return dictionary_.getStrings(); }
 
 private:
     virtual glm::uint32_t addOrGetID(const std::string &str);
 
-    std::vector<std::string> lookUpTable_;
+    StringDictionary dictionary_;
 };
 
 template <typename T>
@@ -314,6 +392,18 @@ void TemplateColumn<T>::add(const std::string &value) {
     detail::add<T>(buffer_.get(), value);
 }
 
+template <typename T>
+void TemplateColumn<T>::append(const std::vector<std::string> &values) {
+    auto &data = buffer_->getEditableRAMRepresentation()->getDataContainer();
+    if (data.capacity() < data.size() + values.size()) {
+        // grow geometrically to keep repeated appends of small batches linear
+        data.reserve(std::max(data.size() + values.size(), 2 * data.size()));
+    }
+    for (const auto &value : values) {
+        detail::add<T>(buffer_.get(), value);
+    }
+}
+
 template <typename T>
 void TemplateColumn<T>::set(size_t idx, const T &value) {
     buffer_->getEditableRAMRepresentation()->set(idx, value);
@@ -366,6 +456,38 @@ std::shared_ptr<DataPointBase> TemplateColumn<T>::get(size_t idx, bool) const {
     return std::make_shared<DataPoint<T>>(buffer_->getRAMRepresentation()->get(idx));
 }
 
+namespace detail {
+
+template <typename T>
+CellValue toCellValue(const T &value) {
+    using V = typename util::value_type<T>::type;
+    using C = std::conditional_t<
+        util::is_floating_point<V>::value, double,
+        std::conditional_t<sizeof(V) == 1, V,
+                           std::conditional_t<std::is_signed_v<V>, std::int64_t, std::uint64_t>>>;
+    using U = typename util::same_extent<T, C>::type;
+    if constexpr (util::rank<T>::value == 0) {
+        return static_cast<U>(value);
+    } else {
+        return util::glm_convert<U>(value);
+    }
+}
+
+}  // namespace detail
+
+template <typename T>
+CellValue TemplateColumn<T>::getCell(size_t idx) const {
+    return detail::toCellValue(buffer_->getRAMRepresentation()->getDataContainer()[idx]);
+}
+
+template <typename T>
+void TemplateColumn<T>::getCells(size_t begin, size_t end, CellValue *dst, size_t stride) const {
+    const auto &data = buffer_->getRAMRepresentation()->getDataContainer();
+    for (size_t i = begin; i < end; ++i, dst += stride) {
+        *dst = detail::toCellValue(data[i]);
+    }
+}
+
 template <typename T>
 T TemplateColumn<T>::operator[](const size_t idx) const {
     return get(idx);
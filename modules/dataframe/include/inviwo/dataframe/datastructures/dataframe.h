@@ -153,6 +153,18 @@ public:
 
     DataItem getDataItem(size_t index, bool getStringsAsStrings = false) const;
 
+    /**
+     * \brief fill \p result with the cells of \p numRows rows starting at \p firstRow, in
+     * row-major order, i.e. the cell of column c in row r is located at
+     * `result[(r - firstRow) * getNumberOfColumns() + c]`. The row range is clamped to the
+     * number of rows.
+     *
+     * \p result is only reallocated if its capacity is too small, reusing it for consecutive
+     * batches makes iterating over all rows free of heap allocations.
+     * @see CellValue
+     */
+    void getRows(size_t firstRow, size_t numRows, std::vector<CellValue> &result) const;
+
     const std::vector<std::pair<std::string, const DataFormatBase *>> getHeaders() const;
     std::string getHeader(size_t idx) const;
 
@@ -0,0 +1,106 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class StringDictionary
+ * \brief Hash-indexed dictionary mapping unique strings to consecutive ids.
+ *
+ * Each unique string is assigned the next free id on first insertion. The character data of all
+ * strings is interned in an arena of fixed-size blocks, which keeps the hash index keys stable
+ * while the dictionary grows. Lookups and insertions are amortized O(1).
+ *
+ * Dictionaries built independently, for example one per thread, can be combined using merge(),
+ * which returns the mapping from the ids of the merged dictionary to ids in this one.
+ */
+class IVW_MODULE_DATAFRAME_API StringDictionary {
+public:
+    StringDictionary() = default;
+    StringDictionary(const StringDictionary& rhs);
+    StringDictionary(StringDictionary&& rhs) = default;
+    StringDictionary& operator=(const StringDictionary& rhs);
+    StringDictionary& operator=(StringDictionary&& rhs) = default;
+    ~StringDictionary() = default;
+
+    /**
+     * Returns the id of \p str, the string is added to the dictionary if it does not exist.
+     */
+    std::uint32_t addOrGetID(std::string_view str);
+
+    /**
+     * Returns the id of \p str or std::nullopt if it is not part of the dictionary.
+     */
+    std::optional<std::uint32_t> getID(std::string_view str) const;
+
+    const std::string& get(std::uint32_t id) const { return strings_[id]; }
+    const std::string& operator[](std::uint32_t id) const { return strings_[id]; }
+
+    /**
+     * Returns all unique strings ordered by their id.
+     */
+    const std::vector<std::string>& getStrings() const { return strings_; }
+
+    size_t size() const { return strings_.size(); }
+    bool empty() const { return strings_.empty(); }
+
+    void reserve(size_t size);
+    void clear();
+
+    /**
+     * Add all strings of \p other to this dictionary. The order of first occurrence is
+     * preserved, i.e. new strings are appended in the order of their ids in \p other.
+     * @return lookup table mapping ids of \p other to the corresponding ids in this dictionary
+     */
+    std::vector<std::uint32_t> merge(const StringDictionary& other);
+
+private:
+    std::string_view intern(std::string_view str);
+
+    static constexpr size_t blockSize_ = 64 * 1024;
+
+    std::vector<std::string> strings_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t blockUsed_ = blockSize_;
+    std::unordered_map<std::string_view, std::uint32_t> index_;
+};
+
+}  // namespace inviwo
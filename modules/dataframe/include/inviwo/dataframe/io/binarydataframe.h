@@ -0,0 +1,96 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <iosfwd>
+
+namespace inviwo {
+
+/**
+ * \ingroup dataio
+ * \brief Writes a DataFrame in a compact binary columnar format, see BinaryDataFrameReader.
+ *
+ * The file starts with a magic number, a format version, and the number of columns. Each column
+ * is then stored as its header, a flag indicating categorical columns, the name of its data
+ * format, the number of elements, and the raw, native endian element data. Categorical columns
+ * are followed by their categories. The index column is always included.
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameWriter {
+public:
+    static const FileExtension extension;
+
+    /**
+     * @throws FileException if the file cannot be opened
+     * @throws DataWriterException if a column differs in size from the index column or the data
+     * could not be written
+     */
+    void writeData(const DataFrame& dataFrame, const std::string& filePath) const;
+    void writeData(const DataFrame& dataFrame, std::ostream& os) const;
+};
+
+/**
+ * \ingroup dataio
+ * \brief Reads a DataFrame written by the BinaryDataFrameWriter.
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameReader : public DataReaderType<DataFrame> {
+public:
+    BinaryDataFrameReader();
+    BinaryDataFrameReader(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader(BinaryDataFrameReader&&) noexcept = default;
+    BinaryDataFrameReader& operator=(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader& operator=(BinaryDataFrameReader&&) noexcept = default;
+    virtual BinaryDataFrameReader* clone() const override;
+    virtual ~BinaryDataFrameReader() = default;
+
+    using DataReaderType<DataFrame>::readData;
+
+    /**
+     * @throws FileException if the file cannot be accessed
+     * @throws DataReaderException if the file is not a valid binary DataFrame
+     */
+    virtual std::shared_ptr<DataFrame> readData(const std::string& fileName) override;
+
+    /**
+     * read a DataFrame from a binary input stream
+     *
+     * @throws DataReaderException if the stream is in a bad state, the data is truncated, or
+     * the data is not a valid binary DataFrame
+     */
+    std::shared_ptr<DataFrame> readData(std::istream& stream) const;
+};
+
+}  // namespace inviwo
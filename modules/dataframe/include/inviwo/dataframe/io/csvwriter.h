@@ -0,0 +1,76 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <ostream>
+
+namespace inviwo {
+
+/**
+ * \ingroup dataio
+ * \brief Writes a DataFrame as comma separated values.
+ *
+ * The rows are split into chunks which are formatted in parallel on the thread pool into
+ * separate buffers and then written to the output in order. At most two chunks per pool thread
+ * are kept in memory at any time.
+ */
+class IVW_MODULE_DATAFRAME_API CSVWriter {
+public:
+    CSVWriter() = default;
+
+    void setDelimiter(const std::string& delimiter);
+    void setQuoteStrings(bool quote);
+    void setExportIndexColumn(bool exportIndex);
+    /**
+     * Write each component of vector types into separate columns, otherwise the whole vector is
+     * written as one quoted string.
+     */
+    void setSeparateVectorTypesIntoColumns(bool separate);
+    void setRowsPerChunk(size_t rows);
+
+    /**
+     * @throws FileException if the file cannot be opened
+     */
+    void writeData(const DataFrame& dataFrame, const std::string& filePath) const;
+    void writeData(const DataFrame& dataFrame, std::ostream& os) const;
+
+private:
+    std::string delimiter_ = ",";
+    bool quoteStrings_ = true;
+    bool exportIndexCol_ = false;
+    bool separateVectorTypesIntoColumns_ = true;
+    size_t rowsPerChunk_ = 16384;
+};
+
+}  // namespace inviwo
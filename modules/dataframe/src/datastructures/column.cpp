@@ -28,17 +28,78 @@
  *********************************************************************************/
 
 #include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+
+#include <fmt/format.h>
 
 namespace inviwo {
 
+namespace {
+
+// Minimum number of values per job for encoding categorical values in parallel
+constexpr size_t minValuesPerJob = 16384;
+
+size_t numberOfJobs(size_t count) {
+    if (!InviwoApplication::isInitialized()) return 1;
+    const size_t poolSize = InviwoApplication::getPtr()->getPoolSize();
+    if (poolSize == 0) return 1;
+    return std::max<size_t>(1, std::min(poolSize, count / minValuesPerJob));
+}
+
+}  // namespace
+
+std::string toString(const CellValue &value) {
+    return std::visit(
+        [](const auto &v) -> std::string {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                return {};
+            } else if constexpr (std::is_same_v<T, double>) {
+                // same as the default formatting of std::ostream
+                return fmt::format("{:g}", v);
+            } else if constexpr (std::is_same_v<T, std::int64_t> ||
+                                 std::is_same_v<T, std::uint64_t>) {
+                return fmt::format("{}", v);
+            } else if constexpr (std::is_same_v<T, std::string_view>) {
+                return std::string{v};
+            } else {
+                std::ostringstream ss;
+                ss << v;
+                return ss.str();
+            }
+        },
+        value);
+}
+
 CategoricalColumn::CategoricalColumn(const std::string &header)
     : TemplateColumn<std::uint32_t>(header) {}
 
+CategoricalColumn::CategoricalColumn(const std::string &header,
+                                     const std::vector<std::string> &categories,
+                                     std::vector<std::uint32_t> ids)
+    : TemplateColumn<std::uint32_t>(header, std::move(ids)) {
+    dictionary_.reserve(categories.size());
+    for (const auto &category : categories) {
+        dictionary_.addOrGetID(category);
+    }
+    if (dictionary_.size() != categories.size()) {
+        throw Exception("Categories of column '" + header + "' are not unique", IVW_CONTEXT);
+    }
+    const auto &data = getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+    if (std::any_of(data.begin(), data.end(),
+                    [n = categories.size()](std::uint32_t id) { return id >= n; })) {
+        throw Exception("Invalid category id in column '" + header + "'", IVW_CONTEXT);
+    }
+}
+
 CategoricalColumn *CategoricalColumn::clone() const { return new CategoricalColumn(*this); }
 
 std::string CategoricalColumn::getAsString(size_t idx) const {
     auto index = getTypedBuffer()->getRAMRepresentation()->getDataContainer()[idx];
-    return lookUpTable_[index];
+    return dictionary_[index];
 }
 
 std::shared_ptr<DataPointBase> CategoricalColumn::get(size_t idx, bool getStringsAsStrings) const {
@@ -49,6 +110,18 @@ std::shared_ptr<DataPointBase> CategoricalColumn::get(size_t idx, bool getString
     }
 }
 
+CellValue CategoricalColumn::getCell(size_t idx) const {
+    const auto index = getTypedBuffer()->getRAMRepresentation()->getDataContainer()[idx];
+    return std::string_view{dictionary_[index]};
+}
+
+void CategoricalColumn::getCells(size_t begin, size_t end, CellValue *dst, size_t stride) const {
+    const auto &data = getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+    for (size_t i = begin; i < end; ++i, dst += stride) {
+        *dst = std::string_view{dictionary_[data[i]]};
+    }
+}
+
 void CategoricalColumn::set(size_t idx, const std::string &str) {
     auto id = addOrGetID(str);
     getTypedBuffer()->getEditableRAMRepresentation()->set(idx, id);
@@ -59,13 +132,56 @@ void CategoricalColumn::add(const std::string &value) {
     getTypedBuffer()->getEditableRAMRepresentation()->add(id);
 }
 
-glm::uint32_t CategoricalColumn::addOrGetID(const std::string &str) {
-    auto it = std::find(lookUpTable_.begin(), lookUpTable_.end(), str);
-    if (it != lookUpTable_.end()) {
-        return static_cast<glm::uint32_t>(std::distance(lookUpTable_.begin(), it));
+void CategoricalColumn::append(const std::vector<std::string> &values) {
+    auto &data = getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+    const size_t offset = data.size();
+    data.resize(offset + values.size());
+    std::uint32_t *ids = data.data() + offset;
+
+    const size_t jobs = numberOfJobs(values.size());
+    if (jobs <= 1) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            ids[i] = dictionary_.addOrGetID(values[i]);
+        }
+        return;
+    }
+
+    const auto range = [&](size_t job) {
+        return std::make_pair(job * values.size() / jobs, (job + 1) * values.size() / jobs);
+    };
+
+    // Encode each range with a dictionary of its own. The jobs are distributed with
+    // forEachRangeParallel, where the calling thread takes part, so this is also safe when
+    // called from a job on the pool.
+    std::vector<StringDictionary> dictionaries(jobs);
+    util::forEachRangeParallel(jobs, [&](size_t firstJob, size_t lastJob) {
+        for (size_t job = firstJob; job < lastJob; ++job) {
+            auto [begin, end] = range(job);
+            for (size_t i = begin; i < end; ++i) {
+                ids[i] = dictionaries[job].addOrGetID(values[i]);
+            }
+        }
+    });
+
+    // merging in job order preserves the order of first occurrence of each category
+    std::vector<std::vector<std::uint32_t>> mappings;
+    for (const auto &dict : dictionaries) {
+        mappings.push_back(dictionary_.merge(dict));
     }
-    lookUpTable_.push_back(str);
-    return static_cast<glm::uint32_t>(lookUpTable_.size() - 1);
+
+    util::forEachRangeParallel(jobs, [&](size_t firstJob, size_t lastJob) {
+        for (size_t job = firstJob; job < lastJob; ++job) {
+            auto [begin, end] = range(job);
+            const auto &mapping = mappings[job];
+            for (size_t i = begin; i < end; ++i) {
+                ids[i] = mapping[ids[i]];
+            }
+        }
+    });
+}
+
+glm::uint32_t CategoricalColumn::addOrGetID(const std::string &str) {
+    return dictionary_.addOrGetID(str);
 }
 
 }  // namespace inviwo
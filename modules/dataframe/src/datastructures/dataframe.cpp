@@ -134,6 +134,22 @@ DataFrame::DataItem DataFrame::getDataItem(size_t index, bool getStringsAsString
     return di;
 }
 
+void DataFrame::getRows(size_t firstRow, size_t numRows, std::vector<CellValue> &result) const {
+    const size_t nrows = getNumberOfRows();
+    firstRow = std::min(firstRow, nrows);
+    const size_t lastRow = firstRow + std::min(numRows, nrows - firstRow);
+    const size_t ncols = columns_.size();
+    result.resize((lastRow - firstRow) * ncols);
+    for (size_t col = 0; col < ncols; ++col) {
+        const size_t end = std::max(firstRow, std::min(lastRow, columns_[col]->getSize()));
+        columns_[col]->getCells(firstRow, end, result.data() + col, ncols);
+        // columns shorter than the data frame
+        for (size_t row = end; row < lastRow; ++row) {
+            result[(row - firstRow) * ncols + col] = std::monostate{};
+        }
+    }
+}
+
 void DataFrame::updateIndexBuffer() {
     const size_t nrows = getNumberOfRows();
 
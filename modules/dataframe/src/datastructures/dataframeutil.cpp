@@ -171,8 +171,10 @@ std::string createToolTipForRow(const DataFrame& dataframe, size_t rowId) {
     Document doc;
     doc.append("b", fmt::format("Data Point {}", rowId), {{"style", "color:white;"}});
     utildoc::TableBuilder tb(doc.handle(), P::end());
-    for (size_t i = 0; i < dataframe.getNumberOfColumns(); i++) {
-        tb(H(dataframe.getHeader(i)), dataframe.getColumn(i)->getAsString(rowId));
+    std::vector<CellValue> row;
+    dataframe.getRows(rowId, 1, row);
+    for (size_t i = 0; i < row.size(); i++) {
+        tb(H(dataframe.getHeader(i)), toString(row[i]));
     }
 
     return doc;
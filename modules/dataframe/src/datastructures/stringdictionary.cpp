@@ -0,0 +1,118 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/stringdictionary.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace inviwo {
+
+StringDictionary::StringDictionary(const StringDictionary& rhs) {
+    reserve(rhs.size());
+    for (const auto& str : rhs.strings_) {
+        addOrGetID(str);
+    }
+}
+
+StringDictionary& StringDictionary::operator=(const StringDictionary& rhs) {
+    if (this != &rhs) {
+        StringDictionary tmp(rhs);
+        *this = std::move(tmp);
+    }
+    return *this;
+}
+
+std::uint32_t StringDictionary::addOrGetID(std::string_view str) {
+    auto it = index_.find(str);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(strings_.size());
+    strings_.emplace_back(str);
+    index_.emplace(intern(str), id);
+    return id;
+}
+
+std::optional<std::uint32_t> StringDictionary::getID(std::string_view str) const {
+    auto it = index_.find(str);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+void StringDictionary::reserve(size_t size) {
+    strings_.reserve(size);
+    index_.reserve(size);
+}
+
+void StringDictionary::clear() {
+    strings_.clear();
+    index_.clear();
+    blocks_.clear();
+    blockUsed_ = blockSize_;
+}
+
+std::vector<std::uint32_t> StringDictionary::merge(const StringDictionary& other) {
+    std::vector<std::uint32_t> mapping(other.size());
+    reserve(size() + other.size());
+    for (size_t i = 0; i < other.strings_.size(); ++i) {
+        mapping[i] = addOrGetID(other.strings_[i]);
+    }
+    return mapping;
+}
+
+std::string_view StringDictionary::intern(std::string_view str) {
+    if (str.empty()) return {};
+
+    if (str.size() > blockSize_ / 4) {
+        // large strings get a block of their own to not waste the remainder of the current one
+        auto& block = blocks_.emplace_back(std::make_unique<char[]>(str.size()));
+        std::memcpy(block.get(), str.data(), str.size());
+        if (blocks_.size() > 1) {
+            // keep the partially filled block last
+            std::swap(blocks_[blocks_.size() - 1], blocks_[blocks_.size() - 2]);
+            return {blocks_[blocks_.size() - 2].get(), str.size()};
+        }
+        blockUsed_ = blockSize_;
+        return {blocks_.back().get(), str.size()};
+    }
+
+    if (blockUsed_ + str.size() > blockSize_) {
+        blocks_.emplace_back(std::make_unique<char[]>(blockSize_));
+        blockUsed_ = 0;
+    }
+    char* dst = blocks_.back().get() + blockUsed_;
+    std::memcpy(dst, str.data(), str.size());
+    blockUsed_ += str.size();
+    return {dst, str.size()};
+}
+
+}  // namespace inviwo
@@ -0,0 +1,281 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframe.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <ostream>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::array<char, 8> magic = {'I', 'V', 'W', 'D', 'F', 'R', 'M', '\0'};
+constexpr std::uint32_t version = 1;
+
+template <typename T>
+void write(std::ostream& os, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write(std::ostream& os, std::string_view str) {
+    write(os, static_cast<std::uint64_t>(str.size()));
+    os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+void readBytes(std::istream& is, char* dst, size_t size) {
+    is.read(dst, static_cast<std::streamsize>(size));
+    if (static_cast<size_t>(is.gcount()) != size) {
+        throw DataReaderException("Unexpected end of binary DataFrame",
+                                  IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+}
+
+template <typename T>
+T read(std::istream& is) {
+    T value;
+    readBytes(is, reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+/**
+ * The number of bytes left in the stream, or std::nullopt if the stream is not seekable.
+ */
+std::optional<std::uint64_t> remainingBytes(std::istream& is) {
+    const auto pos = is.tellg();
+    if (pos == std::istream::pos_type(-1)) return std::nullopt;
+    is.seekg(0, std::ios::end);
+    const auto end = is.tellg();
+    is.seekg(pos);
+    if (end == std::istream::pos_type(-1) || !is) {
+        is.clear();
+        is.seekg(pos);
+        return std::nullopt;
+    }
+    return static_cast<std::uint64_t>(end - pos);
+}
+
+/**
+ * Counts are read from the file, check that \p count elements of \p elementSize bytes can be
+ * left in the stream before allocating anything for them.
+ */
+void checkCount(std::istream& is, std::uint64_t count, size_t elementSize) {
+    if (const auto remaining = remainingBytes(is); remaining && count > *remaining / elementSize) {
+        throw DataReaderException("Unexpected end of binary DataFrame",
+                                  IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+}
+
+template <typename T>
+std::vector<T> readVector(std::istream& is, std::uint64_t size) {
+    checkCount(is, size, sizeof(T));
+    // Read in chunks, if the length of the stream is unknown a corrupt size then fails at the end
+    // of the stream instead of allocating memory for all of it up front.
+    constexpr std::uint64_t chunkSize = (std::uint64_t{1} << 24) / sizeof(T);
+    std::vector<T> data;
+    while (data.size() < size) {
+        const auto offset = data.size();
+        data.resize(offset + static_cast<size_t>(std::min(chunkSize, size - offset)));
+        readBytes(is, reinterpret_cast<char*>(data.data() + offset),
+                  (data.size() - offset) * sizeof(T));
+    }
+    return data;
+}
+
+std::string readString(std::istream& is) {
+    const auto chars = readVector<char>(is, read<std::uint64_t>(is));
+    return std::string(chars.begin(), chars.end());
+}
+
+struct ColumnReader {
+    template <typename Result, typename Format>
+    Result operator()(std::istream& is, const std::string& header, std::uint64_t size) {
+        using T = typename Format::type;
+        return std::make_shared<TemplateColumn<T>>(header, readVector<T>(is, size));
+    }
+};
+
+}  // namespace
+
+const FileExtension BinaryDataFrameWriter::extension{"ivwdf", "Inviwo Binary DataFrame"};
+
+void BinaryDataFrameWriter::writeData(const DataFrame& dataFrame,
+                                      const std::string& filePath) const {
+    auto file = filesystem::ofstream(filePath, std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException("BinaryDataFrameWriter: Could not open file \"" + filePath + "\".",
+                            IVW_CONTEXT);
+    }
+    writeData(dataFrame, file);
+}
+
+void BinaryDataFrameWriter::writeData(const DataFrame& dataFrame, std::ostream& os) const {
+    // the reader requires all columns to have the size of the index column
+    const auto rows = dataFrame.getIndexColumn()->getSize();
+    for (const auto& col : dataFrame) {
+        if (col->getSize() != rows) {
+            throw DataWriterException("Column '" + col->getHeader() + "' has " +
+                                          std::to_string(col->getSize()) + " rows, expected " +
+                                          std::to_string(rows) + " as in the index column",
+                                      IVW_CONTEXT);
+        }
+    }
+
+    os.write(magic.data(), magic.size());
+    write(os, version);
+    write(os, static_cast<std::uint64_t>(dataFrame.getNumberOfColumns()));
+
+    for (const auto& col : dataFrame) {
+        const auto cc = dynamic_cast<const CategoricalColumn*>(col.get());
+        write(os, std::string_view{col->getHeader()});
+        write(os, static_cast<std::uint8_t>(cc ? 1 : 0));
+        write(os, std::string_view{col->getBuffer()->getDataFormat()->getString()});
+
+        col->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>([&os](auto br) {
+            const auto& data = br->getDataContainer();
+            using T = typename std::decay_t<decltype(data)>::value_type;
+            write(os, static_cast<std::uint64_t>(data.size()));
+            os.write(reinterpret_cast<const char*>(data.data()),
+                     static_cast<std::streamsize>(data.size() * sizeof(T)));
+        });
+
+        if (cc) {
+            const auto& categories = cc->getCategories();
+            write(os, static_cast<std::uint64_t>(categories.size()));
+            for (const auto& category : categories) {
+                write(os, std::string_view{category});
+            }
+        }
+    }
+    if (!os) {
+        throw DataWriterException("Could not write binary DataFrame", IVW_CONTEXT);
+    }
+}
+
+BinaryDataFrameReader::BinaryDataFrameReader() : DataReaderType<DataFrame>() {
+    addExtension(BinaryDataFrameWriter::extension);
+}
+
+BinaryDataFrameReader* BinaryDataFrameReader::clone() const {
+    return new BinaryDataFrameReader(*this);
+}
+
+std::shared_ptr<DataFrame> BinaryDataFrameReader::readData(const std::string& fileName) {
+    auto file = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException("BinaryDataFrameReader: Could not open file \"" + fileName + "\".",
+                            IVW_CONTEXT);
+    }
+    return readData(file);
+}
+
+std::shared_ptr<DataFrame> BinaryDataFrameReader::readData(std::istream& stream) const {
+    if (!stream) {
+        throw DataReaderException("Invalid input stream", IVW_CONTEXT);
+    }
+
+    const auto fileMagic = read<std::array<char, 8>>(stream);
+    if (fileMagic != magic) {
+        throw DataReaderException("Not a binary DataFrame", IVW_CONTEXT);
+    }
+    if (const auto fileVersion = read<std::uint32_t>(stream); fileVersion != version) {
+        throw DataReaderException("Unsupported binary DataFrame version " +
+                                      std::to_string(fileVersion),
+                                  IVW_CONTEXT);
+    }
+    const auto ncols = read<std::uint64_t>(stream);
+    if (ncols == 0) {
+        throw DataReaderException("Binary DataFrame without index column", IVW_CONTEXT);
+    }
+
+    auto dataFrame = std::make_shared<DataFrame>(0u);
+    for (std::uint64_t i = 0; i < ncols; ++i) {
+        const auto header = readString(stream);
+        const bool categorical = read<std::uint8_t>(stream) != 0;
+        const auto formatName = readString(stream);
+        const auto format = DataFormatBase::get(formatName);
+        if (!format) {
+            throw DataReaderException("Unknown data format '" + formatName + "' in column '" +
+                                          header + "'",
+                                      IVW_CONTEXT);
+        }
+        const auto size = read<std::uint64_t>(stream);
+        if (const auto rows = dataFrame->getIndexColumn()->getSize(); i > 0 && size != rows) {
+            throw DataReaderException("Column '" + header + "' has " + std::to_string(size) +
+                                          " rows, expected " + std::to_string(rows),
+                                      IVW_CONTEXT);
+        }
+
+        if (i == 0) {
+            if (format->getId() != DataFormatId::UInt32 || categorical) {
+                throw DataReaderException("Invalid index column", IVW_CONTEXT);
+            }
+            dataFrame->getIndexColumn()
+                ->getTypedBuffer()
+                ->getEditableRAMRepresentation()
+                ->getDataContainer() = readVector<std::uint32_t>(stream, size);
+        } else if (categorical) {
+            if (format->getId() != DataFormatId::UInt32) {
+                throw DataReaderException("Invalid categorical column '" + header + "'",
+                                          IVW_CONTEXT);
+            }
+            auto ids = readVector<std::uint32_t>(stream, size);
+            // each category is stored with at least its length
+            const auto nCategories = read<std::uint64_t>(stream);
+            checkCount(stream, nCategories, sizeof(std::uint64_t));
+            std::vector<std::string> categories;
+            for (std::uint64_t j = 0; j < nCategories; ++j) {
+                categories.push_back(readString(stream));
+            }
+            try {
+                dataFrame->addColumn(
+                    std::make_shared<CategoricalColumn>(header, categories, std::move(ids)));
+            } catch (const Exception& e) {
+                throw DataReaderException(e.getMessage(), IVW_CONTEXT);
+            }
+        } else {
+            dataFrame->addColumn(dispatching::dispatch<std::shared_ptr<Column>,
+                                                       dispatching::filter::All>(
+                format->getId(), ColumnReader{}, stream, header, size));
+        }
+    }
+    return dataFrame;
+}
+
+}  // namespace inviwo
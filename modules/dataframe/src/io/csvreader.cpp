@@ -230,6 +230,26 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
 
     auto dataFrame = createDataFrame(exampleRows, headers);
 
+    // Values are gathered column-wise and appended in batches, which allows the columns to
+    // convert and encode many values at once
+    const size_t batchSize = 65536;
+    std::vector<std::vector<std::string>> batch(maxColCount);
+    size_t batchRows = 0;
+    auto flushBatch = [&]() {
+        for (size_t col = 0; col < batch.size(); ++col) {
+            try {
+                dataFrame->getColumn(col + 1)->append(batch[col]);
+            } catch (InvalidConversion& e) {
+                // the DataFrame is in an invalid state since all columns must be of equal size
+                throw DataTypeMismatch("Data type mismatch for column " +
+                                           dataFrame->getHeader(col + 1) + ": " + e.getMessage(),
+                                       IVW_CONTEXT);
+            }
+            batch[col].clear();
+        }
+        batchRows = 0;
+    };
+
     size_t rowIndex = firstRowHeader_ ? 1 : 0;
     auto row = extractRow(maxColCount);
     while (!row.second) {
@@ -237,13 +257,17 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
         auto emptyIt = std::find_if(std::begin(row.first), std::end(row.first),
                                     [](const auto& a) { return !a.empty(); });
         if (emptyIt != row.first.end()) {
-            // May throw DataTypeMismatch, but do not catch it here since it indicates
-            // that the DataFrame is in an invalid state
-            dataFrame->addRow(row.first);
+            for (size_t col = 0; col < row.first.size(); ++col) {
+                batch[col].push_back(std::move(row.first[col]));
+            }
+            if (++batchRows == batchSize) {
+                flushBatch();
+            }
         }
         row = extractRow(maxColCount);
         ++rowIndex;
     }
+    flushBatch();
     dataFrame->updateIndexBuffer();
     return dataFrame;
 }
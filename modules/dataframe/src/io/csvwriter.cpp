@@ -0,0 +1,211 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/csvwriter.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/ostreamjoiner.h>
+
+#include <array>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <sstream>
+
+#include <fmt/format.h>
+
+namespace inviwo {
+
+namespace {
+
+using Printer = std::function<void(fmt::memory_buffer&, size_t)>;
+
+template <typename T>
+void print(fmt::memory_buffer& buf, const T& value) {
+    if constexpr (util::is_floating_point<T>::value) {
+        // same as the default formatting of std::ostream
+        fmt::format_to(std::back_inserter(buf), "{:g}", static_cast<double>(value));
+    } else {
+        fmt::format_to(std::back_inserter(buf), "{}", value);
+    }
+}
+
+void append(fmt::memory_buffer& buf, std::string_view str) {
+    buf.append(str.data(), str.data() + str.size());
+}
+
+}  // namespace
+
+void CSVWriter::setDelimiter(const std::string& delimiter) { delimiter_ = delimiter; }
+
+void CSVWriter::setQuoteStrings(bool quote) { quoteStrings_ = quote; }
+
+void CSVWriter::setExportIndexColumn(bool exportIndex) { exportIndexCol_ = exportIndex; }
+
+void CSVWriter::setSeparateVectorTypesIntoColumns(bool separate) {
+    separateVectorTypesIntoColumns_ = separate;
+}
+
+void CSVWriter::setRowsPerChunk(size_t rows) { rowsPerChunk_ = std::max<size_t>(rows, 1); }
+
+void CSVWriter::writeData(const DataFrame& dataFrame, const std::string& filePath) const {
+    auto file = filesystem::ofstream(filePath);
+    if (!file.is_open()) {
+        throw FileException("CSVWriter: Could not open file \"" + filePath + "\".", IVW_CONTEXT);
+    }
+    writeData(dataFrame, file);
+}
+
+void CSVWriter::writeData(const DataFrame& dataFrame, std::ostream& os) const {
+    const std::string citation = quoteStrings_ ? "\"" : "";
+    const std::string delimiter = delimiter_;
+    const char lineterminator = '\n';
+    const std::array<char, 4> componentNames = {'X', 'Y', 'Z', 'W'};
+
+    // headers
+    auto oj = util::make_ostream_joiner(os, delimiter);
+    for (const auto& col : dataFrame) {
+        if ((col == dataFrame.getIndexColumn()) && !exportIndexCol_) {
+            continue;
+        }
+        const auto components = col->getBuffer()->getDataFormat()->getComponents();
+        if (components > 1 && separateVectorTypesIntoColumns_) {
+            for (size_t k = 0; k < components; k++) {
+                oj = citation + col->getHeader() + ' ' + componentNames[k] + citation;
+            }
+        } else {
+            oj = col->getHeader();
+        }
+    }
+    os << lineterminator;
+
+    std::vector<Printer> printers;
+    for (const auto& col : dataFrame) {
+        if ((col == dataFrame.getIndexColumn()) && !exportIndexCol_) {
+            continue;
+        }
+        auto df = col->getBuffer()->getDataFormat();
+        if (auto cc = dynamic_cast<const CategoricalColumn*>(col.get())) {
+            printers.push_back([cc, citation](fmt::memory_buffer& buf, size_t index) {
+                append(buf, citation);
+                append(buf, std::get<std::string_view>(cc->getCell(index)));
+                append(buf, citation);
+            });
+        } else if (df->getComponents() == 1) {
+            col->getBuffer()
+                ->getRepresentation<BufferRAM>()
+                ->dispatch<void, dispatching::filter::Scalars>([&printers](auto br) {
+                    printers.push_back([br](fmt::memory_buffer& buf, size_t index) {
+                        print(buf, br->getDataContainer()[index]);
+                    });
+                });
+        } else if (df->getComponents() > 1 && separateVectorTypesIntoColumns_) {
+            col->getBuffer()
+                ->getRepresentation<BufferRAM>()
+                ->dispatch<void, dispatching::filter::Vecs>([&printers, delimiter](auto br) {
+                    using ValueType = util::PrecisionValueType<decltype(br)>;
+                    printers.push_back([br, delimiter](fmt::memory_buffer& buf, size_t index) {
+                        const auto& value = br->getDataContainer()[index];
+                        for (size_t i = 0; i < util::flat_extent<ValueType>::value; ++i) {
+                            if (i != 0) append(buf, delimiter);
+                            print(buf, value[i]);
+                        }
+                    });
+                });
+        } else {
+            col->getBuffer()
+                ->getRepresentation<BufferRAM>()
+                ->dispatch<void, dispatching::filter::Vecs>([&printers, citation](auto br) {
+                    printers.push_back([br, citation](fmt::memory_buffer& buf, size_t index) {
+                        std::ostringstream ss;
+                        ss << citation << br->getDataContainer()[index] << citation;
+                        append(buf, ss.str());
+                    });
+                });
+        }
+    }
+
+    auto formatRows = [&printers, &delimiter](size_t begin, size_t end) {
+        fmt::memory_buffer buf;
+        for (size_t row = begin; row < end; ++row) {
+            if (row != 0) {
+                buf.push_back(lineterminator);
+            }
+            bool firstCol = true;
+            for (auto& printer : printers) {
+                if (!firstCol) {
+                    append(buf, delimiter);
+                }
+                firstCol = false;
+                printer(buf, row);
+            }
+        }
+        return buf;
+    };
+    auto write = [&os](const fmt::memory_buffer& buf) {
+        os.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+    };
+
+    const size_t nrows = dataFrame.getNumberOfRows();
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    if (poolSize == 0 || nrows <= rowsPerChunk_) {
+        write(formatRows(0, nrows));
+        return;
+    }
+
+    // format chunks in parallel, but keep the number of chunks in flight bounded and write them in
+    // order as they become ready
+    const size_t maxInFlight = 2 * poolSize;
+    std::deque<std::future<fmt::memory_buffer>> inFlight;
+    try {
+        for (size_t begin = 0; begin < nrows; begin += rowsPerChunk_) {
+            inFlight.push_back(
+                dispatchPool(formatRows, begin, std::min(nrows, begin + rowsPerChunk_)));
+            if (inFlight.size() >= maxInFlight) {
+                write(inFlight.front().get());
+                inFlight.pop_front();
+            }
+        }
+        while (!inFlight.empty()) {
+            write(inFlight.front().get());
+            inFlight.pop_front();
+        }
+    } catch (...) {
+        // the pending jobs refer to the printers, wait for them before leaving
+        for (auto& f : inFlight) {
+            if (f.valid()) f.wait();
+        }
+        throw;
+    }
+}
+
+}  // namespace inviwo
@@ -81,15 +81,26 @@ void addDataFrameColumnHelper(json::value_t valueType, std::string header, DataF
 }  // namespace detail
 
 void to_json(json& j, const DataFrame& df) {
-    for (size_t row = 0; row < df.getNumberOfRows(); ++row) {
-        json node = json::object();
-        auto items = df.getDataItem(row, true);
-        // Row 0 in the dataframe contains the row indices, which is not needed in the json object.
-        int i = 1;
-        for (auto col = ++items.begin(); col != items.end(); ++col) {
-            node[df.getHeader(i++)] = (*col)->toString();
+    const size_t nrows = df.getNumberOfRows();
+    const size_t ncols = df.getNumberOfColumns();
+    std::vector<std::string> headers;
+    for (size_t i = 0; i < ncols; ++i) {
+        headers.push_back(df.getHeader(i));
+    }
+
+    const size_t batchSize = 4096;
+    std::vector<CellValue> cells;
+    for (size_t first = 0; first < nrows; first += batchSize) {
+        df.getRows(first, batchSize, cells);
+        for (size_t row = 0; row < cells.size() / ncols; ++row) {
+            json node = json::object();
+            // Column 0 in the dataframe contains the row indices, which is not needed in the json
+            // object.
+            for (size_t col = 1; col < ncols; ++col) {
+                node[headers[col]] = toString(cells[row * ncols + col]);
+            }
+            j.emplace_back(std::move(node));
         }
-        j.emplace_back(node);
     }
 }
 
@@ -142,9 +153,13 @@ void from_json(const json& j, DataFrame& df) {
                 break;
         }
     }
-    // Extract values of each column
+    // Extract values of each column, and append them column by column
+    std::vector<std::vector<std::string>> values(df.getNumberOfColumns() - 1);
+    for (auto& column : values) {
+        column.reserve(j.size());
+    }
     for (const auto& row : j) {
-        auto colIdx = 1u;  // 0 column is index column
+        auto colIdx = 0u;  // 0 column is index column, and not part of values
         for (const auto& col : row.items()) {
             if (col.value().type() == json::value_t::object ||
                 col.value().type() == json::value_t::array ||
@@ -152,11 +167,12 @@ void from_json(const json& j, DataFrame& df) {
                 // Skip unsupported types
                 continue;
             }
-            std::stringstream ss;
-            ss << col.value();
-            df.getColumn(colIdx++)->add(ss.str());
+            values.at(colIdx++).push_back(col.value().dump());
         }
     }
+    for (size_t i = 0; i < values.size(); ++i) {
+        df.getColumn(i + 1)->append(values[i]);
+    }
     // Update index buffer when we are done
     df.updateIndexBuffer();
 }
@@ -29,9 +29,10 @@
 
 #include <inviwo/dataframe/processors/dataframeexporter.h>
 #include <inviwo/dataframe/datastructures/dataframeutil.h>
+#include <inviwo/dataframe/io/binarydataframe.h>
+#include <inviwo/dataframe/io/csvwriter.h>
 
 #include <inviwo/core/util/filesystem.h>
-#include <inviwo/core/util/ostreamjoiner.h>
 #include <inviwo/core/io/serialization/serializer.h>
 
 #include <fstream>
@@ -68,6 +69,7 @@ DataFrameExporter::DataFrameExporter()
     exportFile_.clearNameFilters();
     exportFile_.addNameFilter(csvExtension_);
     exportFile_.addNameFilter(xmlExtension_);
+    exportFile_.addNameFilter(BinaryDataFrameWriter::extension);
 
     addPort(dataFrame_);
     addProperty(exportFile_);
@@ -80,8 +82,9 @@ DataFrameExporter::DataFrameExporter()
 
     exportFile_.setAcceptMode(AcceptMode::Save);
     exportFile_.onChange([this]() {
-        separateVectorTypesIntoColumns_.setReadOnly(exportFile_.getSelectedExtension().extension_ ==
-                                                    xmlExtension_.extension_);
+        const auto& ext = exportFile_.getSelectedExtension().extension_;
+        separateVectorTypesIntoColumns_.setReadOnly(
+            ext == xmlExtension_.extension_ || ext == BinaryDataFrameWriter::extension.extension_);
     });
     exportButton_.onChange([&]() { export_ = true; });
 
@@ -102,6 +105,8 @@ void DataFrameExporter::exportNow() {
         exportAsXML();
     } else if (exportFile_.getSelectedExtension() == csvExtension_) {
         exportAsCSV(separateVectorTypesIntoColumns_);
+    } else if (exportFile_.getSelectedExtension() == BinaryDataFrameWriter::extension) {
+        exportAsBinary();
     } else {
         // use CSV format as fallback
         LogWarn("Could not determine export format from extension '"
@@ -112,90 +117,21 @@ void DataFrameExporter::exportNow() {
 }
 
 void DataFrameExporter::exportAsCSV(bool separateVectorTypesIntoColumns) {
-    std::ofstream file(exportFile_);
-    auto dataFrame = dataFrame_.getData();
-
-    const std::string delimiter = delimiter_.get();
-    std::string citation = "\"";
-    if (!quoteStrings_.get()) citation = "";
-    const char lineterminator = '\n';
-    const std::array<char, 4> componentNames = {'X', 'Y', 'Z', 'W'};
-
-    // headers
-    auto oj = util::make_ostream_joiner(file, delimiter);
-    for (const auto& col : *dataFrame) {
-        if ((col == dataFrame->getIndexColumn()) && !exportIndexCol_) {
-            continue;
-        }
-        const auto components = col->getBuffer()->getDataFormat()->getComponents();
-        if (components > 1 && separateVectorTypesIntoColumns) {
-            for (size_t k = 0; k < components; k++) {
-                oj = citation + col->getHeader() + ' ' + componentNames[k] + citation;
-            }
-        } else {
-            oj = col->getHeader();
-        }
-    }
-    file << lineterminator;
-
-    std::vector<std::function<void(std::ostream&, size_t)>> printers;
-    for (const auto& col : *dataFrame) {
-        if ((col == dataFrame->getIndexColumn()) && !exportIndexCol_) {
-            continue;
-        }
-        auto df = col->getBuffer()->getDataFormat();
-        if (auto cc = dynamic_cast<const CategoricalColumn*>(col.get())) {
-            printers.push_back([cc, citation](std::ostream& os, size_t index) {
-                os << citation << cc->getAsString(index) << citation;
-            });
-        } else if (df->getComponents() == 1) {
-            col->getBuffer()
-                ->getRepresentation<BufferRAM>()
-                ->dispatch<void, dispatching::filter::Scalars>([&printers](auto br) {
-                    printers.push_back([br](std::ostream& os, size_t index) {
-                        os << br->getDataContainer()[index];
-                    });
-                });
-        } else if (df->getComponents() > 1 && separateVectorTypesIntoColumns) {
-            col->getBuffer()
-                ->getRepresentation<BufferRAM>()
-                ->dispatch<void, dispatching::filter::Vecs>([&printers, delimiter](auto br) {
-                    using ValueType = util::PrecisionValueType<decltype(br)>;
-                    printers.push_back([br, delimiter](std::ostream& os, size_t index) {
-                        auto oj = util::make_ostream_joiner(os, delimiter);
-                        for (size_t i = 0; i < util::flat_extent<ValueType>::value; ++i) {
-                            oj = br->getDataContainer()[index][i];
-                        }
-                    });
-                });
-        } else {
-            col->getBuffer()
-                ->getRepresentation<BufferRAM>()
-                ->dispatch<void, dispatching::filter::Vecs>([&printers, citation](auto br) {
-                    printers.push_back([br, citation](std::ostream& os, size_t index) {
-                        os << citation << br->getDataContainer()[index] << citation;
-                    });
-                });
-        }
-    }
-
-    for (size_t j = 0; j < dataFrame->getNumberOfRows(); j++) {
-        if (j != 0) {
-            file << lineterminator;
-        }
-        bool firstCol = true;
-        for (auto& printer : printers) {
-            if (!firstCol) {
-                file << delimiter;
-            }
-            firstCol = false;
-            printer(file, j);
-        }
-    }
+    CSVWriter writer;
+    writer.setDelimiter(delimiter_);
+    writer.setQuoteStrings(quoteStrings_);
+    writer.setExportIndexColumn(exportIndexCol_);
+    writer.setSeparateVectorTypesIntoColumns(separateVectorTypesIntoColumns);
+    writer.writeData(*dataFrame_.getData(), exportFile_);
 
     LogInfo("CSV file exported to " << exportFile_);
 }
 
+void DataFrameExporter::exportAsBinary() {
+    BinaryDataFrameWriter{}.writeData(*dataFrame_.getData(), exportFile_);
+    LogInfo("Binary DataFrame exported to " << exportFile_);
+}
+
 void DataFrameExporter::exportAsXML() {
     auto dataFrame = dataFrame_.getData();
 
@@ -33,6 +33,7 @@
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/imageramutils.h>
 #include <inviwo/core/util/indexmapper.h>
 
@@ -179,7 +180,8 @@ void VolumeSequenceToDataFrame::process() {
     auto dataFrame = std::make_shared<DataFrame>(static_cast<std::uint32_t>(
         reduce_.get() || omitOutliers_.get() ? filteredIDs_.size() : size));
 
-    auto indexMapper = util::IndexMapper3D(dims);
+    const std::vector<size_t> indices(filteredIDs_.begin(), filteredIDs_.end());
+    std::vector<vec4> values(indices.size());
 
     size_t volumeNumber = 1;
     for (const auto volume : volumeSequence) {
@@ -197,14 +199,12 @@ void VolumeSequenceToDataFrame::process() {
         }
         volumeNumber++;
 
-        util::forEachVoxelParallel(*volumeRAM, [&, this](const size3_t &pos) {
-            const auto idx = indexMapper(pos);
-            if (filteredIDs_.find(idx) == filteredIDs_.end()) return;
-            const auto v = volumeRAM->getAsDVec4(pos);
+        volumeRAM->readIndices(indices.data(), indices.size(), values.data());
+        for (size_t i = 0; i < indices.size(); ++i) {
             for (size_t c = 0; c < numCh; c++) {
-                channelBuffer_[c]->at(idx) = float(v[c]);
+                channelBuffer_[c]->at(indices[i]) = values[i][c];
             }
-        });
+        }
     }
     outport_.setData(dataFrame);
 }
@@ -31,6 +31,10 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <array>
+#include <numeric>
 
 namespace inviwo {
 
@@ -77,168 +81,148 @@ VolumeToDataFrame::VolumeToDataFrame()
     });
 }
 
+namespace {
+
+/**
+ * Fills the DataFrame columns of one line of voxels for each entry in \p columns. Line i starts at
+ * voxel \p starts[i] and consists of \p size voxels, \p stride elements apart.
+ */
+template <typename T>
+void gatherLines(const T* data, const std::vector<size_t>& starts, size_t stride, size_t size,
+                 const std::vector<T*>& columns) {
+    std::vector<size_t> lines(columns.size());
+    std::iota(lines.begin(), lines.end(), size_t{0});
+    util::forEachParallel(lines, [&](size_t line) {
+        const T* src = data + starts[line];
+        T* dst = columns[line];
+        if (stride == 1) {
+            std::copy(src, src + size, dst);
+        } else {
+            for (size_t i = 0; i < size; ++i, src += stride) {
+                dst[i] = *src;
+            }
+        }
+    });
+}
+
+}  // namespace
+
 void VolumeToDataFrame::process() {
     const auto volume = inport_.getData();
+    const size3_t start{rangeX_.getStart(), rangeY_.getStart(), rangeZ_.getStart()};
+    const size3_t end{rangeX_.getEnd(), rangeY_.getEnd(), rangeZ_.getEnd()};
+    const size3_t extent{end - start};
+
     switch (mode_.get()) {
         case Mode::Analytics: {
-            const auto size = (rangeX_.getEnd() - rangeX_.getStart()) *
-                              (rangeY_.getEnd() - rangeY_.getStart()) *
-                              (rangeZ_.getEnd() - rangeZ_.getStart());
+            const auto size = extent.x * extent.y * extent.z;
 
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
-            std::vector<std::vector<float>*> channelBuffer_;
+            auto addColumn = [&](const std::string& header, auto type) {
+                using T = decltype(type);
+                return dataFrame->addColumn<T>(header, size)
+                    ->getTypedBuffer()
+                    ->getEditableRAMRepresentation()
+                    ->getDataContainer()
+                    .data();
+            };
+
+            std::vector<float*> channels;
             const auto numCh = volume->getDataFormat()->getComponents();
             for (size_t c = 0; c < numCh; c++) {
-                auto col = dataFrame->addColumn<float>("Channel " + toString(c + 1), size);
-                channelBuffer_.push_back(
-                    &col->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer());
+                channels.push_back(addColumn("Channel " + toString(c + 1), float{}));
             }
-            auto& magnitudes = dataFrame->addColumn<float>("Magnitude", size)
-                                   ->getTypedBuffer()
-                                   ->getEditableRAMRepresentation()
-                                   ->getDataContainer();
-            auto& indx = dataFrame->addColumn<int>("Index X", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& indy = dataFrame->addColumn<int>("Index Y", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& indz = dataFrame->addColumn<int>("Index Z", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posx = dataFrame->addColumn<float>("Position X", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posy = dataFrame->addColumn<float>("Position Y", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posz = dataFrame->addColumn<float>("Position Z", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-
-            const auto indexToModel = volume->getCoordinateTransformer().getIndexToModelMatrix();
+            auto magnitudes = addColumn("Magnitude", float{});
+            auto indx = addColumn("Index X", int{});
+            auto indy = addColumn("Index Y", int{});
+            auto indz = addColumn("Index Z", int{});
+            auto posx = addColumn("Position X", float{});
+            auto posy = addColumn("Position Y", float{});
+            auto posz = addColumn("Position Z", float{});
+
+            const dmat4 indexToModel{volume->getCoordinateTransformer().getIndexToModelMatrix()};
+            const dvec3 xStep{indexToModel[0]};
 
             volume->getRepresentation<VolumeRAM>()->dispatch<void>([&](auto vr) {
-                const auto im = util::IndexMapper3D(vr->getDimensions());
                 using ValueType = util::PrecisionValueType<decltype(vr)>;
+                constexpr size_t comp = DataFormat<ValueType>::comp;
+                const auto im = util::IndexMapper3D(vr->getDimensions());
                 const auto data = vr->getDataTyped();
-                auto i = 0;
-                size3_t ind;
-                for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                    for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                        for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                            const auto v = util::glm_convert<dvec4>(data[im(ind)]);
+
+                // each z slice of the range maps to a contiguous block of rows in the output
+                std::vector<size_t> slices(extent.z);
+                std::iota(slices.begin(), slices.end(), start.z);
+                util::forEachParallel(slices, [&](size_t z) {
+                    size_t i = (z - start.z) * extent.y * extent.x;
+                    for (size_t y = start.y; y < end.y; ++y) {
+                        const auto src = data + im(size3_t{start.x, y, z});
+                        const dvec3 rowPos{indexToModel * dvec4{start.x, y, z, 1.0}};
+                        for (size_t x = 0; x < extent.x; ++x, ++i) {
+                            const auto v = util::glm_convert<dvec4>(src[x]);
                             double m = 0.0;
-                            for (size_t c = 0; c < DataFormat<ValueType>::comp; c++) {
-                                (*channelBuffer_[c])[i] = static_cast<float>(v[c]);
+                            for (size_t c = 0; c < comp; c++) {
+                                channels[c][i] = static_cast<float>(v[c]);
                                 m += v[c] * v[c];
                             }
                             magnitudes[i] = static_cast<float>(std::sqrt(m));
 
-                            indx[i] = static_cast<int>(ind.x);
-                            indy[i] = static_cast<int>(ind.y);
-                            indz[i] = static_cast<int>(ind.z);
-
-                            const dvec3 pos{indexToModel * dvec4{ind, 1}};
+                            indx[i] = static_cast<int>(start.x + x);
+                            indy[i] = static_cast<int>(y);
+                            indz[i] = static_cast<int>(z);
 
+                            const dvec3 pos = rowPos + static_cast<double>(x) * xStep;
                             posx[i] = static_cast<float>(pos.x);
                             posy[i] = static_cast<float>(pos.y);
                             posz[i] = static_cast<float>(pos.z);
-                            ++i;
                         }
                     }
-                }
+                });
             });
             outport_.setData(dataFrame);
             break;
         }
-        case Mode::XDir: {
-            const auto size = rangeX_.getEnd() - rangeY_.getStart();
+        case Mode::XDir:
+        case Mode::YDir:
+        case Mode::ZDir: {
+            // one column per line of voxels along the main axis, the two other axes enumerate
+            // the columns
+            const size_t axis = static_cast<size_t>(mode_.get()) - static_cast<size_t>(Mode::XDir);
+            const size_t outer = axis == 0 ? 2 : 0;
+            const size_t inner = axis == 1 ? 2 : 1;
+            const std::array<std::string, 3> names{"x:", "y:", "z:"};
+
+            const auto size = extent[axis];
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
 
-            volume->getRepresentation<VolumeRAM>()->dispatch<void>([this, dataFrame,
-                                                                    size](const auto vr) {
+            volume->getRepresentation<VolumeRAM>()->dispatch<void>([&](const auto vr) {
                 using ValueType = util::PrecisionValueType<decltype(vr)>;
                 const auto im = util::IndexMapper3D(vr->getDimensions());
-                const auto data = vr->getDataTyped();
-                size3_t ind;
-                for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                    for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                        const std::string name = "y:" + toString(ind.y) + " z:" + toString(ind.z);
-                        auto col = dataFrame->addColumn<ValueType>(name, size);
-                        auto& line = col->getTypedBuffer()
-                                         ->getEditableRAMRepresentation()
-                                         ->getDataContainer();
-                        size_t i = 0;
-                        for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                            line[i++] = data[im(ind)];
-                        }
+                const size3_t dims = vr->getDimensions();
+                const size_t stride = axis == 0 ? 1 : (axis == 1 ? dims.x : dims.x * dims.y);
+
+                std::vector<size_t> starts;
+                std::vector<ValueType*> columns;
+                starts.reserve(extent[outer] * extent[inner]);
+                columns.reserve(extent[outer] * extent[inner]);
+
+                size3_t ind{start};
+                for (ind[outer] = start[outer]; ind[outer] < end[outer]; ++ind[outer]) {
+                    for (ind[inner] = start[inner]; ind[inner] < end[inner]; ++ind[inner]) {
+                        const auto name = names[std::min(outer, inner)] +
+                                          toString(ind[std::min(outer, inner)]) + " " +
+                                          names[std::max(outer, inner)] +
+                                          toString(ind[std::max(outer, inner)]);
+                        columns.push_back(dataFrame->addColumn<ValueType>(name, size)
+                                              ->getTypedBuffer()
+                                              ->getEditableRAMRepresentation()
+                                              ->getDataContainer()
+                                              .data());
+                        starts.push_back(im(ind));
                     }
                 }
+                gatherLines(vr->getDataTyped(), starts, stride, size, columns);
             });
 
-            outport_.setData(dataFrame);
-            break;
-        }
-        case Mode::YDir: {
-            const auto size = rangeY_.getEnd() - rangeY_.getStart();
-            auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
-
-            volume->getRepresentation<VolumeRAM>()->dispatch<void>(
-                [this, dataFrame, size](const auto vr) {
-                    using ValueType = util::PrecisionValueType<decltype(vr)>;
-                    const auto im = util::IndexMapper3D(vr->getDimensions());
-                    const auto data = vr->getDataTyped();
-                    size3_t ind;
-                    for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                        for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                            auto col = dataFrame->addColumn<ValueType>(
-                                "x:" + toString(ind.x) + " z:" + toString(ind.z), size);
-                            auto& line = col->getTypedBuffer()
-                                             ->getEditableRAMRepresentation()
-                                             ->getDataContainer();
-                            size_t i = 0;
-                            for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                                line[i++] = data[im(ind)];
-                            }
-                        }
-                    }
-                });
-
-            outport_.setData(dataFrame);
-            break;
-        }
-        case Mode::ZDir: {
-            const auto size = rangeZ_.getEnd() - rangeZ_.getStart();
-            auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
-
-            volume->getRepresentation<VolumeRAM>()->dispatch<void>(
-                [this, dataFrame, size](const auto vr) {
-                    using ValueType = util::PrecisionValueType<decltype(vr)>;
-                    const auto im = util::IndexMapper3D(vr->getDimensions());
-                    const auto data = vr->getDataTyped();
-                    size3_t ind;
-                    for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                        for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                            auto col = dataFrame->addColumn<ValueType>(
-                                "x:" + toString(ind.x) + " y:" + toString(ind.y), size);
-                            auto& line = col->getTypedBuffer()
-                                             ->getEditableRAMRepresentation()
-                                             ->getDataContainer();
-                            size_t i = 0;
-                            for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                                line[i++] = data[im(ind)];
-                            }
-                        }
-                    }
-                });
-
             outport_.setData(dataFrame);
             break;
         }
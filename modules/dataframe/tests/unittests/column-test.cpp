@@ -0,0 +1,134 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/stringdictionary.h>
+
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+TEST(StringDictionary, addOrGetID) {
+    StringDictionary dict;
+    EXPECT_EQ(0u, dict.addOrGetID("blue"));
+    EXPECT_EQ(1u, dict.addOrGetID("red"));
+    EXPECT_EQ(0u, dict.addOrGetID("blue"));
+    EXPECT_EQ(2u, dict.addOrGetID(""));
+    EXPECT_EQ(3u, dict.size());
+    EXPECT_EQ("red", dict[1]);
+    EXPECT_FALSE(dict.getID("yellow"));
+}
+
+TEST(StringDictionary, copyAndMerge) {
+    StringDictionary dict;
+    for (int i = 0; i < 10000; ++i) {
+        dict.addOrGetID(std::to_string(i % 1000));
+    }
+    const StringDictionary copy(dict);
+    ASSERT_EQ(1000u, copy.size());
+    for (std::uint32_t i = 0; i < copy.size(); ++i) {
+        EXPECT_EQ(i, copy.getID(dict[i]));
+    }
+
+    StringDictionary other;
+    other.addOrGetID("999");
+    other.addOrGetID("new");
+    const auto mapping = dict.merge(other);
+    ASSERT_EQ(2u, mapping.size());
+    EXPECT_EQ(999u, mapping[0]);
+    EXPECT_EQ(1000u, mapping[1]);
+}
+
+TEST(CategoricalColumn, appendMatchesAdd) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 5000; ++i) {
+        values.push_back("cat" + std::to_string((i * 7919) % 1234));
+    }
+
+    CategoricalColumn added("added");
+    for (const auto& v : values) {
+        added.add(v);
+    }
+    CategoricalColumn appended("appended");
+    appended.append(values);
+
+    ASSERT_EQ(added.getSize(), appended.getSize());
+    EXPECT_EQ(added.getCategories(), appended.getCategories());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(added.get(i), appended.get(i));
+        EXPECT_EQ(values[i], appended.getAsString(i));
+    }
+}
+
+TEST(DataFrame, getRows) {
+    DataFrame df;
+    df.addColumn<float>("float", std::vector<float>{0.5f, 1.5f, 2.5f});
+    df.addColumn<ivec2>("ivec2", std::vector<ivec2>{ivec2{1, 2}, ivec2{3, 4}, ivec2{5, 6}});
+    auto cat = df.addCategoricalColumn("cat");
+    cat->append({"a", "b", "a"});
+    df.updateIndexBuffer();
+
+    std::vector<CellValue> cells;
+    df.getRows(1, 10, cells);
+    ASSERT_EQ(2u * 4u, cells.size());
+    EXPECT_EQ(CellValue{std::uint64_t{1}}, cells[0]);
+    EXPECT_EQ(CellValue{1.5}, cells[1]);
+    EXPECT_EQ((CellValue{glm::vec<2, std::int64_t>(3, 4)}), cells[2]);
+    EXPECT_EQ(CellValue{std::string_view{"b"}}, cells[3]);
+    EXPECT_EQ("a", toString(cells[7]));
+    EXPECT_EQ(df.getColumn(1)->getAsString(2), toString(cells[5]));
+}
+
+TEST(DataFrame, cellToString) {
+    DataFrame df;
+    df.addColumn<std::int8_t>("int8", std::vector<std::int8_t>{65, -3, 0});
+    df.addColumn<std::uint8_t>("uint8", std::vector<std::uint8_t>{97, 200, 7});
+    df.addColumn<ivec3>("ivec3", std::vector<ivec3>{ivec3{1, -2, 3}, ivec3{0}, ivec3{-100}});
+    df.addColumn<glm::u8vec2>(
+        "u8vec2", std::vector<glm::u8vec2>{glm::u8vec2{65, 66}, glm::u8vec2{0}, glm::u8vec2{255}});
+    df.addColumn<float>("float", std::vector<float>{0.1f, -1.0e-7f, 123456.789f});
+    df.addColumn<vec2>("vec2", std::vector<vec2>{vec2{0.5f, 1.25f}, vec2{0.0f}, vec2{-3.0f}});
+    df.updateIndexBuffer();
+
+    for (const auto &col : df) {
+        for (size_t row = 0; row < col->getSize(); ++row) {
+            EXPECT_EQ(col->getAsString(row), toString(col->getCell(row)))
+                << col->getHeader() << " row " << row;
+        }
+    }
+}
+
+}  // namespace inviwo
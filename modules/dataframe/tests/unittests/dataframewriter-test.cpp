@@ -0,0 +1,179 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/io/binarydataframe.h>
+#include <inviwo/dataframe/io/csvreader.h>
+#include <inviwo/dataframe/io/csvwriter.h>
+#include <inviwo/core/io/datawriterexception.h>
+
+#include <cstring>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createDataFrame(size_t rows) {
+    auto df = std::make_shared<DataFrame>();
+    auto& f = df->addColumn<float>("float", rows)
+                  ->getTypedBuffer()
+                  ->getEditableRAMRepresentation()
+                  ->getDataContainer();
+    auto& i = df->addColumn<int>("int", rows)
+                  ->getTypedBuffer()
+                  ->getEditableRAMRepresentation()
+                  ->getDataContainer();
+    auto& v = df->addColumn<vec2>("vec2", rows)
+                  ->getTypedBuffer()
+                  ->getEditableRAMRepresentation()
+                  ->getDataContainer();
+    std::vector<std::string> names;
+    for (size_t row = 0; row < rows; ++row) {
+        f[row] = static_cast<float>(row) * 0.25f;
+        i[row] = static_cast<int>(row) - 10;
+        v[row] = vec2(static_cast<float>(row), -0.5f);
+        names.push_back("name" + std::to_string(row % 7));
+    }
+    df->addCategoricalColumn("name")->append(names);
+    df->updateIndexBuffer();
+    return df;
+}
+
+}  // namespace
+
+TEST(CSVWriter, format) {
+    auto df = createDataFrame(2);
+    std::ostringstream ss;
+    CSVWriter{}.writeData(*df, ss);
+    EXPECT_EQ(
+        "float,int,\"vec2 X\",\"vec2 Y\",name\n"
+        "0,-10,0,-0.5,\"name0\"\n"
+        "0.25,-9,1,-0.5,\"name1\"",
+        ss.str());
+}
+
+TEST(CSVWriter, chunkedRoundTrip) {
+    auto df = createDataFrame(1000);
+
+    CSVWriter writer;
+    std::ostringstream single;
+    writer.writeData(*df, single);
+    writer.setRowsPerChunk(7);
+    std::ostringstream chunked;
+    writer.writeData(*df, chunked);
+    EXPECT_EQ(single.str(), chunked.str());
+
+    std::istringstream is(chunked.str());
+    auto result = CSVReader{}.readData(is);
+    ASSERT_EQ(1000u, result->getNumberOfRows());
+    ASSERT_EQ(6u, result->getNumberOfColumns());
+    EXPECT_EQ("name6", result->getColumn(5)->getAsString(999));
+}
+
+TEST(BinaryDataFrame, roundTrip) {
+    auto df = createDataFrame(1000);
+    std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+    BinaryDataFrameWriter{}.writeData(*df, ss);
+
+    auto result = BinaryDataFrameReader{}.readData(ss);
+    ASSERT_EQ(df->getNumberOfColumns(), result->getNumberOfColumns());
+    ASSERT_EQ(df->getNumberOfRows(), result->getNumberOfRows());
+    for (size_t col = 0; col < df->getNumberOfColumns(); ++col) {
+        const auto expected = df->getColumn(col);
+        const auto actual = result->getColumn(col);
+        EXPECT_EQ(expected->getHeader(), actual->getHeader());
+        EXPECT_EQ(expected->getBuffer()->getDataFormat(), actual->getBuffer()->getDataFormat());
+        for (size_t row = 0; row < df->getNumberOfRows(); ++row) {
+            EXPECT_EQ(expected->getCell(row), actual->getCell(row));
+        }
+    }
+    auto categorical = std::dynamic_pointer_cast<const CategoricalColumn>(result->getColumn(4));
+    ASSERT_TRUE(categorical);
+    EXPECT_EQ(7u, categorical->getCategories().size());
+}
+
+TEST(BinaryDataFrame, invalid) {
+    std::istringstream empty;
+    EXPECT_THROW(BinaryDataFrameReader{}.readData(empty), DataReaderException);
+
+    auto df = createDataFrame(10);
+    std::ostringstream os(std::ios::out | std::ios::binary);
+    BinaryDataFrameWriter{}.writeData(*df, os);
+    auto data = os.str();
+    data.resize(data.size() / 2);
+    std::istringstream truncated(data, std::ios::in | std::ios::binary);
+    EXPECT_THROW(BinaryDataFrameReader{}.readData(truncated), DataReaderException);
+}
+
+TEST(BinaryDataFrame, corruptSizes) {
+    auto df = createDataFrame(10);
+    std::ostringstream os(std::ios::out | std::ios::binary);
+    BinaryDataFrameWriter{}.writeData(*df, os);
+    const auto data = os.str();
+
+    // magic, version, and number of columns followed by the header, categorical flag, and
+    // format of the index column, and then its size
+    const size_t sizeOffset = 8 + 4 + 8 + 8 + df->getIndexColumn()->getHeader().size() + 1 + 8 +
+                              DataFormat<std::uint32_t>::str().size();
+    const auto setIndexSize = [&](std::string str, std::uint64_t size) {
+        std::memcpy(str.data() + sizeOffset, &size, sizeof(size));
+        return str;
+    };
+
+    std::istringstream huge(setIndexSize(data, std::uint64_t{1} << 60),
+                            std::ios::in | std::ios::binary);
+    EXPECT_THROW(BinaryDataFrameReader{}.readData(huge), DataReaderException);
+
+    // one index less than the other columns
+    auto shorter = setIndexSize(data, 9);
+    shorter.erase(sizeOffset + 8, sizeof(std::uint32_t));
+    std::istringstream mismatch(shorter, std::ios::in | std::ios::binary);
+    EXPECT_THROW(BinaryDataFrameReader{}.readData(mismatch), DataReaderException);
+}
+
+TEST(BinaryDataFrame, writeErrors) {
+    auto df = createDataFrame(10);
+    std::ostringstream failed(std::ios::out | std::ios::binary);
+    failed.setstate(std::ios::badbit);
+    EXPECT_THROW(BinaryDataFrameWriter{}.writeData(*df, failed), DataWriterException);
+
+    // the index column is not updated after adding rows
+    df->addColumn<float>("extra", 11);
+    std::ostringstream os(std::ios::out | std::ios::binary);
+    EXPECT_THROW(BinaryDataFrameWriter{}.writeData(*df, os), DataWriterException);
+}
+
+}  // namespace inviwo
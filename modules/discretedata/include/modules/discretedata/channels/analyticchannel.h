@@ -85,6 +85,20 @@ public:
         dataFunction_(destVec, index);
     }
 
+    /**
+     * \brief Range access, constant
+     * Evaluates the function for each element without dispatching through fillRaw.
+     * @param dest Position to write to, expect write of count * NumComponents many T
+     * @param start Linear index of the first element
+     * @param count Number of elements to evaluate
+     */
+    void fillRawBlock(T* dest, ind start, ind count) const override {
+        Vec* destVec = reinterpret_cast<Vec*>(dest);
+        for (ind i = 0; i < count; ++i) {
+            dataFunction_(destVec[i], start + i);
+        }
+    }
+
 protected:
     virtual CachedGetter<AnalyticChannel>* newIterator() override {
         return new CachedGetter<AnalyticChannel>(this);
@@ -55,6 +55,23 @@ class BufferChannel : public DataChannel<T, N> {
     using DefaultVec = typename DataChannel<T, N>::DefaultVec;
 
 public:
+    /**
+     * \brief Contiguous typed range over the buffer
+     * Plain pointers, so iterating does not go through any virtual call and the
+     * compiler is free to vectorize loops over it.
+     */
+    template <typename VecNT>
+    struct TypedRange {
+        VecNT* begin() const { return begin_; }
+        VecNT* end() const { return end_; }
+        VecNT* data() const { return begin_; }
+        ind size() const { return static_cast<ind>(end_ - begin_); }
+        VecNT& operator[](ind index) const { return begin_[index]; }
+
+        VecNT* begin_;
+        VecNT* end_;
+    };
+
     /**
      * \brief Direct construction, empty data
      * @param numElements Total number of indexed positions
@@ -142,6 +159,32 @@ public:
         return *reinterpret_cast<const VecNT*>(&buffer_[index * N]);
     }
 
+    /**
+     * \brief Typed access to the whole buffer
+     * Pointers are invalidated when the buffer is resized.
+     * @tparam VecNT Element type of the range
+     */
+    template <typename VecNT = DefaultVec>
+    TypedRange<VecNT> typed() {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        auto first = reinterpret_cast<VecNT*>(buffer_.data());
+        return {first, first + size()};
+    }
+
+    /**
+     * \brief Typed access to the whole buffer, constant
+     * Pointers are invalidated when the buffer is resized.
+     * @tparam VecNT Element type of the range
+     */
+    template <typename VecNT = DefaultVec>
+    TypedRange<const VecNT> typed() const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        auto first = reinterpret_cast<const VecNT*>(buffer_.data());
+        return {first, first + size()};
+    }
+
 protected:
     virtual BufferGetter<BufferChannel<T, N>>* newIterator() override {
         return new BufferGetter<BufferChannel<T, N>>(this);
@@ -156,6 +199,16 @@ protected:
         memcpy(dest, &buffer_[index * N], sizeof(T) * N);
     }
 
+    /**
+     * \brief Range access, constant
+     * @param dest Position to write to, expect write of count * NumComponents many T
+     * @param start Linear index of the first element
+     * @param count Number of elements to copy
+     */
+    virtual void fillRawBlock(T* dest, ind start, ind count) const override {
+        if (count > 0) memcpy(dest, &buffer_[start * N], sizeof(T) * N * count);
+    }
+
     /**
      * \brief Vector containing the buffer data
      * Resizeable only by DataSet. Handle with care:
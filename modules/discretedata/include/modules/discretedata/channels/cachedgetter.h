@@ -35,6 +35,9 @@
 #include <modules/discretedata/channels/channelgetter.h>
 #include <modules/discretedata/channels/datachannel.h>
 
+#include <algorithm>
+#include <array>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -42,35 +45,51 @@ template <typename Parent>
 struct CachedGetter : public ChannelGetter<typename Parent::value_type, Parent::num_comp> {
     using value_type = typename Parent::value_type;
     static constexpr int num_comp = Parent::num_comp;
+    //! Number of elements fetched from the parent at once when iterating sequentially
+    static constexpr ind blockSize = 64;
 
     CachedGetter(Parent* parent)
-        : ChannelGetter<value_type, num_comp>(), dataIndex(-1), parent_{parent} {}
+        : ChannelGetter<value_type, num_comp>(), dataIndex(-1), dataCount(0), parent_{parent} {}
     virtual ~CachedGetter() = default;
     virtual CachedGetter* clone() const override { return new CachedGetter(parent_); }
 
     virtual value_type* get(ind index) override {
         assert(this->parent_ && "No channel to iterate is set.");
 
-        // Is the data up to date?
-        if (dataIndex != index) {
-            this->parent_->fill(data, index);
-            dataIndex = index;
+        // Is the data up to date? If not, fetch the block starting at index when iterating
+        // forward, or ending at it when iterating backwards. Random access only fetches the
+        // element itself, the following ones are unlikely to be used.
+        if (index < dataIndex || index >= dataIndex + dataCount) {
+            ind start = index;
+            ind count = 1;
+            if (index == dataIndex + dataCount) {
+                count = std::min(blockSize, this->parent_->size() - start);
+            } else if (index == dataIndex - 1) {
+                start = std::max(ind{0}, index - blockSize + 1);
+                count = index - start + 1;
+            }
+            this->parent_->fillBlock(data.data(), start, count);
+            dataIndex = start;
+            dataCount = count;
         }
 
         // Always return data.
         // If the iterator is changed and dereferenced, the pointer becomes invalid.
-        return data.data();
+        return data[index - dataIndex].data();
     }
 
 protected:
     virtual Channel* parent() const override { return parent_; }
 
     //! Memory is invalidated on iteration
-    std::array<value_type, num_comp> data;
+    std::array<std::array<value_type, num_comp>, blockSize> data;
 
-    //! Index that is currently pointed to
+    //! Index of the first cached element
     ind dataIndex;
 
+    //! Number of cached elements
+    ind dataCount;
+
     Parent* parent_;
 };
 
@@ -35,6 +35,9 @@
 #include <modules/discretedata/channels/channelgetter.h>
 #include <modules/discretedata/channels/channeliterator.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -47,6 +50,19 @@ public:
 
 protected:
     virtual void fillRaw(T* dest, ind index) const = 0;
+
+    /**
+     * \brief Copy a contiguous range of elements, one call per element unless overridden
+     * @param dest Position to write to, expect T[count * NumComponents]
+     * @param start Linear index of the first element
+     * @param count Number of elements to copy
+     */
+    virtual void fillRawBlock(T* dest, ind start, ind count) const {
+        for (ind i = 0; i < count; ++i) {
+            fillRaw(dest + i * N, start + i);
+        }
+    }
+
     virtual ChannelGetter<T, N>* newIterator() = 0;
 };
 
@@ -101,6 +117,23 @@ public:
         this->fillRaw(reinterpret_cast<T*>(&dest), index);
     }
 
+    /**
+     * \brief Block access, copy the elements [start, start + count) in one call
+     * Prefer over repeated fill calls when traversing many elements.
+     * Thread safe.
+     * @param dest Position to write to, expect VecNT[count]
+     * @param start Linear index of the first element
+     * @param count Number of elements to copy
+     */
+    template <typename VecNT>
+    void fillBlock(VecNT* dest, ind start, ind count) const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        assert(start >= 0 && count >= 0 && start + count <= this->size() &&
+               "Block out of range.");
+        this->fillRawBlock(reinterpret_cast<T*>(dest), start, count);
+    }
+
     template <typename VecNT>
     void operator()(VecNT& dest, ind index) const {
         fill(dest, index);
@@ -240,6 +273,7 @@ void DataChannel<T, N>::getMinMax(VecNT& minDest, VecNT& maxDest) const {
 template <typename T, ind N>
 void DataChannel<T, N>::computeMinMax() const {
     using Vec = std::array<T, N>;
+    constexpr ind blockSize = 1024;
 
     Vec minT;
     Vec maxT;
@@ -247,10 +281,16 @@ void DataChannel<T, N>::computeMinMax() const {
     this->fill(minT, 0);
     this->fill(maxT, 0);
 
-    for (const Vec& val : this->all<Vec>()) {
-        for (ind dim = 0; dim < N; ++dim) {
-            minT[dim] = std::min(minT[dim], val[dim]);
-            maxT[dim] = std::max(maxT[dim], val[dim]);
+    const ind numElements = this->size();
+    std::vector<Vec> block(static_cast<size_t>(std::min(blockSize, numElements)));
+    for (ind start = 0; start < numElements; start += blockSize) {
+        const ind count = std::min(blockSize, numElements - start);
+        this->fillBlock(block.data(), start, count);
+        for (ind i = 0; i < count; ++i) {
+            for (ind dim = 0; dim < N; ++dim) {
+                minT[dim] = std::min(minT[dim], block[i][dim]);
+                maxT[dim] = std::max(maxT[dim], block[i][dim]);
+            }
         }
     }
 
@@ -36,9 +36,34 @@
 #include <modules/discretedata/connectivity/cell.h>
 #include <modules/discretedata/connectivity/elementiterator.h>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace inviwo {
 namespace discretedata {
 
+/**
+ * \brief Connections of a list of elements in compressed sparse row layout
+ * The connections of element i are indices[offsets[i]] to indices[offsets[i + 1]].
+ */
+struct ConnectionTable {
+    //! Number of elements in the table
+    ind size() const { return offsets.empty() ? 0 : static_cast<ind>(offsets.size()) - 1; }
+
+    //! Number of connections of the element
+    ind count(ind element) const { return offsets[element + 1] - offsets[element]; }
+
+    const ind* begin(ind element) const { return indices.data() + offsets[element]; }
+    const ind* end(ind element) const { return indices.data() + offsets[element + 1]; }
+
+    //! Start of the connections of each element, expect size() + 1 entries
+    std::vector<ind> offsets;
+
+    //! Connections of all elements, concatenated
+    std::vector<ind> indices;
+};
+
 /** \class Connectivity
  *   \brief Basis interface of all connectivity types.
  *
@@ -66,7 +91,9 @@ class IVW_MODULE_DISCRETEDATA_API Connectivity {
 public:
     Connectivity(GridPrimitive gridDimension)
         : gridDimension_(gridDimension)
-        , numGridPrimitives_(static_cast<ind>(gridDimension) + 1, -1) {
+        , numGridPrimitives_(static_cast<ind>(gridDimension) + 1, -1)
+        , connectionTables_((static_cast<ind>(gridDimension) + 1) *
+                            (static_cast<ind>(gridDimension) + 1)) {
     }  // Initialize sizes with -1. Overwrite when known.
     virtual ~Connectivity() = default;
 
@@ -92,6 +119,44 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const = 0;
 
+    /**
+     * \brief Get the connections of all elements of type 'from' to type 'to' as a table
+     * The table is built in parallel on first use and kept until clearConnectionTables is
+     * called, so traversing the same connections repeatedly is a lookup instead of a
+     * recomputation. Thread safe.
+     * @throw Exception if the number of elements of type 'from' is not known, or if 'from' or
+     * 'to' is not a primitive of this grid
+     * @param from Dimension the indices of the table live in
+     * @param to Dimension the connections live in
+     */
+    std::shared_ptr<const ConnectionTable> getConnectionTable(GridPrimitive from,
+                                                              GridPrimitive to) const;
+
+    /**
+     * \brief Get the table of connections from 'from' to 'to' if it has been built
+     * @return The table or nullptr, never builds it. Also nullptr if 'from' or 'to' is not a
+     * primitive of this grid.
+     */
+    std::shared_ptr<const ConnectionTable> findConnectionTable(GridPrimitive from,
+                                                               GridPrimitive to) const;
+
+    /**
+     * \brief Drop all built connection tables
+     * Call when the connections change.
+     */
+    void clearConnectionTables();
+
+    /**
+     * \brief Get the connections of several elements at once
+     * Reads from the connection table of the pair if it has been built.
+     * @param result Table with the connections of indices[i] as its element i
+     * @param indices Indices of elements in dimension 'from'
+     * @param from Dimension the indices live in
+     * @param to Dimension the result lives in
+     */
+    void getBatchConnections(ConnectionTable& result, const std::vector<ind>& indices,
+                             GridPrimitive from, GridPrimitive to) const;
+
     /**
      * \brief Range of all elements to iterate over
      * @param dim Dimension to return the elements of
@@ -118,6 +183,17 @@ protected:
 
     //! Saves the known number of primitves
     mutable std::vector<ind> numGridPrimitives_;
+
+private:
+    std::shared_ptr<const ConnectionTable> buildConnectionTable(GridPrimitive from,
+                                                                GridPrimitive to) const;
+
+    //! Built connection tables, indexed by from * (gridDimension_ + 1) + to
+    mutable std::vector<std::shared_ptr<const ConnectionTable>> connectionTables_;
+    mutable std::mutex connectionTablesMutex_;
+
+    //! Held while building a table, so each table is built once
+    mutable std::mutex buildMutex_;
 };
 
 }  // namespace discretedata
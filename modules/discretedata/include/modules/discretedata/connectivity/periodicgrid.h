@@ -55,7 +55,10 @@ public:
 
     bool isPeriodic(ind dim) const { return isDimPeriodic_[dim]; }
 
-    void setPeriodic(ind dim, bool periodic = true) { isDimPeriodic_[dim] = periodic; }
+    void setPeriodic(ind dim, bool periodic = true) {
+        isDimPeriodic_[dim] = periodic;
+        clearConnectionTables();
+    }
 
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const override;
@@ -37,7 +37,11 @@ ConnectionRange::ConnectionRange(ind fromIndex, GridPrimitive fromDim, GridPrimi
                                  const Connectivity* parent)
     : parent_(parent), toDimension_(toDim) {
     std::vector<ind>* neigh = new std::vector<ind>();
-    parent_->getConnections(*neigh, fromIndex, fromDim, toDim);
+    if (auto table = parent_->findConnectionTable(fromDim, toDim)) {
+        neigh->assign(table->begin(fromIndex), table->end(fromIndex));
+    } else {
+        parent_->getConnections(*neigh, fromIndex, fromDim, toDim);
+    }
     connections_ = std::shared_ptr<const std::vector<ind>>(neigh);
 }
 
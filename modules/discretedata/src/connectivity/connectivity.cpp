@@ -33,6 +33,12 @@
 #include <modules/discretedata/connectivity/connectivity.h>
 #include <modules/discretedata/connectivity/elementiterator.h>
 
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <numeric>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -43,6 +49,111 @@ ind Connectivity::getNumElements(GridPrimitive elementType) const {
     return numGridPrimitives_[(int)elementType];
 }
 
+std::shared_ptr<const ConnectionTable> Connectivity::getConnectionTable(GridPrimitive from,
+                                                                      GridPrimitive to) const {
+    std::scoped_lock buildLock{buildMutex_};
+    if (auto table = findConnectionTable(from, to)) return table;
+
+    auto table = buildConnectionTable(from, to);
+    std::scoped_lock lock{connectionTablesMutex_};
+    connectionTables_[static_cast<ind>(from) * (static_cast<ind>(gridDimension_) + 1) +
+                      static_cast<ind>(to)] = table;
+    return table;
+}
+
+std::shared_ptr<const ConnectionTable> Connectivity::findConnectionTable(GridPrimitive from,
+                                                                       GridPrimitive to) const {
+    if (from < GridPrimitive::Vertex || from > gridDimension_ || to < GridPrimitive::Vertex ||
+        to > gridDimension_) {
+        return nullptr;
+    }
+    std::scoped_lock lock{connectionTablesMutex_};
+    return connectionTables_[static_cast<ind>(from) * (static_cast<ind>(gridDimension_) + 1) +
+                             static_cast<ind>(to)];
+}
+
+void Connectivity::clearConnectionTables() {
+    std::scoped_lock buildLock{buildMutex_};
+    std::scoped_lock lock{connectionTablesMutex_};
+    for (auto& table : connectionTables_) table.reset();
+}
+
+std::shared_ptr<const ConnectionTable> Connectivity::buildConnectionTable(GridPrimitive from,
+                                                                        GridPrimitive to) const {
+    if (from < GridPrimitive::Vertex || from > gridDimension_ || to < GridPrimitive::Vertex ||
+        to > gridDimension_) {
+        throw Exception("GridPrimitive out of range for a connection table", IVW_CONTEXT);
+    }
+    // Counts of primitives the grid does not know are stored as -1.
+    const ind numElements = numGridPrimitives_[static_cast<ind>(from)];
+    if (numElements < 0) {
+        throw Exception("Number of elements unknown, can not build a connection table",
+                        IVW_CONTEXT);
+    }
+
+    auto table = std::make_shared<ConnectionTable>();
+    table->offsets.resize(numElements + 1, 0);
+
+    // Each range of elements collects its connections into a chunk of its own and counts the
+    // connections per element. The counts are then summed up to the offsets, and the chunks
+    // copied to their place in the table.
+    struct Chunk {
+        ind first;
+        std::vector<ind> indices;
+    };
+    std::vector<Chunk> chunks;
+    std::mutex chunksMutex;
+
+    util::forEachRangeParallel(static_cast<size_t>(numElements), [&](size_t first, size_t last) {
+        Chunk chunk{static_cast<ind>(first), {}};
+        std::vector<ind> connections;
+        for (ind element = chunk.first; element < static_cast<ind>(last); ++element) {
+            connections.clear();
+            getConnections(connections, element, from, to);
+            table->offsets[element + 1] = static_cast<ind>(connections.size());
+            chunk.indices.insert(chunk.indices.end(), connections.begin(), connections.end());
+        }
+        std::scoped_lock lock{chunksMutex};
+        chunks.push_back(std::move(chunk));
+    });
+
+    std::partial_sum(table->offsets.begin(), table->offsets.end(), table->offsets.begin());
+    table->indices.resize(table->offsets.back());
+
+    util::forEachRangeParallel(chunks.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            std::copy(chunks[i].indices.begin(), chunks[i].indices.end(),
+                      table->indices.begin() + table->offsets[chunks[i].first]);
+        }
+    });
+
+    return table;
+}
+
+void Connectivity::getBatchConnections(ConnectionTable& result, const std::vector<ind>& indices,
+                                       GridPrimitive from, GridPrimitive to) const {
+    result.offsets.resize(indices.size() + 1);
+    result.offsets[0] = 0;
+    result.indices.clear();
+
+    if (auto table = findConnectionTable(from, to)) {
+        for (size_t i = 0; i < indices.size(); ++i) {
+            result.indices.insert(result.indices.end(), table->begin(indices[i]),
+                                  table->end(indices[i]));
+            result.offsets[i + 1] = static_cast<ind>(result.indices.size());
+        }
+        return;
+    }
+
+    std::vector<ind> connections;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        connections.clear();
+        getConnections(connections, indices[i], from, to);
+        result.indices.insert(result.indices.end(), connections.begin(), connections.end());
+        result.offsets[i + 1] = static_cast<ind>(result.indices.size());
+    }
+}
+
 ElementRange Connectivity::all(GridPrimitive dim) const { return ElementRange(dim, this); }
 
 CellType Connectivity::getCellType(GridPrimitive dim, ind) const {
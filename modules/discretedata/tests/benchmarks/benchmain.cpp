@@ -0,0 +1,223 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/glm.h>
+
+#include <modules/discretedata/channels/bufferchannel.h>
+#include <modules/discretedata/channels/analyticchannel.h>
+#include <modules/discretedata/connectivity/structuredgrid.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+using namespace discretedata;
+
+namespace {
+
+constexpr ind blockSize = 1024;
+
+void monomial(glm::vec3& dest, ind idx) {
+    dest[0] = 1.0f;
+    dest[1] = static_cast<float>(idx);
+    dest[2] = static_cast<float>(idx) * static_cast<float>(idx);
+}
+
+BufferChannel<float, 3> makeBuffer(ind numElements) {
+    BufferChannel<float, 3> buffer(numElements, "Buffer");
+    for (ind i = 0; i < numElements; ++i) monomial(buffer.get<glm::vec3>(i), i);
+    return buffer;
+}
+
+AnalyticChannel<float, 3, glm::vec3> makeAnalytic(ind numElements) {
+    return AnalyticChannel<float, 3, glm::vec3>(monomial, numElements, "Analytic");
+}
+
+// Sum of all elements, fetched one at a time through fill.
+template <typename Channel>
+void sumFill(benchmark::State& state, const Channel& channel) {
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        glm::vec3 val;
+        for (ind i = 0; i < channel.size(); ++i) {
+            channel.fill(val, i);
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * channel.size());
+}
+
+// Sum of all elements, fetched through the channel iterators.
+template <typename Channel>
+void sumIterator(benchmark::State& state, Channel& channel) {
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        for (const auto& val : channel.template all<glm::vec3>()) sum += val;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * channel.size());
+}
+
+// Sum of all elements, fetched in blocks through fillBlock.
+template <typename Channel>
+void sumBlock(benchmark::State& state, const Channel& channel) {
+    std::vector<glm::vec3> block(blockSize);
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        for (ind start = 0; start < channel.size(); start += blockSize) {
+            const ind count = std::min(blockSize, channel.size() - start);
+            channel.fillBlock(block.data(), start, count);
+            for (ind i = 0; i < count; ++i) sum += block[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * channel.size());
+}
+
+}  // namespace
+
+static void BufferFill(benchmark::State& state) {
+    const auto buffer = makeBuffer(state.range(0));
+    sumFill(state, buffer);
+}
+
+static void BufferIterator(benchmark::State& state) {
+    auto buffer = makeBuffer(state.range(0));
+    sumIterator(state, buffer);
+}
+
+static void BufferBlock(benchmark::State& state) {
+    const auto buffer = makeBuffer(state.range(0));
+    sumBlock(state, buffer);
+}
+
+static void BufferTyped(benchmark::State& state) {
+    const auto buffer = makeBuffer(state.range(0));
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        for (const auto& val : buffer.typed<glm::vec3>()) sum += val;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * buffer.size());
+}
+
+static void AnalyticFill(benchmark::State& state) {
+    const auto analytic = makeAnalytic(state.range(0));
+    sumFill(state, analytic);
+}
+
+static void AnalyticIterator(benchmark::State& state) {
+    auto analytic = makeAnalytic(state.range(0));
+    sumIterator(state, analytic);
+}
+
+static void AnalyticBlock(benchmark::State& state) {
+    const auto analytic = makeAnalytic(state.range(0));
+    sumBlock(state, analytic);
+}
+
+BENCHMARK(BufferFill)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BufferIterator)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BufferBlock)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BufferTyped)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(AnalyticFill)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(AnalyticIterator)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(AnalyticBlock)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+// Sum of the vertex indices of all cells, computed per cell.
+static void CellVerticesCompute(benchmark::State& state) {
+    const ind n = state.range(0);
+    StructuredGrid grid(GridPrimitive::Volume, {n, n, n});
+    const ind numCells = grid.getNumElements(GridPrimitive::Volume);
+
+    std::vector<ind> vertices;
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ind cell = 0; cell < numCells; ++cell) {
+            vertices.clear();
+            grid.getConnections(vertices, cell, GridPrimitive::Volume, GridPrimitive::Vertex);
+            for (ind v : vertices) sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+
+// Sum of the vertex indices of all cells, read from the connection table.
+static void CellVerticesTable(benchmark::State& state) {
+    const ind n = state.range(0);
+    StructuredGrid grid(GridPrimitive::Volume, {n, n, n});
+    const auto table = grid.getConnectionTable(GridPrimitive::Volume, GridPrimitive::Vertex);
+
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ind cell = 0; cell < table->size(); ++cell) {
+            for (auto v = table->begin(cell); v != table->end(cell); ++v) sum += *v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * table->size());
+}
+
+static void CellVerticesBuildTable(benchmark::State& state) {
+    const ind n = state.range(0);
+    StructuredGrid grid(GridPrimitive::Volume, {n, n, n});
+
+    for (auto _ : state) {
+        grid.clearConnectionTables();
+        benchmark::DoNotOptimize(
+            grid.getConnectionTable(GridPrimitive::Volume, GridPrimitive::Vertex));
+    }
+    state.SetItemsProcessed(state.iterations() * grid.getNumElements(GridPrimitive::Volume));
+}
+
+BENCHMARK(CellVerticesCompute)->RangeMultiplier(2)->Range(16, 128);
+BENCHMARK(CellVerticesTable)->RangeMultiplier(2)->Range(16, 128);
+BENCHMARK(CellVerticesBuildTable)->RangeMultiplier(2)->Range(16, 128)->UseRealTime();
+
+int main(int argc, char** argv) {
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
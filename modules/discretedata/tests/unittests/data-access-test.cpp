@@ -39,6 +39,10 @@
 #include <modules/discretedata/connectivity/elementiterator.h>
 #include <modules/discretedata/connectivity/connectioniterator.h>
 #include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/connectivity/periodicgrid.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
 
 namespace inviwo {
 namespace discretedata {
@@ -73,5 +77,61 @@ TEST(AccessingData, Connectivity) {
     EXPECT_TRUE(allFine && "Connectivity is not bi-directional.");
 }
 
+TEST(ConnectionTables, Connectivity) {
+    std::vector<ind> size = {4, 5, 6};
+    PeriodicGrid grid(GridPrimitive::Volume, size, {true, false, false});
+
+    const auto compare = [&](GridPrimitive from, GridPrimitive to) {
+        auto table = grid.getConnectionTable(from, to);
+        EXPECT_EQ(table, grid.findConnectionTable(from, to));
+        ASSERT_EQ(table->size(), grid.getNumElements(from));
+
+        std::vector<ind> connections;
+        for (ind element = 0; element < table->size(); ++element) {
+            connections.clear();
+            grid.getConnections(connections, element, from, to);
+            EXPECT_TRUE(std::equal(table->begin(element), table->end(element),
+                                   connections.begin(), connections.end()))
+                << "Connections of element " << element << " differ.";
+        }
+    };
+
+    compare(GridPrimitive::Volume, GridPrimitive::Vertex);
+    compare(GridPrimitive::Vertex, GridPrimitive::Volume);
+    compare(GridPrimitive::Vertex, GridPrimitive::Vertex);
+    compare(GridPrimitive::Volume, GridPrimitive::Volume);
+
+    // Changing the periodicity drops the tables.
+    grid.setPeriodic(1);
+    EXPECT_FALSE(grid.findConnectionTable(GridPrimitive::Volume, GridPrimitive::Volume));
+    compare(GridPrimitive::Volume, GridPrimitive::Volume);
+
+    // Batch queries give the same result with and without a table.
+    const std::vector<ind> cells = {0, 7, 3, 119, 7};
+    ConnectionTable computed;
+    grid.getBatchConnections(computed, cells, GridPrimitive::Volume, GridPrimitive::Vertex);
+    EXPECT_FALSE(grid.findConnectionTable(GridPrimitive::Volume, GridPrimitive::Vertex));
+
+    auto table = grid.getConnectionTable(GridPrimitive::Volume, GridPrimitive::Vertex);
+    ConnectionTable cached;
+    grid.getBatchConnections(cached, cells, GridPrimitive::Volume, GridPrimitive::Vertex);
+
+    ASSERT_EQ(computed.size(), static_cast<ind>(cells.size()));
+    EXPECT_EQ(computed.offsets, cached.offsets);
+    EXPECT_EQ(computed.indices, cached.indices);
+    for (size_t i = 0; i < cells.size(); ++i) {
+        EXPECT_EQ(computed.count(i), 8);
+        EXPECT_TRUE(std::equal(computed.begin(i), computed.end(i), table->begin(cells[i]),
+                               table->end(cells[i])));
+    }
+
+    // The grid does not know its number of edges and faces.
+    EXPECT_THROW(grid.getConnectionTable(GridPrimitive::Edge, GridPrimitive::Vertex), Exception);
+    EXPECT_THROW(grid.getConnectionTable(GridPrimitive::Face, GridPrimitive::Volume), Exception);
+    EXPECT_THROW(grid.getConnectionTable(GridPrimitive::Vertex, GridPrimitive::HyperVolume),
+                 Exception);
+    EXPECT_FALSE(grid.findConnectionTable(GridPrimitive::Edge, GridPrimitive::Vertex));
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
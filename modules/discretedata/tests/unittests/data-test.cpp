@@ -38,6 +38,9 @@
 
 #include <inviwo/core/util/glm.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -148,5 +151,77 @@ TEST(CreatingCopyingIndexing, DataChannels) {
     }
 }
 
+TEST(BlockAccess, DataChannels) {
+    // *************************************************
+    // Testing block access in Analytic/Buffer
+    // *************************************************
+    // - Fill blocks of various sizes and offsets
+    // - Compare against element-wise fill and typed buffer access
+
+    const ind numElements = 150;
+
+    auto base = [](glm::vec3& dest, ind idx) {
+        dest[0] = 1.0f;
+        dest[1] = static_cast<float>(idx);
+        dest[2] = static_cast<float>(idx * idx);
+    };
+
+    AnalyticChannel<float, 3, glm::vec3> analytic(base, numElements, "MonomialAnalytical");
+    BufferFloat buffer(numElements, "MonomialBuffer");
+    analytic.fillBlock(&buffer.get<glm::vec3>(0), 0, numElements);
+
+    for (ind start : {ind{0}, ind{1}, ind{63}, ind{64}, ind{149}}) {
+        for (ind count : {ind{0}, ind{1}, ind{65}}) {
+            count = std::min(count, numElements - start);
+            std::vector<glm::vec3> analyticBlock(count);
+            std::vector<TestVec3f> bufferBlock(count);
+            analytic.fillBlock(analyticBlock.data(), start, count);
+            buffer.fillBlock(bufferBlock.data(), start, count);
+
+            for (ind i = 0; i < count; ++i) {
+                glm::vec3 single;
+                analytic.fill(single, start + i);
+                EXPECT_EQ(single.y, static_cast<float>(start + i));
+                EXPECT_EQ(single.z, analyticBlock[i].z);
+                EXPECT_EQ(single.y, bufferBlock[i].y);
+                EXPECT_EQ(single.z, bufferBlock[i].z);
+            }
+        }
+    }
+
+    // Typed access covers the whole buffer without going through a getter.
+    const auto& constBuffer = buffer;
+    auto range = constBuffer.typed<TestVec3f>();
+    EXPECT_EQ(range.size(), numElements);
+    ind c = 0;
+    for (const TestVec3f& val : range) {
+        EXPECT_EQ(val.y, static_cast<float>(c));
+        EXPECT_EQ(val.z, static_cast<float>(c * c));
+        ++c;
+    }
+    EXPECT_EQ(c, numElements);
+
+    // The cached getter of the analytic channel fetches blocks,
+    // iterating forwards and backwards has to give the same values.
+    auto end = analytic.end<glm::vec3>();
+    c = 0;
+    for (auto it = analytic.begin<glm::vec3>(); it != end; ++it, ++c) {
+        EXPECT_EQ((*it).y, static_cast<float>(c));
+    }
+    EXPECT_EQ(c, numElements);
+
+    auto it = analytic.end<glm::vec3>();
+    for (c = numElements - 1; c >= 0; --c) {
+        --it;
+        EXPECT_EQ((*it).z, static_cast<float>(c * c));
+    }
+
+    glm::vec3 minVal, maxVal;
+    buffer.getMinMax(minVal, maxVal);
+    EXPECT_EQ(minVal.y, 0.0f);
+    EXPECT_EQ(maxVal.y, static_cast<float>(numElements - 1));
+    EXPECT_EQ(maxVal.z, static_cast<float>((numElements - 1) * (numElements - 1)));
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
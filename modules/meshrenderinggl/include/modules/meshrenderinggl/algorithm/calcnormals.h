@@ -31,7 +31,11 @@
 
 #include <modules/meshrenderinggl/meshrenderingglmoduledefine.h>
 #include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace inviwo {
 
@@ -65,6 +69,11 @@ enum class CalculateMeshNormalsMode {
     WeightNMax
 };
 
+/**
+ * \brief Calculate vertex normals from the triangles of the mesh and replace its normal buffer.
+ * The weighted face normals are computed in parallel, and then summed per vertex using a
+ * vertex to face adjacency list, which makes the result independent of the number of threads.
+ */
 IVW_MODULE_MESHRENDERINGGL_API void calculateMeshNormals(
     Mesh& mesh, CalculateMeshNormalsMode mode = CalculateMeshNormalsMode::WeightNMax);
 
@@ -75,6 +84,48 @@ inline std::unique_ptr<Mesh> calculateMeshNormals(
     return cloned;
 }
 
+/**
+ * \brief Calculates mesh normals like calculateMeshNormals, but keeps the state of the last
+ * call. If the triangles of the mesh are the same as in the last call, only the faces that have a
+ * moved vertex are recomputed, and only the normals of the vertices of those faces are updated.
+ * Any change of the triangles or the number of vertices triggers a full computation.
+ */
+class IVW_MODULE_MESHRENDERINGGL_API IncrementalMeshNormals {
+public:
+    IncrementalMeshNormals(CalculateMeshNormalsMode mode = CalculateMeshNormalsMode::WeightNMax);
+
+    /**
+     * \brief Update the normals of mesh and replace its normal buffer.
+     */
+    void update(Mesh& mesh);
+
+    /**
+     * \brief Changing the mode invalidates the state, the next update computes all normals.
+     */
+    void setMode(CalculateMeshNormalsMode mode);
+    CalculateMeshNormalsMode getMode() const;
+
+    /**
+     * \brief Forget the state of the last call.
+     */
+    void clear();
+
+    /**
+     * \brief Number of vertex normals that were recomputed by the last update.
+     */
+    size_t getNumberOfUpdatedVertices() const;
+
+private:
+    CalculateMeshNormalsMode mode_;
+    std::vector<vec3> positions_;
+    std::vector<std::array<std::uint32_t, 3>> triangles_;
+    std::vector<std::uint32_t> offsets_;  ///< Per vertex offsets into corners_
+    std::vector<std::uint32_t> corners_;  ///< Corners (3 * face + i) around each vertex
+    std::vector<vec3> contributions_;     ///< Weighted face normal of each corner
+    std::vector<vec3> normals_;
+    size_t updated_ = 0;
+};
+
 }  // namespace meshutil
 
 }  // namespace inviwo
@@ -34,12 +34,14 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 
+#include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/transformiterator.h>
 #include <inviwo/core/util/stdextensions.h>
 
 #include <vector>
-#include <unordered_map>
+#include <limits>
 #include <optional>
+#include <string>
 
 namespace inviwo {
 
@@ -62,6 +64,9 @@ namespace inviwo {
  *     ╱ ▼────e0─────▶ ╲ ╱
  *   v0────────────────v1
  *
+ * The edges of face f are 3f, 3f+1 and 3f+2. The vertex and face lookups are flat vectors, and
+ * twins are found by radix sorting the undirected edge keys in parallel, instead of using maps,
+ * to keep the construction fast and compact for meshes with millions of triangles.
  */
 
 class IVW_MODULE_MESHRENDERINGGL_API HalfEdges {
@@ -134,6 +139,10 @@ public:
 
 private:
     friend EdgeIter;
+    static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+    void addFace(std::uint32_t a, std::uint32_t b, std::uint32_t c);
+    void build();
 
     /**
      * \brief A single half edge
@@ -158,14 +167,21 @@ private:
 
         /**
          * \brief Twin half edge, opposite direction.
-         * nullopt if border.
+         * none if border.
          */
-        std::optional<std::uint32_t> twin = std::nullopt;
+        std::uint32_t twin = none;
     };
 
     std::vector<HalfEdge> edges_;
-    std::unordered_map<std::uint32_t, std::uint32_t> vertexToEdge_;
-    std::unordered_map<std::uint32_t, std::uint32_t> faceToEdge_;
+    /**
+     * \brief First half edge starting at each vertex index, none for unused indices
+     */
+    std::vector<std::uint32_t> vertexToEdge_;
+    /**
+     * \brief First half edge of each used vertex, in vertex order
+     */
+    std::vector<std::uint32_t> vertexEdges_;
+    std::vector<std::uint32_t> faceToEdge_;
 };
 
 inline auto HalfEdges::faceToEdge(std::uint32_t faceIndex) const -> EdgeIter {
@@ -173,29 +189,26 @@ inline auto HalfEdges::faceToEdge(std::uint32_t faceIndex) const -> EdgeIter {
 }
 
 inline auto HalfEdges::vertexToEdge(std::uint32_t vertexIndex) const -> EdgeIter {
-    return {this, vertexToEdge_.at(vertexIndex)};
+    const auto edge = vertexIndex < vertexToEdge_.size() ? vertexToEdge_[vertexIndex] : none;
+    if (edge == none) {
+        throw RangeException("Vertex " + std::to_string(vertexIndex) + " is not part of any face",
+                             IVW_CONTEXT);
+    }
+    return {this, edge};
 }
 
 inline auto HalfEdges::faces() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
-    };
+    const auto transform = [this](std::uint32_t edge) -> EdgeIter { return {this, edge}; };
 
     return util::as_range(util::makeTransformIterator(transform, faceToEdge_.begin()),
                           util::makeTransformIterator(transform, faceToEdge_.end()));
 }
 
 inline auto HalfEdges::vertices() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
-    };
+    const auto transform = [this](std::uint32_t edge) -> EdgeIter { return {this, edge}; };
 
-    return util::as_range(util::makeTransformIterator(transform, vertexToEdge_.begin()),
-                          util::makeTransformIterator(transform, vertexToEdge_.end()));
+    return util::as_range(util::makeTransformIterator(transform, vertexEdges_.begin()),
+                          util::makeTransformIterator(transform, vertexEdges_.end()));
 }
 
 inline std::uint32_t HalfEdges::EdgeIter::vertex() const {
@@ -212,8 +225,9 @@ inline auto HalfEdges::EdgeIter::prev() const -> EdgeIter {
 }
 
 inline auto HalfEdges::EdgeIter::twin() const -> std::optional<EdgeIter> {
-    if (auto twin = edges_->edges_[edgeIndex_].twin) {
-        return EdgeIter{edges_, *twin};
+    const auto twin = edges_->edges_[edgeIndex_].twin;
+    if (twin != none) {
+        return EdgeIter{edges_, twin};
     } else {
         return std::nullopt;
     }
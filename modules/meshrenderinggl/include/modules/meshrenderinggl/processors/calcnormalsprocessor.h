@@ -33,6 +33,7 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/ports/meshport.h>
 #include <modules/meshrenderinggl/algorithm/calcnormals.h>
 
@@ -56,6 +57,8 @@ namespace inviwo {
  *       * @copydoc meshutil::CalculateMeshNormalsMode::WeightArea
  *       * @copydoc meshutil::CalculateMeshNormalsMode::WeightAngle
  *       * @copydoc meshutil::CalculateMeshNormalsMode::WeightNMax
+ *   * __Incremental__ Only recompute the normals of vertices whose triangles changed since the
+ *     last evaluation, if the triangles of the mesh are unchanged.
  *
  */
 class IVW_MODULE_MESHRENDERINGGL_API CalcNormalsProcessor : public Processor {
@@ -72,6 +75,9 @@ private:
     MeshInport inport_;
     MeshOutport outport_;
     TemplateOptionProperty<meshutil::CalculateMeshNormalsMode> mode_;
+    BoolProperty incremental_;
+
+    meshutil::IncrementalMeshNormals normals_;
 };
 
 }  // namespace inviwo
@@ -33,112 +33,278 @@
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
 
 #include <modules/base/algorithm/meshutils.h>
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 namespace inviwo {
 
 namespace meshutil {
 using Mode = CalculateMeshNormalsMode;
 
-void calculateMeshNormals(Mesh& mesh, CalculateMeshNormalsMode mode) {
-    if (mode == Mode::PassThrough) {
-        return;
-    }
+namespace {
 
-    // get input buffers
-    auto positions = mesh.getBuffer(BufferType::PositionAttrib);
+using Triangle = std::array<std::uint32_t, 3>;
 
+std::vector<vec3> getPositions(const Mesh& mesh) {
+    auto positions = mesh.getBuffer(BufferType::PositionAttrib);
     if (!positions) {
         throw Exception("Input mesh has no position buffer",
                         IVW_CONTEXT_CUSTOM("meshutil::calculateMeshNormals"));
     }
-
-    while (auto normals = mesh.getBuffer(BufferType::NormalAttrib)) {
-        mesh.removeBuffer(normals);
-    }
-
     auto vertices = positions->getRepresentation<BufferRAM>();
-    std::vector<vec3> normals(vertices->getSize(), vec3(0.0f));
+    std::vector<vec3> result(vertices->getSize(), vec3(0.0f));
+    vertices->dispatch<void, dispatching::filter::Floats>([&](auto ram) {
+        const auto& vert = ram->getDataContainer();
+        std::transform(vert.begin(), vert.end(), result.begin(),
+                       [](const auto& v) { return util::glm_convert<vec3>(v); });
+    });
+    return result;
+}
 
-    // loop over index buffers
+std::vector<Triangle> getTriangles(const Mesh& mesh) {
+    std::vector<Triangle> triangles;
     for (auto [meshInfo, buffer] : mesh.getIndexBuffers()) {
         if (meshInfo.dt != DrawType::Triangles) continue;
+        meshutil::forEachTriangle(meshInfo, *buffer,
+                                  [&](std::uint32_t i0, std::uint32_t i1, std::uint32_t i2) {
+                                      triangles.push_back({i0, i1, i2});
+                                  });
+    }
+    return triangles;
+}
 
-        vertices->dispatch<void, dispatching::filter::Floats>(
-            [&, mi = meshInfo, buf = buffer](auto ram) {
-                const auto& vert = ram->getDataContainer();
-
-                meshutil::forEachTriangle(mi, *buf, [&](auto i0, auto i1, auto i2) {
-                    const auto v0 = util::glm_convert<dvec3>(vert[i0]);
-                    const auto v1 = util::glm_convert<dvec3>(vert[i1]);
-                    const auto v2 = util::glm_convert<dvec3>(vert[i2]);
-
-                    const dvec3 n = cross(v1 - v0, v2 - v0);
-                    double l = glm::length(n);
-                    if (l < std::numeric_limits<float>::epsilon()) {
-                        // degenerated triangle
-                        return;
-                    }
-                    // weighting factor
-                    double weightA;
-                    double weightB;
-                    double weightC;
-                    switch (mode) {
-                        case Mode::WeightArea:
-                            // area = norm of cross product
-                            weightA = 1;
-                            weightB = 1;
-                            weightC = 1;
-                            break;
-                        case Mode::WeightAngle: {
-                            // based on the angle between the edges
-                            const dvec3 e0 = glm::normalize(v1 - v2);
-                            const dvec3 e1 = glm::normalize(v2 - v0);
-                            const dvec3 e2 = glm::normalize(v1 - v0);
-                            weightA = acos(dot(e1, e2)) / l;
-                            weightB = acos(dot(e0, e2)) / l;
-                            weightC = acos(dot(e0, e1)) / l;
-                            break;
-                        }
-                        case Mode::WeightNMax: {
-                            const auto edge = [](auto a, auto b) {
-                                auto e = a - b;
-                                auto l = glm::length(e);
-                                return std::make_pair(e / l, l);
-                            };
-                            const auto [e0, l0] = edge(v1, v2);
-                            const auto [e1, l1] = edge(v2, v0);
-                            const auto [e2, l2] = edge(v1, v0);
-                            weightA = sin(acos(dot(e1, e2))) / (l * l1 * l2);
-                            weightB = sin(acos(dot(e0, e2))) / (l * l0 * l2);
-                            weightC = sin(acos(dot(e0, e1))) / (l * l0 * l1);
-                            break;
-                        }
-                        case Mode::NoWeighting:
-                        default:
-                            weightA = 1.0 / l;
-                            weightB = 1.0 / l;
-                            weightC = 1.0 / l;
-                    }
-                    // add it to the vertices
-                    normals[i0] += vec3(n * weightA);
-                    normals[i1] += vec3(n * weightB);
-                    normals[i2] += vec3(n * weightC);
-                });
-            });
+/**
+ * Weighted normal of a triangle for each of its corners. The mode is a template argument to keep
+ * the per triangle work free of branches.
+ */
+template <Mode mode>
+std::array<vec3, 3> weightedNormals(const dvec3& v0, const dvec3& v1, const dvec3& v2) {
+    const dvec3 n = glm::cross(v1 - v0, v2 - v0);
+    const double l = glm::length(n);
+    if (l < std::numeric_limits<float>::epsilon()) {
+        // degenerated triangle
+        return {vec3{0.0f}, vec3{0.0f}, vec3{0.0f}};
     }
 
-    // normalize normals
-    std::transform(normals.begin(), normals.end(), normals.begin(), [](auto n) {
-        const auto l = glm::length(n);
-        if (l < std::numeric_limits<float>::epsilon()) return n;
-        return n / l;
-    });
+    if constexpr (mode == Mode::WeightArea) {
+        // area = norm of cross product
+        return {vec3(n), vec3(n), vec3(n)};
+    } else if constexpr (mode == Mode::WeightAngle) {
+        // based on the angle between the edges
+        const dvec3 e0 = glm::normalize(v1 - v2);
+        const dvec3 e1 = glm::normalize(v2 - v0);
+        const dvec3 e2 = glm::normalize(v1 - v0);
+        const dvec3 nl = n / l;
+        return {vec3(nl * std::acos(glm::dot(e1, e2))), vec3(nl * std::acos(glm::dot(e0, e2))),
+                vec3(nl * std::acos(glm::dot(e0, e1)))};
+    } else if constexpr (mode == Mode::WeightNMax) {
+        // sin(angle) / (|n| * product of the adjacent edge lengths), sin(acos(x)) = sqrt(1 - x^2)
+        const dvec3 d0 = v1 - v2;
+        const dvec3 d1 = v2 - v0;
+        const dvec3 d2 = v1 - v0;
+        const double l0 = glm::length(d0);
+        const double l1 = glm::length(d1);
+        const double l2 = glm::length(d2);
+        const auto sinAngle = [](const dvec3& a, const dvec3& b, double la, double lb) {
+            const double c = glm::dot(a, b) / (la * lb);
+            return std::sqrt(std::max(0.0, 1.0 - c * c));
+        };
+        return {vec3(n * (sinAngle(d1, d2, l1, l2) / (l * l1 * l2))),
+                vec3(n * (sinAngle(d0, d2, l0, l2) / (l * l0 * l2))),
+                vec3(n * (sinAngle(d0, d1, l0, l1) / (l * l0 * l1)))};
+    } else {
+        const vec3 nl{n / l};
+        return {nl, nl, nl};
+    }
+}
+
+/**
+ * Compute the corner contributions of the given faces in parallel. faceAt(i) gives the index of
+ * the i:th face to compute.
+ */
+template <typename FaceAt>
+void computeContributions(Mode mode, const std::vector<vec3>& positions,
+                          const std::vector<Triangle>& triangles, size_t count, FaceAt faceAt,
+                          std::vector<vec3>& contributions) {
+    const auto compute = [&](auto modeTag) {
+        constexpr Mode m = decltype(modeTag)::value;
+        util::forEachRangeParallel(count, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                const auto face = faceAt(i);
+                const auto& t = triangles[face];
+                const auto res = weightedNormals<m>(dvec3(positions[t[0]]), dvec3(positions[t[1]]),
+                                                    dvec3(positions[t[2]]));
+                std::copy(res.begin(), res.end(), contributions.begin() + 3 * face);
+            }
+        });
+    };
+    switch (mode) {
+        case Mode::WeightArea:
+            compute(std::integral_constant<Mode, Mode::WeightArea>{});
+            break;
+        case Mode::WeightAngle:
+            compute(std::integral_constant<Mode, Mode::WeightAngle>{});
+            break;
+        case Mode::WeightNMax:
+            compute(std::integral_constant<Mode, Mode::WeightNMax>{});
+            break;
+        case Mode::NoWeighting:
+        case Mode::PassThrough:
+        default:
+            compute(std::integral_constant<Mode, Mode::NoWeighting>{});
+            break;
+    }
+}
+
+/**
+ * Build the vertex to corner adjacency in CSR form, faces with out of range indices are skipped.
+ */
+void buildAdjacency(size_t nVertices, const std::vector<Triangle>& triangles,
+                    std::vector<std::uint32_t>& offsets, std::vector<std::uint32_t>& corners) {
+    const auto valid = [&](const Triangle& t) {
+        return t[0] < nVertices && t[1] < nVertices && t[2] < nVertices;
+    };
+
+    offsets.assign(nVertices + 1, 0);
+    for (const auto& t : triangles) {
+        if (!valid(t)) continue;
+        for (auto v : t) ++offsets[v + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    corners.resize(offsets.back());
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t face = 0; face < triangles.size(); ++face) {
+        const auto& t = triangles[face];
+        if (!valid(t)) continue;
+        for (std::uint32_t i = 0; i < 3; ++i) {
+            corners[cursor[t[i]]++] = static_cast<std::uint32_t>(3 * face + i);
+        }
+    }
+}
+
+vec3 sumNormal(std::uint32_t vertex, const std::vector<std::uint32_t>& offsets,
+               const std::vector<std::uint32_t>& corners, const std::vector<vec3>& contributions) {
+    vec3 n{0.0f};
+    for (auto i = offsets[vertex]; i < offsets[vertex + 1]; ++i) n += contributions[corners[i]];
+    const auto l = glm::length(n);
+    if (l < std::numeric_limits<float>::epsilon()) return n;
+    return n / l;
+}
 
+void setNormals(Mesh& mesh, std::vector<vec3> normals) {
+    while (auto normalBuffer = mesh.getBuffer(BufferType::NormalAttrib)) {
+        mesh.removeBuffer(normalBuffer);
+    }
     auto bufferRAM = std::make_shared<BufferRAMPrecision<vec3>>(std::move(normals));
     mesh.addBuffer(BufferType::NormalAttrib, std::make_shared<Buffer<vec3>>(bufferRAM));
 }
+
+}  // namespace
+
+void calculateMeshNormals(Mesh& mesh, CalculateMeshNormalsMode mode) {
+    if (mode == Mode::PassThrough) {
+        return;
+    }
+    IncrementalMeshNormals normals{mode};
+    normals.update(mesh);
+}
+
+IncrementalMeshNormals::IncrementalMeshNormals(CalculateMeshNormalsMode mode) : mode_{mode} {}
+
+void IncrementalMeshNormals::setMode(CalculateMeshNormalsMode mode) {
+    if (mode_ != mode) {
+        mode_ = mode;
+        clear();
+    }
+}
+
+CalculateMeshNormalsMode IncrementalMeshNormals::getMode() const { return mode_; }
+
+void IncrementalMeshNormals::clear() {
+    positions_.clear();
+    triangles_.clear();
+    offsets_.clear();
+    corners_.clear();
+    contributions_.clear();
+    normals_.clear();
+    updated_ = 0;
+}
+
+size_t IncrementalMeshNormals::getNumberOfUpdatedVertices() const { return updated_; }
+
+void IncrementalMeshNormals::update(Mesh& mesh) {
+    if (mode_ == Mode::PassThrough) {
+        updated_ = 0;
+        return;
+    }
+
+    auto positions = getPositions(mesh);
+    auto triangles = getTriangles(mesh);
+    const auto nVertices = positions.size();
+
+    if (offsets_.empty() || positions.size() != positions_.size() || triangles != triangles_) {
+        buildAdjacency(nVertices, triangles, offsets_, corners_);
+        contributions_.assign(3 * triangles.size(), vec3{0.0f});
+        // Faces with out of range indices have no corners in the adjacency
+        std::vector<std::uint32_t> faces;
+        faces.reserve(triangles.size());
+        for (std::uint32_t face = 0; face < static_cast<std::uint32_t>(triangles.size()); ++face) {
+            const auto& t = triangles[face];
+            if (t[0] < nVertices && t[1] < nVertices && t[2] < nVertices) faces.push_back(face);
+        }
+        computeContributions(mode_, positions, triangles, faces.size(),
+                             [&](size_t i) { return faces[i]; }, contributions_);
+
+        normals_.resize(nVertices);
+        util::forEachRangeParallel(nVertices, [&](size_t first, size_t last) {
+            for (size_t v = first; v < last; ++v) {
+                normals_[v] =
+                    sumNormal(static_cast<std::uint32_t>(v), offsets_, corners_, contributions_);
+            }
+        });
+        updated_ = nVertices;
+    } else {
+        // Faces that have a moved vertex, and the vertices of those faces
+        std::vector<char> faceChanged(triangles.size(), 0);
+        std::vector<char> vertexChanged(nVertices, 0);
+        for (size_t v = 0; v < nVertices; ++v) {
+            if (positions[v] == positions_[v]) continue;
+            for (auto i = offsets_[v]; i < offsets_[v + 1]; ++i) faceChanged[corners_[i] / 3] = 1;
+        }
+        std::vector<std::uint32_t> faces;
+        std::vector<std::uint32_t> vertices;
+        for (std::uint32_t face = 0; face < static_cast<std::uint32_t>(triangles.size()); ++face) {
+            if (!faceChanged[face]) continue;
+            faces.push_back(face);
+            for (auto v : triangles[face]) {
+                if (!vertexChanged[v]) {
+                    vertexChanged[v] = 1;
+                    vertices.push_back(v);
+                }
+            }
+        }
+
+        computeContributions(mode_, positions, triangles, faces.size(),
+                             [&](size_t i) { return faces[i]; }, contributions_);
+        util::forEachRangeParallel(vertices.size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                normals_[vertices[i]] = sumNormal(vertices[i], offsets_, corners_, contributions_);
+            }
+        });
+        updated_ = vertices.size();
+    }
+
+    positions_ = std::move(positions);
+    triangles_ = std::move(triangles);
+    setNormals(mesh, normals_);
+}
+
 }  // namespace meshutil
 
 }  // namespace inviwo
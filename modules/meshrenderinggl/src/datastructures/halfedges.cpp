@@ -29,88 +29,167 @@
 
 #include <modules/meshrenderinggl/datastructures/halfedges.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
 #include <modules/base/algorithm/meshutils.h>
 
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
 
 namespace inviwo {
 
-HalfEdges::HalfEdges(Mesh::MeshInfo info, const IndexBuffer& indexBuffer) {
-    // map to fill in the opposite direction
-    // (start_vertex, end_vertex) -> edge_index
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
-
-    std::uint32_t face = 0;
-    meshutil::forEachTriangle(info, indexBuffer,
-                              [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
-                                  // a-b, b-c, c-a
-                                  const auto count = static_cast<std::uint32_t>(edges_.size());
-                                  edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                  edgeMap.try_emplace({a, b}, count + 0);
-                                  vertexToEdge_.try_emplace(a, count + 0);
-
-                                  edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                  edgeMap.try_emplace({b, c}, count + 1);
-                                  vertexToEdge_.try_emplace(b, count + 1);
+namespace {
+
+struct EdgeKey {
+    std::uint64_t key;
+    std::uint32_t edge;
+};
+
+/**
+ * Stable LSD radix sort of keys on the lowest keyBits bits of EdgeKey::key. Each pass counts the
+ * digits of fixed chunks in parallel and then scatters the chunks in parallel.
+ */
+void radixSort(std::vector<EdgeKey>& keys, size_t keyBits) {
+    constexpr size_t digitBits = 8;
+    constexpr size_t buckets = size_t{1} << digitBits;
+    constexpr std::uint64_t mask = buckets - 1;
+
+    const auto size = keys.size();
+    const auto chunkSize = std::max<size_t>(size_t{1} << 14, (size + 63) / 64);
+    const auto nChunks = (size + chunkSize - 1) / chunkSize;
+
+    std::vector<EdgeKey> tmp(size);
+    std::vector<std::array<size_t, buckets>> offsets(nChunks);
+    for (size_t shift = 0; shift < keyBits; shift += digitBits) {
+        util::forEachRangeParallel(nChunks, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                auto& count = offsets[chunk];
+                count.fill(0);
+                const auto end = std::min(size, (chunk + 1) * chunkSize);
+                for (size_t i = chunk * chunkSize; i < end; ++i) {
+                    ++count[(keys[i].key >> shift) & mask];
+                }
+            }
+        });
+
+        size_t sum = 0;
+        for (size_t digit = 0; digit < buckets; ++digit) {
+            for (auto& offset : offsets) {
+                const auto count = offset[digit];
+                offset[digit] = sum;
+                sum += count;
+            }
+        }
 
-                                  edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                  edgeMap.try_emplace({c, a}, count + 2);
-                                  vertexToEdge_.try_emplace(c, count + 2);
+        util::forEachRangeParallel(nChunks, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                auto& offset = offsets[chunk];
+                const auto end = std::min(size, (chunk + 1) * chunkSize);
+                for (size_t i = chunk * chunkSize; i < end; ++i) {
+                    tmp[offset[(keys[i].key >> shift) & mask]++] = keys[i];
+                }
+            }
+        });
+        std::swap(keys, tmp);
+    }
+}
 
-                                  faceToEdge_.try_emplace(face, count);
+}  // namespace
 
-                                  ++face;
+HalfEdges::HalfEdges(Mesh::MeshInfo info, const IndexBuffer& indexBuffer) {
+    if (info.ct == ConnectivityType::None) edges_.reserve(indexBuffer.getSize());
+    meshutil::forEachTriangle(info, indexBuffer,
+                              [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+                                  addFace(a, b, c);
                               });
-
-    for (auto& edge : edges_) {
-        const auto a = edge.vertex;
-        const auto b = edges_[edge.next].vertex;
-
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
-        }
-    }
+    build();
 }
 
 HalfEdges::HalfEdges(const Mesh& mesh) {
-
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
-    std::uint32_t face = 0;
-
     for (auto [info, indexBuffer] : mesh.getIndexBuffers()) {
         if (info.dt != DrawType::Triangles) continue;
         meshutil::forEachTriangle(info, *indexBuffer,
                                   [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
-                                      // a-b, b-c, c-a
-                                      const auto count = static_cast<std::uint32_t>(edges_.size());
-                                      edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                      edgeMap.try_emplace({a, b}, count + 0);
-                                      vertexToEdge_.try_emplace(a, count + 0);
+                                      addFace(a, b, c);
+                                  });
+    }
+    build();
+}
 
-                                      edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                      edgeMap.try_emplace({b, c}, count + 1);
-                                      vertexToEdge_.try_emplace(b, count + 1);
+void HalfEdges::addFace(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+    // a-b, b-c, c-a
+    const auto face = static_cast<std::uint32_t>(faceToEdge_.size());
+    const auto count = static_cast<std::uint32_t>(edges_.size());
+    edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
+    edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
+    edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
+    faceToEdge_.push_back(count);
+}
 
-                                      edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                      edgeMap.try_emplace({c, a}, count + 2);
-                                      vertexToEdge_.try_emplace(c, count + 2);
+void HalfEdges::build() {
+    if (edges_.empty()) return;
 
-                                      faceToEdge_.try_emplace(face, count);
+    const auto maxVertex =
+        std::max_element(edges_.begin(), edges_.end(), [](const auto& a, const auto& b) {
+            return a.vertex < b.vertex;
+        })->vertex;
 
-                                      ++face;
-                                  });
+    // The first edge starting at each vertex
+    vertexToEdge_.assign(static_cast<size_t>(maxVertex) + 1, none);
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(edges_.size()); ++i) {
+        auto& edge = vertexToEdge_[edges_[i].vertex];
+        if (edge == none) edge = i;
     }
-
-    for (auto& edge : edges_) {
-        const auto a = edge.vertex;
-        const auto b = edges_[edge.next].vertex;
-
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
+    vertexEdges_.reserve(vertexToEdge_.size());
+    std::copy_if(vertexToEdge_.begin(), vertexToEdge_.end(), std::back_inserter(vertexEdges_),
+                 [](std::uint32_t edge) { return edge != none; });
+
+    // Sort the edges on the undirected key (min(a,b), max(a,b)), the sort is stable so within a
+    // key the edges stay in index order.
+    size_t bits = 1;
+    while (bits < 32 && (std::uint64_t{maxVertex} >> bits) != 0) ++bits;
+
+    std::vector<EdgeKey> keys(edges_.size());
+    util::forEachRangeParallel(edges_.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            const std::uint64_t a = edges_[i].vertex;
+            const std::uint64_t b = edges_[edges_[i].next].vertex;
+            keys[i] = EdgeKey{(std::min(a, b) << bits) | std::max(a, b),
+                              static_cast<std::uint32_t>(i)};
         }
-    }
+    });
+    radixSort(keys, 2 * bits);
+
+    // The twin of an edge a-b is the first edge b-a, same as looking it up in a map of directed
+    // edges. Each range handles the runs of equal keys that start inside it.
+    util::forEachRangeParallel(keys.size(), [&](size_t first, size_t last) {
+        auto begin = first;
+        while (begin > 0 && begin < keys.size() && keys[begin].key == keys[begin - 1].key) {
+            ++begin;
+        }
+        while (begin < last) {
+            auto end = begin + 1;
+            while (end < keys.size() && keys[end].key == keys[begin].key) ++end;
+
+            std::uint32_t forward = none;
+            std::uint32_t backward = none;
+            for (auto i = begin; i < end; ++i) {
+                const auto edge = keys[i].edge;
+                const auto a = edges_[edge].vertex;
+                const auto b = edges_[edges_[edge].next].vertex;
+                if (a <= b && forward == none) forward = edge;
+                if (b <= a && backward == none) backward = edge;
+            }
+            for (auto i = begin; i < end; ++i) {
+                const auto edge = keys[i].edge;
+                const auto a = edges_[edge].vertex;
+                const auto b = edges_[edges_[edge].next].vertex;
+                edges_[edge].twin = a < b ? backward : forward;
+            }
+            begin = end;
+        }
+    });
 }
 
 IndexBuffer HalfEdges::createIndexBuffer() const {
@@ -54,16 +54,27 @@ CalcNormalsProcessor::CalcNormalsProcessor()
                 {"angle", "Angle-weighting", meshutil::CalculateMeshNormalsMode::WeightAngle},
                 {"nmax", "Based on N.Max", meshutil::CalculateMeshNormalsMode::WeightNMax},
             },
-            4) {
+            4)
+    , incremental_("incremental", "Incremental", false) {
     addPort(inport_);
     addPort(outport_);
 
     addProperty(mode_);
+    addProperty(incremental_);
 }
 
 void CalcNormalsProcessor::process() {
-    outport_.setData(
-        std::shared_ptr<Mesh>(meshutil::calculateMeshNormals(*inport_.getData(), mode_)));
+    if (!incremental_) {
+        normals_.clear();
+        outport_.setData(
+            std::shared_ptr<Mesh>(meshutil::calculateMeshNormals(*inport_.getData(), mode_)));
+        return;
+    }
+
+    auto mesh = std::shared_ptr<Mesh>(inport_.getData()->clone());
+    normals_.setMode(mode_);
+    normals_.update(*mesh);
+    outport_.setData(mesh);
 }
 
 }  // namespace inviwo
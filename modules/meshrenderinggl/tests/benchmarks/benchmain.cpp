@@ -0,0 +1,164 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <modules/meshrenderinggl/datastructures/halfedges.h>
+#include <modules/meshrenderinggl/algorithm/calcnormals.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+// A grid of size x size quads, two triangles each
+IndexBuffer createPlane(std::uint32_t size) {
+    std::vector<std::uint32_t> indices;
+    indices.reserve(size_t{6} * size * size);
+    const auto index = [&](std::uint32_t x, std::uint32_t y) { return x + y * (size + 1); };
+    for (std::uint32_t y = 0; y < size; ++y) {
+        for (std::uint32_t x = 0; x < size; ++x) {
+            indices.insert(indices.end(), {index(x, y), index(x + 1, y), index(x, y + 1)});
+            indices.insert(indices.end(),
+                           {index(x + 1, y), index(x + 1, y + 1), index(x, y + 1)});
+        }
+    }
+    return IndexBuffer(std::make_shared<IndexBufferRAM>(std::move(indices)));
+}
+
+const Mesh::MeshInfo triangles{DrawType::Triangles, ConnectivityType::None};
+
+std::unique_ptr<Mesh> createPlaneMesh(std::uint32_t size) {
+    std::vector<vec3> positions;
+    positions.reserve(size_t{size + 1} * (size + 1));
+    for (std::uint32_t y = 0; y <= size; ++y) {
+        for (std::uint32_t x = 0; x <= size; ++x) {
+            positions.emplace_back(static_cast<float>(x), static_cast<float>(y),
+                                   std::sin(0.1f * x) * std::cos(0.1f * y));
+        }
+    }
+    auto mesh = std::make_unique<Mesh>();
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    mesh->addIndices(triangles, std::make_shared<IndexBuffer>(createPlane(size)));
+    return mesh;
+}
+
+}  // namespace
+
+static void HalfEdgesBuild(benchmark::State& state) {
+    const auto plane = createPlane(static_cast<std::uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        HalfEdges edges(triangles, plane);
+        benchmark::DoNotOptimize(edges);
+    }
+    state.counters["Triangles"] = 2.0 * state.range(0) * state.range(0);
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0) * state.range(0));
+}
+
+static void HalfEdgesAdjacency(benchmark::State& state) {
+    const auto plane = createPlane(static_cast<std::uint32_t>(state.range(0)));
+    const HalfEdges edges(triangles, plane);
+    for (auto _ : state) {
+        auto indices = edges.createIndexBufferWithAdjacency();
+        benchmark::DoNotOptimize(indices);
+    }
+    state.counters["Triangles"] = 2.0 * state.range(0) * state.range(0);
+}
+
+static void HalfEdgesVertexValence(benchmark::State& state) {
+    const auto plane = createPlane(static_cast<std::uint32_t>(state.range(0)));
+    const HalfEdges edges(triangles, plane);
+    for (auto _ : state) {
+        // Walk the one ring of every vertex, stopping at borders
+        size_t valence = 0;
+        for (auto start : edges.vertices()) {
+            auto edge = start;
+            do {
+                ++valence;
+                auto twin = edge.prev().twin();
+                if (!twin) break;
+                edge = *twin;
+            } while (edge != start);
+        }
+        benchmark::DoNotOptimize(valence);
+    }
+    state.counters["Vertices"] = (state.range(0) + 1.0) * (state.range(0) + 1.0);
+}
+
+static void CalcNormals(benchmark::State& state) {
+    auto mesh = createPlaneMesh(static_cast<std::uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        meshutil::calculateMeshNormals(*mesh, meshutil::CalculateMeshNormalsMode::WeightNMax);
+    }
+    state.counters["Triangles"] = 2.0 * state.range(0) * state.range(0);
+}
+
+static void CalcNormalsIncremental(benchmark::State& state) {
+    auto mesh = createPlaneMesh(static_cast<std::uint32_t>(state.range(0)));
+    meshutil::IncrementalMeshNormals normals{meshutil::CalculateMeshNormalsMode::WeightNMax};
+    normals.update(*mesh);
+    auto& positions = static_cast<BufferRAMPrecision<vec3>*>(
+                          mesh->getBuffer(BufferType::PositionAttrib)
+                              ->getEditableRepresentation<BufferRAM>())
+                          ->getDataContainer();
+    float offset = 0.0f;
+    for (auto _ : state) {
+        // Move a single vertex in the middle of the plane
+        offset += 0.01f;
+        positions[positions.size() / 2].z = offset;
+        normals.update(*mesh);
+    }
+    state.counters["Triangles"] = 2.0 * state.range(0) * state.range(0);
+}
+
+BENCHMARK(HalfEdgesBuild)->RangeMultiplier(4)->Range(64, 2048)->UseRealTime();
+BENCHMARK(HalfEdgesAdjacency)->RangeMultiplier(4)->Range(64, 2048)->UseRealTime();
+BENCHMARK(HalfEdgesVertexValence)->RangeMultiplier(4)->Range(64, 2048)->UseRealTime();
+BENCHMARK(CalcNormals)->RangeMultiplier(4)->Range(64, 2048)->UseRealTime();
+BENCHMARK(CalcNormalsIncremental)->RangeMultiplier(4)->Range(64, 2048)->UseRealTime();
+
+int main(int argc, char** argv) {
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
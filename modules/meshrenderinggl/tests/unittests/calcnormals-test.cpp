@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/meshrenderinggl/algorithm/calcnormals.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+namespace inviwo {
+
+namespace {
+
+// A grid of size x size quads in the xy-plane, two triangles each
+std::shared_ptr<Mesh> createPlane(std::uint32_t size) {
+    std::vector<vec3> positions;
+    for (std::uint32_t y = 0; y <= size; ++y) {
+        for (std::uint32_t x = 0; x <= size; ++x) {
+            positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+        }
+    }
+    std::vector<std::uint32_t> indices;
+    const auto index = [&](std::uint32_t x, std::uint32_t y) { return x + y * (size + 1); };
+    for (std::uint32_t y = 0; y < size; ++y) {
+        for (std::uint32_t x = 0; x < size; ++x) {
+            indices.insert(indices.end(), {index(x, y), index(x + 1, y), index(x, y + 1)});
+            indices.insert(indices.end(),
+                           {index(x + 1, y), index(x + 1, y + 1), index(x, y + 1)});
+        }
+    }
+    auto mesh = std::make_shared<Mesh>();
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    mesh->addIndices(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None},
+                     util::makeIndexBuffer(std::move(indices)));
+    return mesh;
+}
+
+std::vector<vec3> getNormals(const Mesh& mesh) {
+    auto normals = mesh.getBuffer(BufferType::NormalAttrib);
+    return static_cast<const BufferRAMPrecision<vec3>*>(normals->getRepresentation<BufferRAM>())
+        ->getDataContainer();
+}
+
+void movePosition(Mesh& mesh, size_t vertex, const vec3& pos) {
+    auto positions = mesh.getBuffer(BufferType::PositionAttrib);
+    static_cast<BufferRAMPrecision<vec3>*>(positions->getEditableRepresentation<BufferRAM>())
+        ->getDataContainer()[vertex] = pos;
+}
+
+}  // namespace
+
+TEST(CalcNormals, plane) {
+    for (auto mode : {meshutil::CalculateMeshNormalsMode::NoWeighting,
+                      meshutil::CalculateMeshNormalsMode::WeightArea,
+                      meshutil::CalculateMeshNormalsMode::WeightAngle,
+                      meshutil::CalculateMeshNormalsMode::WeightNMax}) {
+        auto mesh = createPlane(4);
+        meshutil::calculateMeshNormals(*mesh, mode);
+        const auto normals = getNormals(*mesh);
+        ASSERT_EQ(25, normals.size());
+        for (const auto& n : normals) {
+            EXPECT_NEAR(0.0f, n.x, 1.0e-6f);
+            EXPECT_NEAR(0.0f, n.y, 1.0e-6f);
+            EXPECT_NEAR(1.0f, n.z, 1.0e-6f);
+        }
+    }
+}
+
+TEST(CalcNormals, incremental) {
+    auto mesh = createPlane(4);
+    meshutil::IncrementalMeshNormals incremental{meshutil::CalculateMeshNormalsMode::WeightNMax};
+    incremental.update(*mesh);
+    EXPECT_EQ(25, incremental.getNumberOfUpdatedVertices());
+
+    incremental.update(*mesh);
+    EXPECT_EQ(0, incremental.getNumberOfUpdatedVertices());
+
+    // Move an interior vertex, its six neighbors and itself are affected
+    movePosition(*mesh, 12, vec3{2.0f, 2.0f, 0.5f});
+    incremental.update(*mesh);
+    EXPECT_EQ(7, incremental.getNumberOfUpdatedVertices());
+    const auto normals = getNormals(*mesh);
+
+    meshutil::calculateMeshNormals(*mesh, meshutil::CalculateMeshNormalsMode::WeightNMax);
+    const auto expected = getNormals(*mesh);
+    ASSERT_EQ(expected.size(), normals.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], normals[i]) << "vertex " << i;
+    }
+}
+
+}  // namespace inviwo
@@ -331,4 +331,39 @@ TEST(HalfEdges, indexbufferAdjacency) {
     }
 }
 
+TEST(HalfEdges, twinsAndVertices) {
+    constexpr int width = 40;
+    constexpr int height = 30;
+    const IndexBuffer plane = createPlane(width, height);
+
+    HalfEdges edges(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None}, plane);
+
+    size_t borderEdges = 0;
+    for (auto face : edges.faces()) {
+        auto edge = face;
+        do {
+            if (auto twin = edge.twin()) {
+                EXPECT_EQ(edge, *twin->twin());
+                EXPECT_EQ(edge.vertex(), twin->next().vertex());
+                EXPECT_EQ(edge.next().vertex(), twin->vertex());
+            } else {
+                ++borderEdges;
+            }
+        } while (++edge != face);
+    }
+    EXPECT_EQ(borderEdges, 2 * (width + height));
+
+    for (std::uint32_t v = 0; v < (width + 1) * (height + 1); ++v) {
+        EXPECT_EQ(v, edges.vertexToEdge(v).vertex());
+    }
+    EXPECT_THROW(edges.vertexToEdge((width + 1) * (height + 1)), RangeException);
+
+    // A vertex index that is not used by any face
+    IndexBuffer gap{};
+    gap.getEditableRAMRepresentation()->add({0, 1, 3});
+    HalfEdges gapEdges(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None}, gap);
+    EXPECT_EQ(std::distance(gapEdges.vertices().begin(), gapEdges.vertices().end()), 3);
+    EXPECT_THROW(gapEdges.vertexToEdge(2), RangeException);
+}
+
 }  // namespace inviwo
@@ -34,7 +34,13 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/util/formatdispatching.h>
+#include <algorithm>
 #include <ostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -46,6 +52,10 @@ struct RegresionResult {
     double corr;
 };
 
+/**
+ * \brief Compute a linear regression of Y on X, ignoring pairs containing NaNs.
+ * Large buffers are processed in parallel on the thread pool.
+ */
 IVW_MODULE_PLOTTING_API RegresionResult linearRegresion(const BufferBase& X, const BufferBase& Y);
 
 template <class Elem, class Traits>
@@ -56,9 +66,95 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& o
     return os;
 }
 
+/**
+ * \brief Summary statistics of the first component of a buffer, NaNs are excluded.
+ */
+struct Moments {
+    size_t count = 0;  /// number of non-NaN values
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+    double mean = std::numeric_limits<double>::quiet_NaN();
+    double m2 = 0.0;  /// sum of squared differences from the mean
+
+    double variance() const {
+        return count > 0 ? m2 / static_cast<double>(count)
+                         : std::numeric_limits<double>::quiet_NaN();
+    }
+    double standardDeviation() const { return std::sqrt(variance()); }
+
+    /**
+     * Add a single value, using Welford's online algorithm.
+     */
+    void add(double value);
+    /**
+     * Combine with the moments of another, disjoint, set of values.
+     */
+    void merge(const Moments& other);
+};
+
+/**
+ * \brief Compute count, min, max, mean and variance in a single pass over the buffer.
+ * Large buffers are processed in parallel on the thread pool.
+ */
+IVW_MODULE_PLOTTING_API Moments moments(const BufferBase& buffer);
+
+namespace detail {
+
+IVW_MODULE_PLOTTING_API size_t percentileRank(size_t nElements, double percentile);
+
+/**
+ * Partially sort [first, last) such that *(begin + rank) holds the element of that rank for all
+ * ranks in the sorted range [ranksBegin, ranksEnd). The middle rank is selected using
+ * std::nth_element, which splits both the elements and the ranks in two halves for the recursion.
+ */
+template <typename Iter, typename RankIter>
+void multiSelect(Iter begin, Iter first, Iter last, RankIter ranksBegin, RankIter ranksEnd) {
+    if (ranksBegin == ranksEnd || first == last) return;
+    const auto rank = (ranksBegin + (ranksEnd - ranksBegin) / 2)->first;
+    auto nth = begin + rank;
+    std::nth_element(first, nth, last);
+
+    const auto lower =
+        std::partition_point(ranksBegin, ranksEnd, [&](const auto& r) { return r.first < rank; });
+    const auto upper =
+        std::partition_point(lower, ranksEnd, [&](const auto& r) { return r.first == rank; });
+    multiSelect(begin, first, nth, ranksBegin, lower);
+    multiSelect(begin, nth + 1, last, upper, ranksEnd);
+}
+
+/**
+ * Select the values at the nearest rank of each percentile in [begin, end). Instead of sorting,
+ * the range is recursively partitioned around the middle of the requested ranks using
+ * std::nth_element, i.e. O(N log P) for P percentiles.
+ */
+template <typename Iter>
+auto selectPercentiles(Iter begin, Iter end, const std::vector<double>& percentiles) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    const auto nElements = static_cast<size_t>(std::distance(begin, end));
+
+    std::vector<std::pair<size_t, size_t>> ranks;  // rank, index of percentile
+    ranks.reserve(percentiles.size());
+    for (size_t i = 0; i < percentiles.size(); ++i) {
+        ranks.emplace_back(percentileRank(nElements, percentiles[i]), i);
+    }
+    std::sort(ranks.begin(), ranks.end());
+
+    std::vector<T> result(percentiles.size());
+    if (nElements == 0) return result;
+
+    multiSelect(begin, begin, end, ranks.begin(), ranks.end());
+    for (const auto& [rank, i] : ranks) {
+        result[i] = *(begin + rank);
+    }
+    return result;
+}
+
+}  // namespace detail
+
 /**
  * \brief Compute value below a percentage of observations in the data.
  * Uses the nearest rank method, i.e. ceil(percentile * N), where N = number of elements in data.
+ * All percentiles are found in one pass of partial selection, the data is not fully sorted.
  *
  * NaNs (Not a Numbers) are excluded from the computation.
  * The following example will return {1,2}
@@ -74,42 +170,74 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& o
  */
 template <typename T, typename std::enable_if<!util::is_floating_point<T>::value, int>::type = 0>
 std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    std::sort(data.begin(), data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    auto nElements = data.size();
     for (auto percentile : percentiles) {
         if (percentile < 0.f || percentile > 1.f) {
             throw Exception("Percentile must be between 0 and 1",
                             IVW_CONTEXT_CUSTOM("statsutil::percentiles"));
         }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
     }
-    return result;
+    return detail::selectPercentiles(data.begin(), data.end(), percentiles);
 }
 
 // Float/double types have special values
 template <typename T, typename std::enable_if<util::is_floating_point<T>::value, int>::type = 0>
 std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    auto noNaN =
-        std::partition(data.begin(), data.end(), [](const auto& a) { return util::isnan(a); });
-    std::sort(noNaN, data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    size_t nElements = std::distance(noNaN, data.end());
     for (auto percentile : percentiles) {
         if (percentile < 0.f || percentile > 1.f) {
             throw std::invalid_argument("Percentile must be between 0 and 1");
         }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
     }
-    return result;
+    auto noNaN =
+        std::partition(data.begin(), data.end(), [](const auto& a) { return util::isnan(a); });
+    return detail::selectPercentiles(noNaN, data.end(), percentiles);
 }
 
+/**
+ * \brief Caches statistics of buffers, for example DataFrame columns, so that repeated queries,
+ * say on every redraw of a plot, do not need to touch the data again.
+ *
+ * Entries are keyed on the buffer and are considered valid as long as the buffer is alive and its
+ * size and modification count (Data::getModificationCount) are unchanged, i.e. in-place edits
+ * through getEditableRepresentation are detected. The cache is thread safe.
+ */
+class IVW_MODULE_PLOTTING_API StatisticsCache {
+public:
+    Moments moments(const std::shared_ptr<const BufferBase>& buffer);
+    /**
+     * Same as percentiles(std::vector<T>, const std::vector<double>&) for the first component of
+     * the buffer, converted to double. Each percentile is computed once per buffer.
+     */
+    std::vector<double> percentiles(const std::shared_ptr<const BufferBase>& buffer,
+                                    const std::vector<double>& percentiles);
+    RegresionResult linearRegresion(const std::shared_ptr<const BufferBase>& x,
+                                    const std::shared_ptr<const BufferBase>& y);
+
+    void invalidate(const BufferBase* buffer);
+    void clear();
+
+private:
+    struct Entry {
+        std::weak_ptr<const BufferBase> buffer;
+        size_t size;
+        size_t modification;
+        std::optional<Moments> moments;
+        std::map<double, double> percentiles;
+    };
+    struct RegressionEntry {
+        std::weak_ptr<const BufferBase> x;
+        std::weak_ptr<const BufferBase> y;
+        size_t size;
+        size_t xModification;
+        size_t yModification;
+        RegresionResult result;
+    };
+    Entry& getEntry(const std::shared_ptr<const BufferBase>& buffer);
+
+    std::mutex mutex_;
+    std::unordered_map<const BufferBase*, Entry> entries_;
+    std::map<std::pair<const BufferBase*, const BufferBase*>, RegressionEntry> regressions_;
+};
+
 }  // namespace statsutil
 
 }  // namespace inviwo
@@ -28,11 +28,40 @@
  *********************************************************************************/
 
 #include <modules/plotting/utils/statsutils.h>
-#include <inviwo/core/util/zip.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/foreach.h>
 
 namespace inviwo {
 namespace statsutil {
 namespace detail {
+
+// Minimum number of elements per job for parallel reductions
+constexpr size_t minElementsPerJob = 65536;
+
+/**
+ * Split [0, size) into contiguous ranges, call \p reduce(begin, end) for each using
+ * util::forEachRangeParallel and return the partial results in order. Small inputs are processed
+ * in the calling thread.
+ */
+template <typename Reduce>
+auto reduceRanges(size_t size, Reduce reduce) {
+    using R = decltype(reduce(size_t{0}, size_t{0}));
+    size_t jobs = 1;
+    if (InviwoApplication::isInitialized()) {
+        jobs = std::min(InviwoApplication::getPtr()->getPoolSize(), size / minElementsPerJob);
+    }
+    if (jobs <= 1) {
+        return std::vector<R>{reduce(size_t{0}, size)};
+    }
+    std::vector<R> results(jobs);
+    util::forEachRangeParallel(jobs, [&](size_t firstJob, size_t lastJob) {
+        for (size_t job = firstJob; job < lastJob; ++job) {
+            results[job] = reduce(job * size / jobs, (job + 1) * size / jobs);
+        }
+    });
+    return results;
+}
+
 template <typename Tx, typename Ty>
 RegresionResult linearRegresion(const Tx &X, const Ty &Y) {
     RegresionResult res;
@@ -43,60 +72,72 @@ RegresionResult linearRegresion(const Tx &X, const Ty &Y) {
     auto &xvec = X.getDataContainer();
     auto &yvec = Y.getDataContainer();
 
+    auto isNaN = [](auto x, auto y) {
+        return std::isnan(static_cast<double>(x)) || std::isnan(static_cast<double>(y));
+    };
+
+    struct Sums {
+        double n = 0;
+        double x = 0;
+        double y = 0;
+        double xx = 0;
+        double xy = 0;
+    };
     // Ax = b;
     // Minimize the sum of squares of individual errors
     // http://users.metu.edu.tr/csert/me310/me310_5_regression.pdf
-    dmat2 A = dmat2(xvec.size(), 0, 0, 0);
-    dvec2 b(0);
-    double sumX = 0;
-    double sumY = 0;
-
-    // Iterate over containers in sync
-    for (auto &&i : util::zip(xvec, yvec)) {
-        auto x = get<0>(i);
-        auto y = get<1>(i);
-        if (std::isnan(static_cast<double>(x)) || std::isnan(static_cast<double>(y))) {
-            --A[0][0];
-            continue;
+    const auto partialSums = reduceRanges(xvec.size(), [&](size_t begin, size_t end) {
+        Sums sums;
+        for (size_t i = begin; i < end; ++i) {
+            if (isNaN(xvec[i], yvec[i])) continue;
+            const auto x = static_cast<double>(xvec[i]);
+            const auto y = static_cast<double>(yvec[i]);
+            sums.n += 1;
+            sums.x += x;
+            sums.y += y;
+            sums.xx += x * x;
+            sums.xy += y * x;
         }
-        sumX += x;
-        sumY += y;
-        A[1][1] += x * x;
-        b.y += y * x;
+        return sums;
+    });
+    Sums sums;
+    for (const auto &p : partialSums) {
+        sums.n += p.n;
+        sums.x += p.x;
+        sums.y += p.y;
+        sums.xx += p.xx;
+        sums.xy += p.xy;
     }
 
-    b.x = sumY;
-    A[1][0] = A[0][1] = sumX;
+    const dmat2 A = dmat2(sums.n, sums.x, sums.x, sums.xx);
+    const dvec2 b(sums.y, sums.xy);
     dvec2 km = glm::inverse(A) * b;
     res.k = km.y;
     res.m = km.x;
-    res.r2 = 0;
-    double meanX = sumX / A[0][0];
-    double meanY = sumY / A[0][0];
-    double stdX = 0;
-    double stdY = 0;
-
-    for (auto &&i : util::zip(xvec, yvec)) {
-        if (std::isnan(static_cast<double>(get<0>(i))) ||
-            std::isnan(static_cast<double>(get<1>(i)))) {
-            continue;
-        }
-        auto x = get<0>(i) - meanX;
-        auto y = get<1>(i) - meanY;
-
-        stdX += x * x;
-        stdY += y * y;
+    const double meanX = sums.x / sums.n;
+    const double meanY = sums.y / sums.n;
 
-        res.r2 += x * y;
+    const auto partialDeviations = reduceRanges(xvec.size(), [&](size_t begin, size_t end) {
+        dvec3 dev{0.0};  // xx, yy, xy
+        for (size_t i = begin; i < end; ++i) {
+            if (isNaN(xvec[i], yvec[i])) continue;
+            const auto x = static_cast<double>(xvec[i]) - meanX;
+            const auto y = static_cast<double>(yvec[i]) - meanY;
+            dev.x += x * x;
+            dev.y += y * y;
+            dev.z += x * y;
+        }
+        return dev;
+    });
+    dvec3 dev{0.0};
+    for (const auto &p : partialDeviations) {
+        dev += p;
     }
 
-    stdX /= A[0][0];
-    stdY /= A[0][0];
-
-    stdX = std::sqrt(stdX);
-    stdY = std::sqrt(stdY);
+    const double stdX = std::sqrt(dev.x / sums.n);
+    const double stdY = std::sqrt(dev.y / sums.n);
 
-    res.r2 /= A[0][0];
+    res.r2 = dev.z / sums.n;
     res.r2 /= stdX * stdY;
 
     res.corr = std::abs(res.r2);
@@ -106,8 +147,47 @@ RegresionResult linearRegresion(const Tx &X, const Ty &Y) {
     return res;
 }
 
+size_t percentileRank(size_t nElements, double percentile) {
+    if (nElements == 0) return 0;
+    // Take care of percentile == 1 using std::min
+    return std::min(
+        nElements - 1,
+        static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.)));
+}
+
 }  // namespace detail
 
+void Moments::add(double value) {
+    if (count == 0) {
+        min = max = mean = value;
+        m2 = 0.0;
+        count = 1;
+        return;
+    }
+    ++count;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    const double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+}
+
+void Moments::merge(const Moments &other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    const double n = static_cast<double>(count + other.count);
+    const double delta = other.mean - mean;
+    mean += delta * static_cast<double>(other.count) / n;
+    m2 += other.m2 +
+          delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / n;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    count += other.count;
+}
+
 RegresionResult linearRegresion(const BufferBase &X, const BufferBase &Y) {
     return X.getRepresentation<BufferRAM>()
         ->dispatch<RegresionResult, dispatching::filter::Scalars>([&](auto Xbuf) {
@@ -117,6 +197,126 @@ RegresionResult linearRegresion(const BufferBase &X, const BufferBase &Y) {
         });
 }
 
+Moments moments(const BufferBase &buffer) {
+    return buffer.getRepresentation<BufferRAM>()->dispatch<Moments>([&](auto buf) {
+        const auto &data = buf->getDataContainer();
+        const auto partial = detail::reduceRanges(data.size(), [&](size_t begin, size_t end) {
+            Moments m;
+            for (size_t i = begin; i < end; ++i) {
+                const auto v = util::glmcomp(data[i], 0);
+                if (util::isnan(v)) continue;
+                m.add(static_cast<double>(v));
+            }
+            return m;
+        });
+        Moments result;
+        for (const auto &m : partial) {
+            result.merge(m);
+        }
+        return result;
+    });
+}
+
+auto StatisticsCache::getEntry(const std::shared_ptr<const BufferBase> &buffer) -> Entry & {
+    const auto size = buffer->getSize();
+    const auto modification = buffer->getModificationCount();
+    auto it = entries_.find(buffer.get());
+    if (it != entries_.end() &&
+        (it->second.buffer.lock() != buffer || it->second.size != size ||
+         it->second.modification != modification)) {
+        entries_.erase(it);
+        it = entries_.end();
+    }
+    if (it == entries_.end()) {
+        // drop entries of buffers that no longer exist
+        util::map_erase_remove_if(entries_,
+                                  [](const auto &e) { return e.second.buffer.expired(); });
+        it = entries_.emplace(buffer.get(), Entry{buffer, size, modification, {}, {}}).first;
+    }
+    return it->second;
+}
+
+Moments StatisticsCache::moments(const std::shared_ptr<const BufferBase> &buffer) {
+    std::scoped_lock lock{mutex_};
+    auto &entry = getEntry(buffer);
+    if (!entry.moments) {
+        entry.moments = statsutil::moments(*buffer);
+    }
+    return *entry.moments;
+}
+
+std::vector<double> StatisticsCache::percentiles(const std::shared_ptr<const BufferBase> &buffer,
+                                                 const std::vector<double> &percentiles) {
+    std::scoped_lock lock{mutex_};
+    auto &entry = getEntry(buffer);
+
+    std::vector<double> missing;
+    for (auto p : percentiles) {
+        if (entry.percentiles.find(p) == entry.percentiles.end()) missing.push_back(p);
+    }
+    if (!missing.empty()) {
+        const auto values =
+            buffer->getRepresentation<BufferRAM>()->dispatch<std::vector<double>>([&](auto buf) {
+                const auto &data = buf->getDataContainer();
+                std::vector<double> vec(data.size());
+                std::transform(data.begin(), data.end(), vec.begin(), [](const auto &v) {
+                    return static_cast<double>(util::glmcomp(v, 0));
+                });
+                return statsutil::percentiles(std::move(vec), missing);
+            });
+        for (size_t i = 0; i < missing.size(); ++i) {
+            entry.percentiles[missing[i]] = values[i];
+        }
+    }
+
+    std::vector<double> result;
+    result.reserve(percentiles.size());
+    for (auto p : percentiles) {
+        result.push_back(entry.percentiles[p]);
+    }
+    return result;
+}
+
+RegresionResult StatisticsCache::linearRegresion(const std::shared_ptr<const BufferBase> &x,
+                                                 const std::shared_ptr<const BufferBase> &y) {
+    if (x->getSize() != y->getSize()) {
+        throw Exception("Buffers are not of equal length",
+                        IVW_CONTEXT_CUSTOM("statsutil::StatisticsCache::linearRegresion"));
+    }
+    const auto size = x->getSize();
+    const auto xModification = x->getModificationCount();
+    const auto yModification = y->getModificationCount();
+
+    std::scoped_lock lock{mutex_};
+    const auto key = std::make_pair(x.get(), y.get());
+    auto it = regressions_.find(key);
+    if (it != regressions_.end() && it->second.x.lock() == x && it->second.y.lock() == y &&
+        it->second.size == size && it->second.xModification == xModification &&
+        it->second.yModification == yModification) {
+        return it->second.result;
+    }
+    util::map_erase_remove_if(regressions_, [](const auto &e) {
+        return e.second.x.expired() || e.second.y.expired();
+    });
+    const auto result = statsutil::linearRegresion(*x, *y);
+    regressions_[key] = RegressionEntry{x, y, size, xModification, yModification, result};
+    return result;
+}
+
+void StatisticsCache::invalidate(const BufferBase *buffer) {
+    std::scoped_lock lock{mutex_};
+    entries_.erase(buffer);
+    util::map_erase_remove_if(regressions_, [buffer](const auto &e) {
+        return e.first.first == buffer || e.first.second == buffer;
+    });
+}
+
+void StatisticsCache::clear() {
+    std::scoped_lock lock{mutex_};
+    entries_.clear();
+    regressions_.clear();
+}
+
 }  // namespace statsutil
 
 }  // namespace inviwo
@@ -34,6 +34,8 @@
 
 #include <modules/plotting/utils/statsutils.h>
 
+#include <numeric>
+
 namespace inviwo {
 
 TEST(StatsUtilsTest, init) {
@@ -68,4 +70,75 @@ TEST(StatsUtilsTest, init) {
     EXPECT_DOUBLE_EQ(50., percentiles[4]) << " 100 percentile";
 }
 
+TEST(StatsUtilsTest, percentilesSelection) {
+    std::vector<int> data(1000);
+    std::iota(data.begin(), data.end(), 1);
+    std::reverse(data.begin(), data.end());
+
+    // unordered and duplicated percentiles
+    auto res = statsutil::percentiles(data, {0.75, 0.0, 0.5, 1.0, 0.5, 0.001});
+    EXPECT_EQ(750, res[0]);
+    EXPECT_EQ(1, res[1]);
+    EXPECT_EQ(500, res[2]);
+    EXPECT_EQ(1000, res[3]);
+    EXPECT_EQ(500, res[4]);
+    EXPECT_EQ(1, res[5]);
+
+    auto withNaN = std::vector<double>({std::numeric_limits<double>::quiet_NaN(), 3., 1., 2.,
+                                        std::numeric_limits<double>::quiet_NaN()});
+    auto nanRes = statsutil::percentiles(withNaN, {0.0, 0.5, 1.0});
+    EXPECT_DOUBLE_EQ(1., nanRes[0]);
+    EXPECT_DOUBLE_EQ(2., nanRes[1]);
+    EXPECT_DOUBLE_EQ(3., nanRes[2]);
+}
+
+TEST(StatsUtilsTest, moments) {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    auto buffer = util::makeBuffer<float>({2.f, 4.f, 4.f, 4.f, nan, 5.f, 5.f, 7.f, 9.f});
+    auto m = statsutil::moments(*buffer);
+    EXPECT_EQ(8u, m.count);
+    EXPECT_DOUBLE_EQ(2., m.min);
+    EXPECT_DOUBLE_EQ(9., m.max);
+    EXPECT_DOUBLE_EQ(5., m.mean);
+    EXPECT_DOUBLE_EQ(2., m.standardDeviation());
+
+    statsutil::Moments a, b;
+    for (double v : {2., 4., 4.}) a.add(v);
+    for (double v : {4., 5., 5., 7., 9.}) b.add(v);
+    a.merge(b);
+    EXPECT_EQ(8u, a.count);
+    EXPECT_DOUBLE_EQ(5., a.mean);
+    EXPECT_DOUBLE_EQ(4., a.variance());
+}
+
+TEST(StatsUtilsTest, cache) {
+    std::shared_ptr<const BufferBase> buffer = util::makeBuffer<double>({20., 15., 50., 40., 35.});
+    statsutil::StatisticsCache cache;
+    auto p1 = cache.percentiles(buffer, {0.3, 1.0});
+    auto p2 = cache.percentiles(buffer, {1.0, 0.3, 0.5});
+    EXPECT_DOUBLE_EQ(20., p1[0]);
+    EXPECT_DOUBLE_EQ(50., p1[1]);
+    EXPECT_DOUBLE_EQ(50., p2[0]);
+    EXPECT_DOUBLE_EQ(20., p2[1]);
+    EXPECT_DOUBLE_EQ(35., p2[2]);
+    EXPECT_DOUBLE_EQ(32., cache.moments(buffer).mean);
+}
+
+TEST(StatsUtilsTest, cacheInPlaceEdit) {
+    auto buffer = util::makeBuffer<double>({1., 2., 3., 4.});
+    statsutil::StatisticsCache cache;
+    EXPECT_DOUBLE_EQ(2.5, cache.moments(buffer).mean);
+
+    buffer->getEditableRAMRepresentation()->getDataContainer()[3] = 8.;
+    EXPECT_DOUBLE_EQ(3.5, cache.moments(buffer).mean);
+    EXPECT_DOUBLE_EQ(8., cache.percentiles(buffer, {1.0})[0]);
+}
+
+TEST(StatsUtilsTest, cacheRegressionSizeMismatch) {
+    auto x = util::makeBuffer<double>({1., 2., 3.});
+    auto y = util::makeBuffer<double>({1., 2.});
+    statsutil::StatisticsCache cache;
+    EXPECT_THROW(cache.linearRegresion(x, y), Exception);
+}
+
 }  // namespace inviwo
@@ -47,6 +47,7 @@
 #include <modules/opengl/rendering/texturequadrenderer.h>
 #include <modules/fontrendering/textrenderer.h>
 #include <modules/brushingandlinking/ports/brushingandlinkingports.h>
+#include <modules/plotting/utils/statsutils.h>
 
 namespace inviwo {
 
@@ -113,6 +114,8 @@ private:
     TextRenderer textRenderer_;
     TextureQuadRenderer textureQuadRenderer_;
 
+    statsutil::StatisticsCache statsCache_;  //! Cleared when the input DataFrame changes
+
     EventProperty mouseEvent_;
 
     std::unordered_map<size_t, int> visibleIDToColumnID_;  //! Helper map to convert from ids in
@@ -169,6 +169,7 @@ ScatterPlotMatrixProcessor::ScatterPlotMatrixProcessor()
         plots_.clear();
         labelsTextures_.clear();
         statsTextures_.clear();
+        statsCache_.clear();
     });
 
     parameters_.onChange([&]() {
@@ -319,7 +320,7 @@ void ScatterPlotMatrixProcessor::createStatsLabels() {
             if (!isIncluded(*x)) continue;
             for (auto y = x + 1; y != dataFrame.end(); ++y) {
                 if (!isIncluded(*y)) continue;
-                auto res = statsutil::linearRegresion(*(*x)->getBuffer(), *(*y)->getBuffer());
+                auto res = statsCache_.linearRegresion((*x)->getBuffer(), (*y)->getBuffer());
 
                 std::ostringstream oss;
                 oss << std::setprecision(2) << "corr ρ = " << res.corr << std::endl
@@ -46,6 +46,11 @@ public:
 
 class IVW_MODULE_PNG_API PNGLayerWriter : public DataWriterType<Layer> {
 public:
+    /**
+     * Row filters passed on to libpng, Default lets libpng choose based on the image type.
+     */
+    enum class Filter { Default, None, Sub, Up, Avg, Paeth, All };
+
     PNGLayerWriter();
     PNGLayerWriter(const PNGLayerWriter& rhs) = default;
     PNGLayerWriter& operator=(const PNGLayerWriter& that) = default;
@@ -56,6 +61,20 @@ public:
     virtual std::unique_ptr<std::vector<unsigned char>> writeDataToBuffer(
         const Layer* data, const std::string& fileExtension) const override;
     virtual bool writeDataToRepresentation(const repr* src, repr* dst) const override;
+
+    /**
+     * Set the zlib compression level, 0 (none) to 9 (best). A negative value uses the zlib
+     * default. Lower levels encode considerably faster at the cost of larger files.
+     */
+    void setCompressionLevel(int level);
+    int getCompressionLevel() const;
+
+    void setFilter(Filter filter);
+    Filter getFilter() const;
+
+private:
+    int compressionLevel_ = -1;
+    Filter filter_ = Filter::Default;
 };
 
 }  // namespace inviwo
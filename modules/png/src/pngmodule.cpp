@@ -31,6 +31,7 @@
 #include <inviwo/png/pngreader.h>
 #include <inviwo/png/pngwriter.h>
 #include <inviwo/png/pngutils.h>
+#include <inviwo/png/pngsettings.h>
 
 namespace inviwo {
 
@@ -39,7 +40,18 @@ pngModule::pngModule(InviwoApplication* app) : InviwoModule(app, "png") {
     LogInfo("Using LibPNG Version " << pngutil::getLibPNGVesrion());
 
     registerDataReader(std::make_unique<PNGLayerReader>());
-    registerDataWriter(std::make_unique<PNGLayerWriter>());
+
+    auto settings = std::make_unique<PNGSettings>();
+    auto writer = std::make_unique<PNGLayerWriter>();
+    auto writerPtr = writer.get();
+    settings->configure(*writer);
+    registerDataWriter(std::move(writer));
+
+    // The factory hands out clones of the registered writer, keep it in sync with the settings
+    auto update = [s = settings.get(), writerPtr]() { s->configure(*writerPtr); };
+    settings->compressionLevel_.onChange(update);
+    settings->filter_.onChange(update);
+    registerSettings(std::move(settings));
 }
 
 }  // namespace inviwo
@@ -44,8 +44,26 @@ namespace detail {
 
 void writeToBuffer(png_structp png_ptr, png_bytep data, png_size_t length) {
     auto buffer = static_cast<std::vector<unsigned char>*>(png_get_io_ptr(png_ptr));
-    for (png_size_t i = 0; i < length; i++) {
-        buffer->push_back(static_cast<unsigned char>(data[i]));
+    buffer->insert(buffer->end(), data, data + length);
+}
+
+int toPNGFilters(PNGLayerWriter::Filter filter) {
+    switch (filter) {
+        case PNGLayerWriter::Filter::None:
+            return PNG_FILTER_NONE;
+        case PNGLayerWriter::Filter::Sub:
+            return PNG_FILTER_SUB;
+        case PNGLayerWriter::Filter::Up:
+            return PNG_FILTER_UP;
+        case PNGLayerWriter::Filter::Avg:
+            return PNG_FILTER_AVG;
+        case PNGLayerWriter::Filter::Paeth:
+            return PNG_FILTER_PAETH;
+        case PNGLayerWriter::Filter::All:
+            return PNG_ALL_FILTERS;
+        case PNGLayerWriter::Filter::Default:
+        default:
+            return -1;
     }
 }
 
@@ -82,8 +100,8 @@ auto convertToUnsigned(const T*, const size_t, const T, const T) -> std::vector<
 }
 
 template <typename T>
-void write(const LayerRAMPrecision<T>* ram, png_voidp ioPtr, png_rw_ptr writeFunc = nullptr,
-           png_flush_ptr flushFunc = nullptr) {
+void write(const LayerRAMPrecision<T>* ram, int compressionLevel, PNGLayerWriter::Filter filter,
+           png_voidp ioPtr, png_rw_ptr writeFunc = nullptr, png_flush_ptr flushFunc = nullptr) {
 
     // TODO better exception messages
     auto png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -108,6 +126,13 @@ void write(const LayerRAMPrecision<T>* ram, png_voidp ioPtr, png_rw_ptr writeFun
 
     png_set_write_fn(png_ptr, ioPtr, writeFunc, flushFunc);
 
+    if (compressionLevel >= 0) {
+        png_set_compression_level(png_ptr, std::min(compressionLevel, 9));
+    }
+    if (const auto filters = toPNGFilters(filter); filters >= 0) {
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filters);
+    }
+
     const auto df = ram->getDataFormat();
     const auto color_type = [&]() {
         switch (df->getComponents()) {
@@ -185,13 +210,21 @@ PNGLayerWriter::PNGLayerWriter() : DataWriterType<Layer>() {
 
 PNGLayerWriter* PNGLayerWriter::clone() const { return new PNGLayerWriter(*this); }
 
+void PNGLayerWriter::setCompressionLevel(int level) { compressionLevel_ = level; }
+
+int PNGLayerWriter::getCompressionLevel() const { return compressionLevel_; }
+
+void PNGLayerWriter::setFilter(Filter filter) { filter_ = filter; }
+
+PNGLayerWriter::Filter PNGLayerWriter::getFilter() const { return filter_; }
+
 void PNGLayerWriter::writeData(const Layer* data, const std::string filePath) const {
     data->getRepresentation<LayerRAM>()->dispatch<void>([&](auto ram) {
         FILE* fp = filesystem::fopen(filePath, "wb");
         if (!fp) throw PNGLayerWriterException("Failed to open file for writing, " + filePath);
         util::OnScopeExit closeFile([&fp]() { fclose(fp); });
 
-        detail::write(ram, static_cast<png_voidp>(fp));
+        detail::write(ram, compressionLevel_, filter_, static_cast<png_voidp>(fp));
     });
 }
 
@@ -200,7 +233,8 @@ std::unique_ptr<std::vector<unsigned char>> PNGLayerWriter::writeDataToBuffer(
 
     auto buffer = std::make_unique<std::vector<unsigned char>>();
     data->getRepresentation<LayerRAM>()->dispatch<void>([&](auto ram) {
-        detail::write(ram, static_cast<png_voidp>(buffer.get()), &detail::writeToBuffer);
+        detail::write(ram, compressionLevel_, filter_, static_cast<png_voidp>(buffer.get()),
+                      &detail::writeToBuffer);
     });
 
     return buffer;
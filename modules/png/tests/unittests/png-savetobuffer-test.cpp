@@ -45,6 +45,7 @@
 
 #include <inviwo/png/pngreader.h>
 #include <inviwo/png/pngwriter.h>
+#include <inviwo/core/datastructures/image/layerram.h>
 
 #include <fstream>
 #include <array>
@@ -92,4 +93,39 @@ TEST(CImgUtils, cimgToBuffer) {
     EXPECT_EQ(*imgBuffer.get(), fileContents) << "buffer and file contents do not match";
 }
 
+TEST(PNGWriter, compressionLevel) {
+    const auto filename = filesystem::getPath(PathType::Tests, "/images/swirl.png");
+    PNGLayerReader reader;
+    auto layer = reader.readData(filename);
+
+    PNGLayerWriter writer;
+    writer.setFilter(PNGLayerWriter::Filter::None);
+    writer.setCompressionLevel(0);
+    auto uncompressed = writer.writeDataToBuffer(layer.get(), "png");
+    writer.setFilter(PNGLayerWriter::Filter::All);
+    writer.setCompressionLevel(9);
+    auto compressed = writer.writeDataToBuffer(layer.get(), "png");
+
+    ASSERT_TRUE(uncompressed != nullptr);
+    ASSERT_TRUE(compressed != nullptr);
+    EXPECT_GT(uncompressed->size(), compressed->size());
+
+    // The compressed file should decode to the same image
+    util::TempFileHandle tmpFile("png", ".png");
+    {
+        auto out = filesystem::ofstream(tmpFile.getFileName(), std::ios::out | std::ios::binary);
+        out.write(reinterpret_cast<const char*>(compressed->data()), compressed->size());
+    }
+    auto roundtrip = reader.readData(tmpFile.getFileName());
+    ASSERT_EQ(layer->getDimensions(), roundtrip->getDimensions());
+    ASSERT_EQ(layer->getDataFormat(), roundtrip->getDataFormat());
+
+    const auto src = layer->getRepresentation<LayerRAM>();
+    const auto dst = roundtrip->getRepresentation<LayerRAM>();
+    const auto bytes = glm::compMul(layer->getDimensions()) * src->getDataFormat()->getSize();
+    EXPECT_TRUE(std::equal(static_cast<const unsigned char*>(src->getData()),
+                           static_cast<const unsigned char*>(src->getData()) + bytes,
+                           static_cast<const unsigned char*>(dst->getData())));
+}
+
 }  // namespace inviwo
@@ -116,15 +116,18 @@ void RBFVectorFieldGenerator3D::process() {
 
     if (mesh_.isConnected()) {
         auto mesh = std::make_shared<BasicMesh>();
+        std::vector<std::shared_ptr<BasicMesh>> glyphs;
+        glyphs.reserve(2 * samples.size());
         for (auto &p : samples) {
             vec3 p0 = vec3(p.first);
             vec3 p1 = p0 + glm::normalize(vec3(p.second)) * arrowLength_.get();
-            auto sphere = meshutil::colorsphere(p0, sphereRadius_.get());
-            auto arrow = meshutil::arrow(p0, p1, arrowColor_.get(), sphereRadius_.get() * 0.5f,
-                                         0.15f, sphereRadius_.get());
-            mesh->append(sphere.get());
-            mesh->append(arrow.get());
+            glyphs.push_back(meshutil::colorsphere(p0, sphereRadius_.get()));
+            glyphs.push_back(meshutil::arrow(p0, p1, arrowColor_.get(),
+                                             sphereRadius_.get() * 0.5f, 0.15f,
+                                             sphereRadius_.get()));
         }
+        mesh->Mesh::append(util::transform(
+            glyphs, [](const auto &glyph) -> const Mesh * { return glyph.get(); }));
         mesh_.setData(mesh);
     }
 
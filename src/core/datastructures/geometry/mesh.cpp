@@ -28,10 +28,15 @@
  *********************************************************************************/
 
 #include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/util/document.h>
+#include <inviwo/core/util/foreach.h>
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace inviwo {
 
 Mesh::Mesh(DrawType dt, ConnectivityType ct) : Mesh{MeshInfo{dt, ct}} {}
@@ -326,29 +331,108 @@ size_t Mesh::getNumberOfBuffers() const { return buffers_.size(); }
 
 size_t Mesh::getNumberOfIndicies() const { return indices_.size(); }
 
-void Mesh::append(const Mesh& mesh) {
-    if (buffers_.size() != mesh.buffers_.size()) {
-        throw Exception("Mismatched meshed, number of buffer does not match", IVW_CONTEXT);
+namespace {
+
+/**
+ * Calls callback(segment, first, last) in parallel for consecutive parts [first, last) of the
+ * segments given by offsets, where segment i covers [offsets[i], offsets[i + 1]).
+ */
+template <typename Callback>
+void forEachSegmentParallel(const std::vector<size_t>& offsets, Callback&& callback) {
+    if (offsets.back() == 0) return;
+    util::forEachRangeParallel(offsets.back(), [&](size_t first, size_t last) {
+        auto segment =
+            static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), first) -
+                                offsets.begin()) -
+            1;
+        while (first < last) {
+            const auto end = std::min(last, offsets[segment + 1]);
+            if (first < end) callback(segment, first, end);
+            first = end;
+            ++segment;
+        }
+    });
+}
+
+}  // namespace
+
+void Mesh::append(const Mesh& mesh) { append(std::vector<const Mesh*>{&mesh}); }
+
+void Mesh::append(const std::vector<const Mesh*>& meshes) {
+    for (auto mesh : meshes) {
+        if (buffers_.size() != mesh->buffers_.size()) {
+            throw Exception("Mismatched meshed, number of buffer does not match", IVW_CONTEXT);
+        }
+        for (size_t i = 0; i < buffers_.size(); ++i) {
+            if (buffers_[i].first != mesh->buffers_[i].first ||
+                buffers_[i].second->getDataFormat() != mesh->buffers_[i].second->getDataFormat()) {
+                throw Exception("Mismatched meshed, buffer types does not match", IVW_CONTEXT);
+            }
+        }
     }
+    if (meshes.empty()) return;
+
+    // The offset added to the indices of each mesh
+    std::vector<std::uint32_t> indexOffsets;
+    indexOffsets.reserve(meshes.size());
+    size_t numVertices = buffers_.empty() ? 0 : buffers_[0].second->getSize();
+    for (auto mesh : meshes) {
+        indexOffsets.push_back(static_cast<std::uint32_t>(numVertices));
+        numVertices += mesh->buffers_.empty() ? 0 : mesh->buffers_[0].second->getSize();
+    }
+
     for (size_t i = 0; i < buffers_.size(); ++i) {
-        if (buffers_[i].first != mesh.buffers_[i].first ||
-            buffers_[i].second->getDataFormat() != mesh.buffers_[i].second->getDataFormat()) {
-            throw Exception("Mismatched meshed, buffer types does not match", IVW_CONTEXT);
+        // Get all representations before resizing since appending a mesh to itself is allowed
+        std::vector<const BufferRAM*> sources;
+        std::vector<size_t> offsets{0};
+        sources.reserve(meshes.size());
+        offsets.reserve(meshes.size() + 1);
+        for (auto mesh : meshes) {
+            sources.push_back(mesh->buffers_[i].second->getRepresentation<BufferRAM>());
+            offsets.push_back(offsets.back() + sources.back()->getSize());
         }
+
+        auto dest = buffers_[i].second->getEditableRepresentation<BufferRAM>();
+        const auto size = dest->getSize();
+        const auto elementSize = dest->getSizeOfElement();
+        dest->setSize(size + offsets.back());
+        auto destData = static_cast<char*>(dest->getData());
+
+        forEachSegmentParallel(offsets, [&](size_t mesh, size_t first, size_t last) {
+            const auto srcData = static_cast<const char*>(sources[mesh]->getData());
+            std::memcpy(destData + (size + first) * elementSize,
+                        srcData + (first - offsets[mesh]) * elementSize,
+                        (last - first) * elementSize);
+        });
     }
-    size_t size = buffers_[0].second->getSize();
-    for (size_t i = 0; i < buffers_.size(); ++i) {
-        buffers_[i].second->append(*(mesh.buffers_[i].second));
+
+    std::vector<const std::vector<std::uint32_t>*> sources;
+    std::vector<std::uint32_t> sourceOffsets;
+    std::vector<MeshInfo> sourceInfos;
+    std::vector<size_t> offsets{0};
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        for (const auto& [info, buffer] : meshes[i]->indices_) {
+            sources.push_back(&buffer->getRAMRepresentation()->getDataContainer());
+            sourceOffsets.push_back(indexOffsets[i]);
+            sourceInfos.push_back(info);
+            offsets.push_back(offsets.back() + sources.back()->size());
+        }
     }
-    for (auto indbuffer : mesh.indices_) {
-        const auto& inds = indbuffer.second->getRAMRepresentation()->getDataContainer();
-
-        std::vector<std::uint32_t> newInds;
-        newInds.reserve(inds.size());
-        std::transform(inds.begin(), inds.end(), std::back_inserter(newInds),
-                       [&](auto& i) { return i + static_cast<uint32_t>(size); });
-        addIndices(indbuffer.first, util::makeIndexBuffer(std::move(newInds)));
+
+    std::vector<std::uint32_t*> dests;
+    dests.reserve(sources.size());
+    indices_.reserve(indices_.size() + sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        auto buffer = util::makeIndexBuffer(std::vector<std::uint32_t>(sources[i]->size()));
+        dests.push_back(buffer->getEditableRAMRepresentation()->getDataContainer().data());
+        addIndices(sourceInfos[i], buffer);
     }
+
+    forEachSegmentParallel(offsets, [&](size_t buffer, size_t first, size_t last) {
+        const auto begin = sources[buffer]->begin() + (first - offsets[buffer]);
+        std::transform(begin, begin + (last - first), dests[buffer] + (first - offsets[buffer]),
+                       [offset = sourceOffsets[buffer]](std::uint32_t i) { return i + offset; });
+    });
 }
 
 const SpatialCameraCoordinateTransformer<3>& Mesh::getCoordinateTransformer(
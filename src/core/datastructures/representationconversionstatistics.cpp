@@ -0,0 +1,104 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/representationconversionstatistics.h>
+#include <inviwo/core/util/formatconversion.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+namespace inviwo {
+
+void ConversionStatistics::add(size_t nbytes, std::chrono::nanoseconds duration) {
+    ++count;
+    bytes += nbytes;
+    time += duration;
+}
+
+ConversionStatistics& ConversionStatistics::operator+=(const ConversionStatistics& rhs) {
+    count += rhs.count;
+    bytes += rhs.bytes;
+    time += rhs.time;
+    return *this;
+}
+
+double ConversionStatistics::nanosecondsPerByte() const {
+    if (count == 0) return 0.0;
+    return static_cast<double>(time.count()) / static_cast<double>(std::max(bytes, count));
+}
+
+namespace {
+
+using Entry = ConversionStatisticsMap::value_type;
+
+std::vector<const Entry*> sortedByTime(const ConversionStatisticsMap& statistics) {
+    std::vector<const Entry*> entries;
+    entries.reserve(statistics.size());
+    for (auto& item : statistics) entries.push_back(&item);
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry* a, const Entry* b) { return a->second.time > b->second.time; });
+    return entries;
+}
+
+std::string reprName(std::type_index type) { return parseTypeIdName(type.name()); }
+
+double toMilliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+}  // namespace
+
+void util::writeConversionStatisticsCSV(std::ostream& os,
+                                        const ConversionStatisticsMap& statistics) {
+    os << "From,To,Count,Bytes,Time (ms),ns/byte\n";
+    for (auto entry : sortedByTime(statistics)) {
+        const auto& stats = entry->second;
+        os << reprName(entry->first.first) << ',' << reprName(entry->first.second) << ','
+           << stats.count << ',' << stats.bytes << ',' << toMilliseconds(stats.time) << ','
+           << stats.nanosecondsPerByte() << '\n';
+    }
+}
+
+void util::logConversionStatistics(const ConversionStatisticsMap& statistics, LogLevel level) {
+    std::ostringstream ss;
+    ss << "Representation conversions:";
+    for (auto entry : sortedByTime(statistics)) {
+        const auto& stats = entry->second;
+        ss << "\n  " << reprName(entry->first.first) << " -> " << reprName(entry->first.second)
+           << ": " << stats.count << " conversions, " << formatBytesToString(stats.bytes) << ", "
+           << std::fixed << std::setprecision(2) << toMilliseconds(stats.time) << " ms";
+    }
+    LogCustomSpecial(LogCentral::getPtr(), level, "RepresentationConverter", ss.str());
+}
+
+}  // namespace inviwo
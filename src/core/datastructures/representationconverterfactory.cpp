@@ -0,0 +1,66 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/representationconverterfactory.h>
+
+namespace inviwo {
+
+void BaseRepresentationConverterFactory::recordConversion(ConverterID id, size_t bytes,
+                                                          std::chrono::nanoseconds time) {
+    std::unique_lock<std::mutex> lock(statisticsMutex_);
+    auto& stats = statistics_[id];
+    stats.add(bytes, time);
+    if (stats.count == 1) ++costGeneration_;
+}
+
+ConversionStatisticsMap BaseRepresentationConverterFactory::getConversionStatistics() const {
+    std::unique_lock<std::mutex> lock(statisticsMutex_);
+    return statistics_;
+}
+
+void BaseRepresentationConverterFactory::resetConversionStatistics() {
+    std::unique_lock<std::mutex> lock(statisticsMutex_);
+    statistics_.clear();
+    ++costGeneration_;
+}
+
+double BaseRepresentationConverterFactory::getConversionCost(ConverterID id) const {
+    std::unique_lock<std::mutex> lock(statisticsMutex_);
+    auto it = statistics_.find(id);
+    if (it != statistics_.end()) return it->second.nanosecondsPerByte();
+
+    if (statistics_.empty()) return 1.0;
+    double sum = 0.0;
+    for (auto& item : statistics_) sum += item.second.nanosecondsPerByte();
+    return sum / static_cast<double>(statistics_.size());
+}
+
+size_t BaseRepresentationConverterFactory::getCostGeneration() const { return costGeneration_; }
+
+}  // namespace inviwo
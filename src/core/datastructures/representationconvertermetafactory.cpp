@@ -46,4 +46,18 @@ bool RepresentationConverterMetaFactory::unRegisterObject(
     return removed > 0;
 }
 
+ConversionStatisticsMap RepresentationConverterMetaFactory::getConversionStatistics() const {
+    ConversionStatisticsMap statistics;
+    for (auto& item : map_) {
+        for (auto& stats : item.second->getConversionStatistics()) {
+            statistics[stats.first] += stats.second;
+        }
+    }
+    return statistics;
+}
+
+void RepresentationConverterMetaFactory::resetConversionStatistics() {
+    for (auto& item : map_) item.second->resetConversionStatistics();
+}
+
 }  // namespace inviwo
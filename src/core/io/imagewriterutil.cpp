@@ -36,30 +36,48 @@
 #include <inviwo/core/io/datawriter.h>
 #include <inviwo/core/io/datawriterexception.h>
 #include <inviwo/core/io/datawriterfactory.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 
 namespace inviwo {
 
 namespace util {
 
-void saveLayer(const Layer& layer, const std::string& path, const FileExtension& extension) {
+namespace {
+
+/**
+ * Find a writer for the extension, falling back to the extension of path.
+ * Returns the writer together with the extension it was selected for.
+ */
+std::pair<std::shared_ptr<DataWriterType<Layer>>, std::string> findLayerWriter(
+    const std::string& path, const FileExtension& extension) {
     auto factory = InviwoApplication::getPtr()->getDataWriterFactory();
 
     auto writer = std::shared_ptr<DataWriterType<Layer>>(
         factory->getWriterForTypeAndExtension<Layer>(extension));
+    if (writer) return {writer, extension.extension_};
 
+    // could not find a reader for the given extension, extension might be invalid
+    // try to get reader for the extension extracted from the file name, i.e. path
+    const auto ext = filesystem::getFileExtension(path);
+    writer = std::shared_ptr<DataWriterType<Layer>>(
+        factory->getWriterForTypeAndExtension<Layer>(ext));
     if (!writer) {
-        // could not find a reader for the given extension, extension might be invalid
-        // try to get reader for the extension extracted from the file name, i.e. path
-        const auto ext = filesystem::getFileExtension(path);
-        writer = std::shared_ptr<DataWriterType<Layer>>(
-            factory->getWriterForTypeAndExtension<Layer>(ext));
-        if (!writer) {
-            LogInfoCustom(
-                "ImageWriterUtil",
-                "Could not find a writer for the specified file extension (\"" << ext << "\")");
-            return;
-        }
+        LogInfoCustom("ImageWriterUtil",
+                      "Could not find a writer for the specified file extension (\"" << ext
+                                                                                      << "\")");
     }
+    return {writer, ext};
+}
+
+}  // namespace
+
+void saveLayer(const Layer& layer, const std::string& path, const FileExtension& extension) {
+    auto writer = findLayerWriter(path, extension).first;
+    if (!writer) return;
 
     try {
         writer->setOverwrite(true);
@@ -90,6 +108,128 @@ void saveLayer(const Layer& layer) {
     }
 }
 
+struct LayerExportQueue::State {
+    struct Item {
+        std::string path;
+        std::string ext;
+        std::shared_ptr<DataWriterType<Layer>> writer;
+        std::unique_ptr<Layer> layer;
+        std::unique_ptr<std::vector<unsigned char>> buffer;
+        bool encoded = false;
+        bool failed = false;
+    };
+
+    explicit State(size_t maxItems) : maxInFlight{maxItems} {}
+
+    void encode(Item& item) {
+        try {
+            item.buffer = item.writer->writeDataToBuffer(item.layer.get(), item.ext);
+        } catch (const Exception& e) {
+            LogErrorCustom("ImageWriterUtil", e.getMessage());
+            item.failed = true;
+        } catch (const std::exception& e) {
+            LogErrorCustom("ImageWriterUtil", e.what());
+            item.failed = true;
+        }
+        {
+            std::scoped_lock lock{mutex};
+            item.encoded = true;
+        }
+        flush();
+    }
+
+    // Only one thread at a time writes, and always the front item, to keep the files in order
+    void flush() {
+        std::unique_lock lock{mutex};
+        if (writing) return;
+        writing = true;
+        while (!items.empty() && items.front()->encoded) {
+            auto item = items.front();
+            lock.unlock();
+            write(*item);
+            lock.lock();
+            items.pop_front();
+            cond.notify_all();
+        }
+        writing = false;
+    }
+
+    void write(Item& item) {
+        if (item.failed) return;
+        try {
+            if (item.buffer) {
+                auto out = filesystem::ofstream(item.path, std::ios::out | std::ios::binary);
+                if (!out) {
+                    throw DataWriterException("Could not open file: " + item.path,
+                                              IVW_CONTEXT_CUSTOM("ImageWriterUtil"));
+                }
+                out.write(reinterpret_cast<const char*>(item.buffer->data()),
+                          static_cast<std::streamsize>(item.buffer->size()));
+                if (!out) {
+                    throw DataWriterException("Could not write file: " + item.path,
+                                              IVW_CONTEXT_CUSTOM("ImageWriterUtil"));
+                }
+            } else {
+                // Writer does not support buffers
+                item.writer->writeData(item.layer.get(), item.path);
+            }
+            LogInfoCustom("ImageWriterUtil", "Canvas layer exported to disk: " << item.path);
+        } catch (const Exception& e) {
+            LogErrorCustom("ImageWriterUtil", e.getMessage());
+        } catch (const std::exception& e) {
+            LogErrorCustom("ImageWriterUtil", e.what());
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::shared_ptr<Item>> items;
+    size_t maxInFlight;
+    bool writing = false;
+};
+
+LayerExportQueue::LayerExportQueue(size_t maxInFlight)
+    : state_{std::make_shared<State>(
+          maxInFlight > 0 ? maxInFlight : InviwoApplication::getPtr()->getPoolSize() + 1)} {}
+
+LayerExportQueue::~LayerExportQueue() { wait(); }
+
+void LayerExportQueue::enqueue(const Layer& layer, const std::string& path,
+                               const FileExtension& extension) {
+    auto [writer, ext] = findLayerWriter(path, extension);
+    if (!writer) return;
+    writer->setOverwrite(true);
+
+    {
+        std::unique_lock lock{state_->mutex};
+        state_->cond.wait(lock, [&]() { return state_->items.size() < state_->maxInFlight; });
+    }
+
+    // Download on the calling thread, the pool threads must not touch any GL representations
+    auto item = std::make_shared<State::Item>();
+    item->path = path;
+    item->ext = ext;
+    item->writer = std::move(writer);
+    item->layer = std::make_unique<Layer>(
+        std::shared_ptr<LayerRepresentation>(layer.getRepresentation<LayerRAM>()->clone()));
+
+    {
+        std::scoped_lock lock{state_->mutex};
+        state_->items.push_back(item);
+    }
+    dispatchPool([state = state_, item]() { state->encode(*item); });
+}
+
+void LayerExportQueue::wait() {
+    std::unique_lock lock{state_->mutex};
+    state_->cond.wait(lock, [&]() { return state_->items.empty(); });
+}
+
+size_t LayerExportQueue::size() const {
+    std::scoped_lock lock{state_->mutex};
+    return state_->items.size();
+}
+
 }  // namespace util
 
 }  // namespace inviwo
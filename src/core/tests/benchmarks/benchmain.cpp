@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/logcentral.h>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+class CountingLogger : public Logger {
+public:
+    virtual void log(std::string, LogLevel, LogAudience, const char*, const char*, int,
+                     std::string msg) override {
+        count += msg.size() > 0 ? 1 : 0;
+    }
+    std::atomic<size_t> count{0};
+};
+
+struct Source {
+    void log(int i) { LogInfo("Message number " << i); }
+};
+
+}  // namespace
+
+// Logging throughput from state.threads threads, state.range(0) selects asynchronous dispatching
+static void Logging(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        LogCentral::getPtr()->setAsynchronous(state.range(0) != 0);
+    }
+
+    Source source;
+    int i = 0;
+    for (auto _ : state) {
+        source.log(i++);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index == 0) {
+        LogCentral::getPtr()->flush();
+        LogCentral::getPtr()->setAsynchronous(false);
+    }
+}
+
+BENCHMARK(Logging)->Arg(0)->Arg(1)->ThreadRange(1, 16)->UseRealTime();
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    auto logger = std::make_shared<CountingLogger>();
+    LogCentral::getPtr()->registerLogger(logger);
+    // large enough to not drop messages when the consumer falls behind briefly
+    LogCentral::getPtr()->setQueueCapacity(1 << 14);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    LogCentral::deleteInstance();
+    return 0;
+}
+
+#include <warn/pop>
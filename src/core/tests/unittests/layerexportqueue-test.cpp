@@ -0,0 +1,136 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/io/datawriter.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/io/datawriterfactory.h>
+#include <inviwo/core/io/imagewriterutil.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * Writes the width of the layer as text. Layers with a width divisible by 3 fail to encode, and
+ * layers with a width divisible by 5 are not encoded to a buffer but written directly. Narrower
+ * layers take longer to encode, such that later layers tend to finish encoding first.
+ */
+class TestLayerWriter : public DataWriterType<Layer> {
+public:
+    TestLayerWriter() { addExtension(FileExtension("ivwtestlayer", "Test layer")); }
+    virtual TestLayerWriter* clone() const override { return new TestLayerWriter(*this); }
+
+    virtual void writeData(const Layer* layer, const std::string filePath) const override {
+        auto file = filesystem::ofstream(filePath);
+        file << "direct " << layer->getDimensions().x;
+    }
+
+    virtual std::unique_ptr<std::vector<unsigned char>> writeDataToBuffer(
+        const Layer* layer, const std::string&) const override {
+        const auto width = layer->getDimensions().x;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * (20 - width % 20)));
+        if (width % 3 == 0) {
+            throw DataWriterException("Encoding failed", IVW_CONTEXT);
+        }
+        if (width % 5 == 0) return nullptr;
+        const auto str = std::to_string(width);
+        return std::make_unique<std::vector<unsigned char>>(str.begin(), str.end());
+    }
+};
+
+std::string readFile(const std::string& path) {
+    auto file = filesystem::ifstream(path);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+}  // namespace
+
+TEST(LayerExportQueue, orderAndFailures) {
+    TestLayerWriter writer;
+    auto factory = InviwoApplication::getPtr()->getDataWriterFactory();
+    ASSERT_TRUE(factory->registerObject(&writer));
+
+    const auto dir = std::filesystem::temp_directory_path() / "inviwo-layerexportqueue-test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto path = [&](size_t width) {
+        return (dir / ("layer" + std::to_string(width) + ".ivwtestlayer")).string();
+    };
+
+    constexpr size_t maxInFlight = 2;
+    constexpr size_t layers = 16;
+    {
+        util::LayerExportQueue queue(maxInFlight);
+        for (size_t width = 1; width <= layers; ++width) {
+            queue.enqueue(Layer(size2_t(width, 1)), path(width));
+            EXPECT_LE(queue.size(), maxInFlight);
+
+            // Files are written in order, whenever a file exists all earlier ones that did not
+            // fail have been written. Check the later files first, they are written last.
+            bool written = false;
+            for (size_t i = width; i >= 1; --i) {
+                const bool exists = filesystem::fileExists(path(i));
+                if (written && i % 3 != 0) EXPECT_TRUE(exists) << path(i);
+                written = written || exists;
+            }
+        }
+        // failed encodes must not block waiting for the queue
+        queue.wait();
+        EXPECT_EQ(0u, queue.size());
+    }
+
+    for (size_t width = 1; width <= layers; ++width) {
+        if (width % 3 == 0) {
+            EXPECT_FALSE(filesystem::fileExists(path(width)));
+        } else if (width % 5 == 0) {
+            EXPECT_EQ("direct " + std::to_string(width), readFile(path(width)));
+        } else {
+            EXPECT_EQ(std::to_string(width), readFile(path(width)));
+        }
+    }
+
+    factory->unRegisterObject(&writer);
+    std::filesystem::remove_all(dir);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(RAMAccessTests, VolumeReadRegion) {
+    VolumeRAMPrecision<unsigned char> vol(size3_t{4, 3, 2});
+    auto data = vol.getDataTyped();
+    std::iota(data, data + 4 * 3 * 2, static_cast<unsigned char>(0));
+
+    const size3_t offset{1, 1, 0};
+    const size3_t extent{2, 2, 2};
+    std::vector<double> plain(8);
+    std::vector<double> normalized(8);
+    vol.readRegion(offset, extent, plain.data());
+    vol.readRegion(offset, extent, normalized.data(), util::ValueConversion::Normalized);
+
+    size_t i = 0;
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            for (size_t x = 0; x < extent.x; ++x, ++i) {
+                const auto pos = offset + size3_t{x, y, z};
+                EXPECT_EQ(vol.getAsDouble(pos), plain[i]) << pos;
+                EXPECT_EQ(vol.getAsNormalizedDouble(pos), normalized[i]) << pos;
+            }
+        }
+    }
+
+    EXPECT_THROW(vol.readRegion(size3_t{3, 0, 0}, size3_t{2, 1, 1}, plain.data()),
+                 RangeException);
+}
+
+TEST(RAMAccessTests, VolumeWriteRegion) {
+    VolumeRAMPrecision<vec2> vol(size3_t{3, 3, 3});
+    std::fill(vol.getDataTyped(), vol.getDataTyped() + 27, vec2{0.0f});
+
+    const std::vector<dvec3> src{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    vol.writeRegion(size3_t{1, 2, 2}, size3_t{2, 1, 1}, src.data());
+
+    EXPECT_EQ(dvec2(1.0, 2.0), vol.getAsDVec2(size3_t{1, 2, 2}));
+    EXPECT_EQ(dvec2(4.0, 5.0), vol.getAsDVec2(size3_t{2, 2, 2}));
+    EXPECT_EQ(dvec2(0.0, 0.0), vol.getAsDVec2(size3_t{0, 2, 2}));
+}
+
+TEST(RAMAccessTests, VolumeIndices) {
+    VolumeRAMPrecision<int> vol(size3_t{5, 4, 3});
+    auto data = vol.getDataTyped();
+    std::iota(data, data + 5 * 4 * 3, -30);
+
+    const std::vector<size_t> indices{0, 59, 17, 17, 33};
+    std::vector<dvec2> values(indices.size());
+    vol.readIndices(indices.data(), indices.size(), values.data());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        EXPECT_EQ(dvec2(data[indices[i]], 0.0), values[i]);
+    }
+
+    const std::vector<float> src{1.5f, 2.5f, 3.5f};
+    const std::vector<size_t> dest{4, 8, 15};
+    vol.writeIndices(dest.data(), dest.size(), src.data());
+    EXPECT_EQ(1, data[4]);
+    EXPECT_EQ(2, data[8]);
+    EXPECT_EQ(3, data[15]);
+}
+
+TEST(RAMAccessTests, LayerRegionAndIndices) {
+    LayerRAMPrecision<glm::u16vec2> layer(size2_t{6, 4});
+    auto data = layer.getDataTyped();
+    for (size_t i = 0; i < 6 * 4; ++i) {
+        data[i] = glm::u16vec2(static_cast<std::uint16_t>(1000 * i), 7);
+    }
+
+    const size2_t offset{2, 1};
+    const size2_t extent{3, 3};
+    std::vector<float> values(9);
+    layer.readRegion(offset, extent, values.data(), util::ValueConversion::Normalized);
+    size_t i = 0;
+    for (size_t y = 0; y < extent.y; ++y) {
+        for (size_t x = 0; x < extent.x; ++x, ++i) {
+            const auto pos = offset + size2_t{x, y};
+            EXPECT_FLOAT_EQ(static_cast<float>(layer.getAsNormalizedDouble(pos)), values[i]);
+        }
+    }
+    EXPECT_THROW(layer.readRegion(size2_t{0, 2}, size2_t{1, 3}, values.data()), RangeException);
+
+    const std::vector<size_t> indices{23, 0};
+    const std::vector<uvec2> src{{1, 2}, {3, 4}};
+    layer.writeIndices(indices.data(), indices.size(), src.data());
+    EXPECT_EQ(glm::u16vec2(1, 2), data[23]);
+    EXPECT_EQ(glm::u16vec2(3, 4), data[0]);
+
+    std::vector<uvec2> read(indices.size());
+    layer.readIndices(indices.data(), indices.size(), read.data());
+    EXPECT_EQ(src, read);
+}
+
+}  // namespace inviwo
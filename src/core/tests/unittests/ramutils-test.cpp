@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/volumeramutils.h>
+#include <inviwo/core/util/imageramutils.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace inviwo {
+
+TEST(RAMUtilsTests, ForEachVoxelParallelVisitsAllOnce) {
+    const size3_t dims{37, 5, 19};
+    const util::IndexMapper3D im(dims);
+    std::vector<int> visits(dims.x * dims.y * dims.z, 0);
+    util::forEachVoxelParallel(dims, [&](const size3_t& pos) { ++visits[im(pos)]; },
+                               size3_t{8, 4, 3});
+    for (auto v : visits) EXPECT_EQ(1, v);
+}
+
+TEST(RAMUtilsTests, ForEachVoxelParallelReduce) {
+    const size3_t dims{33, 17, 9};
+    const auto sum = util::forEachVoxelParallelReduce(
+        dims, size_t{0}, [](const size3_t& pos, size_t& res) { res += pos.x + pos.y + pos.z; },
+        [](size_t a, size_t b) { return a + b; });
+
+    size_t expected = 0;
+    util::forEachVoxel(dims, [&](const size3_t& pos) { expected += pos.x + pos.y + pos.z; });
+    EXPECT_EQ(expected, sum);
+}
+
+TEST(RAMUtilsTests, ForEachPixelParallelVisitsAllOnce) {
+    const size2_t dims{1000, 3};
+    const util::IndexMapper2D im(dims);
+    std::vector<int> visits(dims.x * dims.y, 0);
+    util::forEachPixelParallel(dims, [&](const size2_t& pos) { ++visits[im(pos)]; });
+    for (auto v : visits) EXPECT_EQ(1, v);
+
+    const auto max = util::forEachPixelParallelReduce(
+        dims, size_t{0}, [&](const size2_t& pos, size_t& res) { res = std::max(res, im(pos)); },
+        [](size_t a, size_t b) { return std::max(a, b); }, size2_t{7, 2});
+    EXPECT_EQ(dims.x * dims.y - 1, max);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,128 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/representationconverterfactory.h>
+
+#include <sstream>
+#include <string>
+
+namespace inviwo {
+
+namespace {
+
+struct TestRepr {
+    virtual ~TestRepr() = default;
+};
+struct ReprA : TestRepr {};
+struct ReprB : TestRepr {};
+struct ReprC : TestRepr {};
+
+template <typename From, typename To>
+class TestConverter : public RepresentationConverterType<TestRepr, From, To> {
+public:
+    virtual std::shared_ptr<To> createFrom(std::shared_ptr<const From>) const override {
+        return std::make_shared<To>();
+    }
+    virtual void update(std::shared_ptr<const From>, std::shared_ptr<To>) const override {}
+};
+
+}  // namespace
+
+TEST(RepresentationConverterFactoryTests, CheapestPath) {
+    using namespace std::chrono_literals;
+
+    RepresentationConverterFactory<TestRepr> factory;
+    TestConverter<ReprA, ReprB> ab;
+    TestConverter<ReprB, ReprC> bc;
+    TestConverter<ReprA, ReprC> ac;
+    factory.registerObject(&ab);
+    factory.registerObject(&bc);
+    factory.registerObject(&ac);
+
+    // Without any measurements the path with fewest steps wins
+    auto direct = factory.getRepresentationConverter(typeid(ReprA), typeid(ReprC));
+    ASSERT_NE(nullptr, direct);
+    EXPECT_EQ(1, direct->steps());
+
+    factory.recordConversion(ac.getConverterID(), 1000, 100000ns);
+    factory.recordConversion(ab.getConverterID(), 1000, 1000ns);
+    factory.recordConversion(bc.getConverterID(), 1000, 2000ns);
+    EXPECT_DOUBLE_EQ(100.0, factory.getConversionCost(ac.getConverterID()));
+    EXPECT_DOUBLE_EQ(2.0, factory.getConversionCost(bc.getConverterID()));
+
+    auto twoStep = factory.getRepresentationConverter(typeid(ReprA), typeid(ReprC));
+    ASSERT_NE(nullptr, twoStep);
+    EXPECT_EQ(2, twoStep->steps());
+    EXPECT_EQ(twoStep, factory.getRepresentationConverter(typeid(ReprA), typeid(ReprC)));
+
+    // Once the direct path gets cheaper the existing package is reused
+    for (int i = 0; i < 100; ++i) factory.recordConversion(ac.getConverterID(), 1000, 0ns);
+    EXPECT_EQ(direct, factory.getRepresentationConverter(typeid(ReprA), typeid(ReprC)));
+}
+
+TEST(RepresentationConverterFactoryTests, Statistics) {
+    using namespace std::chrono_literals;
+
+    RepresentationConverterFactory<TestRepr> factory;
+    TestConverter<ReprA, ReprB> ab;
+    TestConverter<ReprB, ReprC> bc;
+    factory.registerObject(&ab);
+    factory.registerObject(&bc);
+
+    factory.recordConversion(ab.getConverterID(), 100, 10ns);
+    factory.recordConversion(ab.getConverterID(), 300, 30ns);
+    factory.recordConversion(bc.getConverterID(), 0, 5ns);
+
+    auto stats = factory.getConversionStatistics();
+    ASSERT_EQ(2, stats.size());
+    EXPECT_EQ(2, stats[ab.getConverterID()].count);
+    EXPECT_EQ(400, stats[ab.getConverterID()].bytes);
+    EXPECT_EQ(40ns, stats[ab.getConverterID()].time);
+    EXPECT_DOUBLE_EQ(0.1, stats[ab.getConverterID()].nanosecondsPerByte());
+    EXPECT_DOUBLE_EQ(5.0, stats[bc.getConverterID()].nanosecondsPerByte());
+
+    std::stringstream ss;
+    util::writeConversionStatisticsCSV(ss, stats);
+    std::string line;
+    std::getline(ss, line);
+    EXPECT_EQ("From,To,Count,Bytes,Time (ms),ns/byte", line);
+    size_t rows = 0;
+    while (std::getline(ss, line)) ++rows;
+    EXPECT_EQ(2, rows);
+
+    factory.resetConversionStatistics();
+    EXPECT_TRUE(factory.getConversionStatistics().empty());
+}
+
+}  // namespace inviwo
@@ -367,4 +367,57 @@ TEST(vertexop, setVertexPos) {
     EXPECT_EQ(colors[0], colorbuf[0]) << "color mismatch";
 }
 
+TEST(meshop, appendMany) {
+    using MyMesh = TypedMesh<buffertraits::PositionsBuffer, buffertraits::ColorsBuffer>;
+
+    std::vector<MyMesh> meshes(3);
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            meshes[i].addVertex(vec3(static_cast<float>(i), static_cast<float>(j), 0.0f),
+                                vec4(1.0f));
+        }
+        auto ib = meshes[i].addIndexBuffer(DrawType::Points, ConnectivityType::None);
+        for (std::uint32_t j = 0; j <= i; ++j) ib->add(j);
+    }
+
+    MyMesh mesh;
+    mesh.addVertex(vec3(-1.0f), vec4(0.0f));
+    mesh.Mesh::append(std::vector<const Mesh *>{&meshes[0], &meshes[1], &meshes[2]});
+
+    const auto &posbuf = mesh.getTypedDataContainer<buffertraits::PositionsBuffer>();
+    const auto &colorbuf = mesh.getTypedDataContainer<buffertraits::ColorsBuffer>();
+    ASSERT_EQ(7, posbuf.size()) << "number of vertices do not match";
+    ASSERT_EQ(7, colorbuf.size()) << "number of colors do not match";
+    EXPECT_EQ(vec3(-1.0f), posbuf[0]);
+    EXPECT_EQ(vec3(0.0f, 0.0f, 0.0f), posbuf[1]);
+    EXPECT_EQ(vec3(1.0f, 1.0f, 0.0f), posbuf[3]);
+    EXPECT_EQ(vec3(2.0f, 2.0f, 0.0f), posbuf[6]);
+    EXPECT_EQ(vec4(1.0f), colorbuf[6]);
+
+    ASSERT_EQ(3, mesh.getNumberOfIndicies());
+    const std::vector<std::vector<std::uint32_t>> expected{{1}, {2, 3}, {4, 5, 6}};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i],
+                  mesh.getIndexBuffers()[i].second->getRAMRepresentation()->getDataContainer());
+    }
+}
+
+TEST(meshop, appendSelf) {
+    using MyMesh = TypedMesh<buffertraits::PositionsBuffer>;
+
+    MyMesh mesh;
+    mesh.addVertex(vec3(0.0f));
+    mesh.addVertex(vec3(1.0f));
+    mesh.addIndexBuffer(DrawType::Lines, ConnectivityType::None)->add({0, 1});
+    mesh.Mesh::append(std::vector<const Mesh *>{&mesh, &mesh});
+
+    const auto &posbuf = mesh.getTypedDataContainer<buffertraits::PositionsBuffer>();
+    ASSERT_EQ(6, posbuf.size()) << "number of vertices do not match";
+    EXPECT_EQ(vec3(0.0f), posbuf[4]);
+    EXPECT_EQ(vec3(1.0f), posbuf[5]);
+    ASSERT_EQ(3, mesh.getNumberOfIndicies());
+    EXPECT_EQ((std::vector<std::uint32_t>{4, 5}),
+              mesh.getIndexBuffers()[2].second->getRAMRepresentation()->getDataContainer());
+}
+
 }  // namespace inviwo
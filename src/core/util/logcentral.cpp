@@ -35,6 +35,11 @@
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/network/processornetwork.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
 namespace inviwo {
 
 bool operator==(const LogLevel& lhs, const LogVerbosity& rhs) {
@@ -83,13 +88,227 @@ void Logger::logAssertion(const char* file, const char* function, int line, std:
     log("Assertion failed", LogLevel::Error, LogAudience::Developer, file, function, line, msg);
 }
 
+struct LogMessage {
+    std::string source;
+    LogLevel level;
+    LogAudience audience;
+    std::string file;
+    std::string function;
+    int line;
+    std::string msg;
+    bool network;
+    std::uint64_t sequence;
+};
+
+/**
+ * Each producing thread gets its own fixed size single producer, single consumer ring buffer.
+ * A consumer thread periodically collects the messages of all buffers, sorts them by sequence
+ * number, and dispatches them to the loggers.
+ */
+class LogCentral::AsyncDispatcher {
+public:
+    AsyncDispatcher(LogCentral& logCentral, size_t capacity)
+        : logCentral_{logCentral}
+        , capacity_{std::max<size_t>(capacity, 1)}
+        , id_{nextId_++}
+        , thread_{[this]() { run(); }} {}
+
+    AsyncDispatcher(const AsyncDispatcher&) = delete;
+    AsyncDispatcher& operator=(const AsyncDispatcher&) = delete;
+
+    ~AsyncDispatcher() {
+        stop();
+        // dispatch anything that was pushed after stopping
+        std::unique_lock<std::mutex> lock{mutex_};
+        auto messages = collect();
+        lock.unlock();
+        dispatch(messages);
+    }
+
+    /**
+     * Dispatches all queued messages and stops the consumer thread.
+     * Must not be called from a logger.
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wake_.notify_one();
+        done_.notify_all();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    bool isConsumerThread() const { return std::this_thread::get_id() == thread_.get_id(); }
+
+    void push(LogMessage&& message) {
+        const auto level = message.level;
+        auto& queue = threadQueue();
+        const size_t tail = queue.tail.load(std::memory_order_relaxed);
+        size_t head = queue.head.load(std::memory_order_acquire);
+        while (tail - head >= capacity_) {
+            if (level != LogLevel::Error) {
+                queue.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            wake_.notify_one();
+            std::this_thread::yield();
+            head = queue.head.load(std::memory_order_acquire);
+        }
+        message.sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+        queue.slots[tail % capacity_] = std::move(message);
+        queue.tail.store(tail + 1, std::memory_order_release);
+        // the consumer polls regularly, only wake it for errors or if it might be idle
+        if (tail == head || level == LogLevel::Error) {
+            wake_.notify_one();
+        }
+    }
+
+    void flush() {
+        if (isConsumerThread()) return;
+        std::unique_lock<std::mutex> lock{mutex_};
+        // a pass that starts after this point will see all messages pushed before the call
+        const auto started = passesStarted_;
+        wake_.notify_one();
+        done_.wait(lock, [&]() { return passesDone_ > started || stop_; });
+    }
+
+private:
+    struct ThreadQueue {
+        explicit ThreadQueue(size_t capacity) : slots(capacity) {}
+        std::vector<LogMessage> slots;
+        std::atomic<size_t> head{0};  ///< next slot to read, written by the consumer
+        std::atomic<size_t> tail{0};  ///< next slot to write, written by the producer
+        std::atomic<size_t> dropped{0};
+    };
+
+    ThreadQueue& threadQueue() {
+        thread_local std::pair<std::uint64_t, std::shared_ptr<ThreadQueue>> local{0, nullptr};
+        if (local.first != id_ || !local.second) {
+            auto queue = std::make_shared<ThreadQueue>(capacity_);
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                queues_.push_back(queue);
+            }
+            local = {id_, std::move(queue)};
+        }
+        return *local.second;
+    }
+
+    /// Needs to be called with mutex_ locked
+    std::vector<LogMessage> collect() {
+        std::vector<LogMessage> messages;
+        size_t dropped = 0;
+        for (auto& queue : queues_) {
+            const size_t head = queue->head.load(std::memory_order_relaxed);
+            const size_t tail = queue->tail.load(std::memory_order_acquire);
+            for (size_t i = head; i != tail; ++i) {
+                messages.push_back(std::move(queue->slots[i % capacity_]));
+            }
+            queue->head.store(tail, std::memory_order_release);
+            dropped += queue->dropped.exchange(0, std::memory_order_relaxed);
+        }
+        // remove the queues of threads that have exited
+        util::erase_remove_if(queues_, [](const std::shared_ptr<ThreadQueue>& queue) {
+            return queue.use_count() == 1 && queue->head.load() == queue->tail.load();
+        });
+
+        std::sort(messages.begin(), messages.end(),
+                  [](const LogMessage& a, const LogMessage& b) { return a.sequence < b.sequence; });
+        if (dropped > 0) {
+            messages.push_back({"LogCentral", LogLevel::Warn, LogAudience::Developer, __FILE__,
+                                __FUNCTION__, __LINE__,
+                                std::to_string(dropped) + " log messages dropped, queue full",
+                                false, 0});
+        }
+        return messages;
+    }
+
+    void dispatch(const std::vector<LogMessage>& messages) {
+        for (const auto& m : messages) {
+            logCentral_.forEachLogger([&](Logger& logger) {
+                if (m.network) {
+                    logger.logNetwork(m.level, m.audience, m.msg, m.file.c_str(),
+                                      m.function.c_str(), m.line);
+                } else {
+                    logger.log(m.source, m.level, m.audience, m.file.c_str(), m.function.c_str(),
+                               m.line, m.msg);
+                }
+            });
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            if (!stop_) wake_.wait_for(lock, std::chrono::milliseconds(5));
+            ++passesStarted_;
+            const bool stop = stop_;
+            auto messages = collect();
+
+            lock.unlock();
+            dispatch(messages);
+            lock.lock();
+
+            ++passesDone_;
+            done_.notify_all();
+            if (stop && messages.empty()) break;
+        }
+    }
+
+    static std::atomic<std::uint64_t> nextId_;
+
+    LogCentral& logCentral_;
+    const size_t capacity_;
+    const std::uint64_t id_;
+    std::atomic<std::uint64_t> sequence_{0};
+
+    std::mutex mutex_;  ///< guards queues_, the pass counters and stop_
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::vector<std::shared_ptr<ThreadQueue>> queues_;
+    std::uint64_t passesStarted_ = 0;
+    std::uint64_t passesDone_ = 0;
+    bool stop_ = false;
+
+    std::thread thread_;
+};
+
+std::atomic<std::uint64_t> LogCentral::AsyncDispatcher::nextId_{1};
+
 LogCentral::LogCentral() : logVerbosity_(LogVerbosity::Info), logStacktrace_(false) {}
 
+LogCentral::~LogCentral() { setAsynchronous(false); }
+
 void LogCentral::setVerbosity(LogVerbosity verbosity) { logVerbosity_ = verbosity; }
 
 LogVerbosity LogCentral::getVerbosity() { return logVerbosity_; }
 
-void LogCentral::registerLogger(std::weak_ptr<Logger> logger) { loggers_.push_back(logger); }
+void LogCentral::registerLogger(std::weak_ptr<Logger> logger) {
+    std::lock_guard<std::mutex> lock{loggersMutex_};
+    loggers_.push_back(logger);
+}
+
+template <typename F>
+void LogCentral::forEachLogger(F&& f) {
+    // Call the loggers without holding the lock, since they might log themselves.
+    std::vector<std::shared_ptr<Logger>> loggers;
+    {
+        std::lock_guard<std::mutex> lock{loggersMutex_};
+        // use remove if here to remove expired weak pointers while collecting the loggers.
+        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
+            if (auto l = logger.lock()) {
+                loggers.push_back(std::move(l));
+                return false;
+            } else {
+                return true;
+            }
+        });
+    }
+    for (auto& logger : loggers) {
+        f(*logger);
+    }
+}
 
 void LogCentral::log(std::string source, LogLevel level, LogAudience audience, const char* file,
                      const char* function, int line, std::string msg) {
@@ -108,16 +327,16 @@ void LogCentral::log(std::string source, LogLevel level, LogAudience audience, c
         msg = ss.str();
     }
 
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->log(source, level, audience, file, function, line, msg);
-                return false;
-            } else {
-                return true;
-            }
-        });
+    if (level >= logVerbosity_.load()) {
+        auto async = std::atomic_load(&async_);
+        if (async && !async->isConsumerThread()) {
+            async->push({std::move(source), level, audience, file ? file : "",
+                         function ? function : "", line, std::move(msg), false, 0});
+        } else {
+            forEachLogger([&](Logger& l) {
+                l.log(source, level, audience, file, function, line, msg);
+            });
+        }
     }
 
     switch (breakLevel_) {
@@ -139,43 +358,60 @@ void LogCentral::log(std::string source, LogLevel level, LogAudience audience, c
 
 void LogCentral::logProcessor(Processor* processor, LogLevel level, LogAudience audience,
                               std::string msg, const char* file, const char* function, int line) {
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->logProcessor(processor, level, audience, msg, file, function, line);
-                return false;
-            } else {
-                return true;
-            }
+    if (level >= logVerbosity_.load()) {
+        // The processor might not outlive a queued message, dispatch directly after the queue
+        flush();
+        forEachLogger([&](Logger& l) {
+            l.logProcessor(processor, level, audience, msg, file, function, line);
         });
     }
 }
 
 void LogCentral::logNetwork(LogLevel level, LogAudience audience, std::string msg, const char* file,
                             const char* function, int line) {
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->logNetwork(level, audience, msg, file, function, line);
-                return false;
-            } else {
-                return true;
-            }
-        });
+    if (level >= logVerbosity_.load()) {
+        auto async = std::atomic_load(&async_);
+        if (async && !async->isConsumerThread()) {
+            async->push({"ProcessorNetwork", level, audience, file ? file : "",
+                         function ? function : "", line, std::move(msg), true, 0});
+        } else {
+            forEachLogger([&](Logger& l) {
+                l.logNetwork(level, audience, msg, file, function, line);
+            });
+        }
     }
 }
 
 void LogCentral::logAssertion(const char* file, const char* function, int line, std::string msg) {
-    util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-        if (auto l = logger.lock()) {
-            l->logAssertion(file, function, line, msg);
-            return false;
+    flush();
+    forEachLogger([&](Logger& l) { l.logAssertion(file, function, line, msg); });
+}
+
+void LogCentral::setAsynchronous(bool async) {
+    std::shared_ptr<AsyncDispatcher> old;
+    {
+        std::lock_guard<std::mutex> lock{asyncMutex_};
+        if (async == static_cast<bool>(async_)) return;
+        if (async) {
+            std::atomic_store(&async_, std::make_shared<AsyncDispatcher>(*this, queueCapacity_));
         } else {
-            return true;
+            old = std::atomic_exchange(&async_, std::shared_ptr<AsyncDispatcher>{});
         }
-    });
+    }
+    if (old) old->stop();
+}
+
+bool LogCentral::isAsynchronous() const { return static_cast<bool>(std::atomic_load(&async_)); }
+
+void LogCentral::setQueueCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock{asyncMutex_};
+    queueCapacity_ = capacity;
+}
+
+void LogCentral::flush() {
+    if (auto async = std::atomic_load(&async_)) {
+        async->flush();
+    }
 }
 
 void LogCentral::setLogStacktrace(const bool& logStacktrace) { logStacktrace_ = logStacktrace; }
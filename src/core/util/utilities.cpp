@@ -34,6 +34,7 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/processors/canvasprocessor.h>
 #include <inviwo/core/processors/processorwidget.h>
+#include <inviwo/core/io/imagewriterutil.h>
 
 #include <inviwo/core/properties/property.h>
 
@@ -52,8 +53,12 @@ void saveNetwork(ProcessorNetwork* network, std::string filename) {
     }
 }
 
-void saveAllCanvases(ProcessorNetwork* network, const std::string& dir, const std::string& name,
-                     const std::string& ext, bool onlyActiveCanvases) {
+namespace {
+
+template <typename Save>
+void saveAllCanvasesImpl(ProcessorNetwork* network, const std::string& dir,
+                         const std::string& name, const std::string& ext, bool onlyActiveCanvases,
+                         Save save) {
 
     // Get all canvases, possibly only the active ones. We need their count below.
     std::vector<CanvasProcessor*> allCanvases =
@@ -93,12 +98,35 @@ void saveAllCanvases(ProcessorNetwork* network, const std::string& dir, const st
             ss << ((ext.size() && ext[0] != '.') ? "." : "") << ext;
 
             LogInfoCustom("util::saveAllCanvases", "Saving canvas to: " + ss.str());
-            cp->saveImageLayer(ss.str());
+            save(cp, ss.str());
         }
         i++;
     }
 }
 
+}  // namespace
+
+void saveAllCanvases(ProcessorNetwork* network, const std::string& dir, const std::string& name,
+                     const std::string& ext, bool onlyActiveCanvases) {
+    saveAllCanvasesImpl(network, dir, name, ext, onlyActiveCanvases,
+                        [](CanvasProcessor* cp, const std::string& path) {
+                            cp->saveImageLayer(path);
+                        });
+}
+
+void saveAllCanvases(ProcessorNetwork* network, const std::string& dir, const std::string& name,
+                     const std::string& ext, bool onlyActiveCanvases, LayerExportQueue& queue) {
+    saveAllCanvasesImpl(network, dir, name, ext, onlyActiveCanvases,
+                        [&](CanvasProcessor* cp, const std::string& path) {
+                            if (auto layer = cp->getVisibleLayer()) {
+                                queue.enqueue(*layer, path);
+                            } else {
+                                LogErrorCustom("util::saveAllCanvases",
+                                               "Could not find visible layer for: " + path);
+                            }
+                        });
+}
+
 bool isValidIdentifierCharacter(char c, const std::string& extra) {
     return (std::isalnum(c) || c == '_' || c == '-' || util::contains(extra, c));
 }